@@ -0,0 +1,134 @@
+#include "benchmark.h"
+
+LS_ARRAY_DEFINE(BenchmarkArray, benchmark_array, Benchmark)
+
+static BenchmarkArray benchmarks = { 0 };
+
+// Scenarios run on the main thread only, the counters are not synchronized.
+static struct {
+	const LSAllocator *backing;
+	uint64 allocations;
+	uint64 bytes;
+} counter;
+
+static void *counting_malloc(size_t size, void *user_data) {
+	counter.allocations++;
+	counter.bytes += size;
+	return counter.backing->malloc(size, counter.backing->user_data);
+}
+
+static void *counting_calloc(size_t count, size_t size, void *user_data) {
+	counter.allocations++;
+	counter.bytes += count * size;
+	return counter.backing->calloc(count, size, counter.backing->user_data);
+}
+
+static void *counting_realloc(void *ptr, size_t size, void *user_data) {
+	counter.allocations++;
+	counter.bytes += size;
+	return counter.backing->realloc(ptr, size, counter.backing->user_data);
+}
+
+static void counting_free(void *ptr, void *user_data) {
+	counter.backing->free(ptr, counter.backing->user_data);
+}
+
+static LSAllocator counting_allocator = {
+	.name = "counting",
+	.malloc = counting_malloc,
+	.calloc = counting_calloc,
+	.realloc = counting_realloc,
+	.free = counting_free,
+	.user_data = NULL,
+};
+
+void benchmark_install_allocator(const LSAllocator *backing) {
+	counter.backing = backing;
+	if (!ls_set_allocator(&counting_allocator)) {
+		ls_log_fatal("The benchmark allocator must be installed before the first allocation\n");
+	}
+}
+
+void benchmark_register(Benchmark benchmark) {
+	benchmark_array_append(&benchmarks, benchmark);
+}
+
+void benchmark_deinit() {
+	benchmark_array_destroy(&benchmarks);
+}
+
+static void sort_samples(float64 *samples, int32 count) {
+	for (int32 i = 1; i < count; i++) {
+		float64 sample = samples[i];
+		int32 j = i;
+		for (; j > 0 && samples[j - 1] > sample; j--) {
+			samples[j] = samples[j - 1];
+		}
+		samples[j] = sample;
+	}
+}
+
+static void benchmark_run(const BenchmarkContext *context, const Benchmark *benchmark, int32 iterations, float64 *samples) {
+	void *user_data = benchmark->setup ? benchmark->setup(context) : NULL;
+
+	// One untimed run to warm the caches and grow every buffer to its steady state size
+	benchmark->run(user_data);
+
+	uint64 allocations = counter.allocations;
+	uint64 bytes = counter.bytes;
+	uint64 total_ops = 0;
+
+	for (int32 i = 0; i < iterations; i++) {
+		uint64 start = os_get_time();
+		uint64 ops = benchmark->run(user_data);
+		uint64 end = os_get_time();
+
+		ops = ops ? ops : 1;
+		total_ops += ops;
+		samples[i] = (float64)(end - start) * 1000.0 / (float64)ops;
+	}
+
+	allocations = counter.allocations - allocations;
+	bytes = counter.bytes - bytes;
+
+	if (benchmark->teardown) {
+		benchmark->teardown(user_data);
+	}
+
+	sort_samples(samples, iterations);
+
+	ls_printf("%-28s %-12s %10llu %14.2f %14.2f %11.3f %11.1f\n",
+			benchmark->name,
+			benchmark->unit,
+			(unsigned long long)(total_ops / iterations),
+			samples[iterations / 2],
+			samples[0],
+			(float64)allocations / (float64)total_ops,
+			(float64)bytes / (float64)total_ops);
+}
+
+int32 benchmark_run_all(const BenchmarkContext *context, String filter, int32 iterations) {
+	if (iterations < 1) {
+		iterations = 1;
+	}
+
+	float64 *samples = ls_malloc(iterations * sizeof(float64));
+
+	ls_printf("%-28s %-12s %10s %14s %14s %11s %11s\n",
+			"benchmark", "op", "ops/iter", "median ns/op", "min ns/op", "allocs/op", "bytes/op");
+
+	int32 ran = 0;
+	for (size_t i = 0; i < benchmarks.size; i++) {
+		const Benchmark *benchmark = &benchmarks.data[i];
+		if (!ls_str_is_empty(filter) && !ls_str_contains(benchmark->name, filter)) {
+			continue;
+		}
+
+		benchmark_run(context, benchmark, iterations, samples);
+		ran++;
+	}
+
+	ls_free(samples);
+
+	return ran;
+}
\ No newline at end of file
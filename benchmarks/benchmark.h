@@ -0,0 +1,67 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "core/core.h"
+#include "renderer/renderer.h"
+
+// Shared state and the scenario sizes, filled from the command line.
+typedef struct {
+	LSCore *core;
+	Renderer *renderer;
+
+	// Directory holding the sample assets
+	String resources;
+
+	int32 items;
+	int32 sprites;
+	int32 voices;
+	int32 ui_depth;
+} BenchmarkContext;
+
+// Prepares a scenario and returns the user data handed to run and teardown. Not timed.
+typedef void *(*BenchmarkSetup)(const BenchmarkContext *context);
+// Runs one timed iteration and returns how many operations it did, times are reported per operation.
+typedef uint64 (*BenchmarkRun)(void *user_data);
+typedef void (*BenchmarkTeardown)(void *user_data);
+
+typedef struct {
+	String name;
+	// What one operation is, printed with the results
+	String unit;
+
+	BenchmarkSetup setup;
+	BenchmarkRun run;
+	BenchmarkTeardown teardown;
+} Benchmark;
+
+void benchmark_register(Benchmark benchmark);
+
+// xorshift32, scenarios seed it with a constant so every run sees the same data.
+_FORCE_INLINE_ uint32 benchmark_random(uint32 *state) {
+	uint32 x = *state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+	return x;
+}
+
+// Returns a float in [min, max).
+_FORCE_INLINE_ float32 benchmark_random_range(uint32 *state, float32 min, float32 max) {
+	return min + (float32)(benchmark_random(state) >> 8) * (1.0f / 16777216.0f) * (max - min);
+}
+
+// Wraps the backing allocator so every scenario can report its allocations.
+// Must be called before anything is allocated.
+void benchmark_install_allocator(const LSAllocator *backing);
+
+// Runs every registered benchmark whose name contains filter, an empty filter runs all of them.
+// Returns the number of benchmarks that ran.
+int32 benchmark_run_all(const BenchmarkContext *context, String filter, int32 iterations);
+void benchmark_deinit();
+
+void register_core_benchmarks();
+void register_renderer_benchmarks();
+void register_module_benchmarks();
+
+#endif // BENCHMARK_H
\ No newline at end of file
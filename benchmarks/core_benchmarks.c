@@ -0,0 +1,164 @@
+#include "benchmark.h"
+
+#define BENCHMARK_SEED 0x9E3779B9u
+
+// Results are written here so the measured loops are not optimized away
+static volatile uint64 sink = 0;
+
+typedef struct {
+	int32 count;
+	uint32 *keys;
+	char **strings;
+	Hashtable *table;
+} HashtableBenchmark;
+
+static HashtableBenchmark *hashtable_benchmark_create(const BenchmarkContext *context) {
+	HashtableBenchmark *benchmark = ls_calloc(1, sizeof(HashtableBenchmark));
+	benchmark->count = context->items;
+	benchmark->keys = ls_malloc(benchmark->count * sizeof(uint32));
+
+	uint32 state = BENCHMARK_SEED;
+	for (int32 i = 0; i < benchmark->count; i++) {
+		benchmark->keys[i] = benchmark_random(&state);
+	}
+
+	return benchmark;
+}
+
+static void hashtable_benchmark_teardown(void *user_data) {
+	HashtableBenchmark *benchmark = user_data;
+	if (benchmark->table) {
+		hashtable_destroy(benchmark->table);
+	}
+
+	if (benchmark->strings) {
+		for (int32 i = 0; i < benchmark->count; i++) {
+			ls_free(benchmark->strings[i]);
+		}
+		ls_free(benchmark->strings);
+	}
+
+	ls_free(benchmark->keys);
+	ls_free(benchmark);
+}
+
+static void *hashtable_insert_setup(const BenchmarkContext *context) {
+	return hashtable_benchmark_create(context);
+}
+
+// Builds the table from empty, growth included
+static uint64 hashtable_insert_run(void *user_data) {
+	HashtableBenchmark *benchmark = user_data;
+
+	Hashtable *table = hashtable_create(HASHTABLE_KEY_UINT32, 0, false);
+	for (int32 i = 0; i < benchmark->count; i++) {
+		hashtable_set(table, HASH_KEY(u32, benchmark->keys[i]), HASH_VAL(u64, i));
+	}
+	sink = hashtable_get_size(table);
+	hashtable_destroy(table);
+
+	return benchmark->count;
+}
+
+static void *hashtable_lookup_setup(const BenchmarkContext *context) {
+	HashtableBenchmark *benchmark = hashtable_benchmark_create(context);
+
+	// Every other key is inserted, so half the lookups miss
+	benchmark->table = hashtable_create(HASHTABLE_KEY_UINT32, benchmark->count / 2, false);
+	for (int32 i = 0; i < benchmark->count; i += 2) {
+		hashtable_set(benchmark->table, HASH_KEY(u32, benchmark->keys[i]), HASH_VAL(u64, i));
+	}
+
+	return benchmark;
+}
+
+static uint64 hashtable_lookup_run(void *user_data) {
+	HashtableBenchmark *benchmark = user_data;
+
+	uint64 sum = 0;
+	for (int32 i = 0; i < benchmark->count; i++) {
+		sum += hashtable_get(benchmark->table, HASH_KEY(u32, benchmark->keys[i])).u64;
+	}
+	sink = sum;
+
+	return benchmark->count;
+}
+
+static void *hashtable_lookup_string_setup(const BenchmarkContext *context) {
+	HashtableBenchmark *benchmark = hashtable_benchmark_create(context);
+
+	benchmark->strings = ls_malloc(benchmark->count * sizeof(char *));
+	for (int32 i = 0; i < benchmark->count; i++) {
+		benchmark->strings[i] = ls_str_format("entity_%08x", benchmark->keys[i]);
+	}
+
+	benchmark->table = hashtable_create(HASHTABLE_KEY_STRING, benchmark->count / 2, false);
+	for (int32 i = 0; i < benchmark->count; i += 2) {
+		hashtable_set(benchmark->table, HASH_KEY(str, benchmark->strings[i]), HASH_VAL(u64, i));
+	}
+
+	return benchmark;
+}
+
+static uint64 hashtable_lookup_string_run(void *user_data) {
+	HashtableBenchmark *benchmark = user_data;
+
+	uint64 sum = 0;
+	for (int32 i = 0; i < benchmark->count; i++) {
+		sum += hashtable_get(benchmark->table, HASH_KEY(str, benchmark->strings[i])).u64;
+	}
+	sink = sum;
+
+	return benchmark->count;
+}
+
+static void *slice_append_setup(const BenchmarkContext *context) {
+	int32 *count = ls_malloc(sizeof(int32));
+	*count = context->items;
+
+	return count;
+}
+
+static uint64 slice_append_run(void *user_data) {
+	int32 count = *(int32 *)user_data;
+
+	Slice *slice = slice_create(1, false);
+	for (int32 i = 0; i < count; i++) {
+		slice_append(slice, SLICE_VAL(u64, i));
+	}
+	sink = slice_get_size(slice);
+	slice_destroy(slice);
+
+	return count;
+}
+
+static uint64 slice32_append_run(void *user_data) {
+	int32 count = *(int32 *)user_data;
+
+	Slice32 *slice = slice32_create(1);
+	for (int32 i = 0; i < count; i++) {
+		slice32_append(slice, SLICE_VAL32(u32, i));
+	}
+	sink = slice32_get_size(slice);
+	slice32_destroy(slice);
+
+	return count;
+}
+
+static void slice_append_teardown(void *user_data) {
+	ls_free(user_data);
+}
+
+static const Benchmark core_benchmarks[] = {
+	{ .name = "hashtable_insert_u32", .unit = "insert", .setup = hashtable_insert_setup, .run = hashtable_insert_run, .teardown = hashtable_benchmark_teardown },
+	{ .name = "hashtable_lookup_u32", .unit = "lookup", .setup = hashtable_lookup_setup, .run = hashtable_lookup_run, .teardown = hashtable_benchmark_teardown },
+	{ .name = "hashtable_lookup_string", .unit = "lookup", .setup = hashtable_lookup_string_setup, .run = hashtable_lookup_string_run, .teardown = hashtable_benchmark_teardown },
+	{ .name = "slice_append", .unit = "append", .setup = slice_append_setup, .run = slice_append_run, .teardown = slice_append_teardown },
+	{ .name = "slice32_append", .unit = "append", .setup = slice_append_setup, .run = slice32_append_run, .teardown = slice_append_teardown },
+};
+
+void register_core_benchmarks() {
+	for (size_t i = 0; i < sizeof(core_benchmarks) / sizeof(core_benchmarks[0]); i++) {
+		benchmark_register(core_benchmarks[i]);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "benchmark.h"
+
+#include "renderer/batch_renderer.h"
+
+// Scans for --allocator before the flag manager allocates anything, see ls_main_init.
+static const LSAllocator *find_backing_allocator(int32 argc, char *argv[]) {
+	const LSAllocator *allocator = ls_get_system_allocator();
+	for (int32 i = 1; i + 1 < argc; i++) {
+		if (ls_str_equals(argv[i], "--allocator") && ls_find_allocator(argv[i + 1])) {
+			allocator = ls_find_allocator(argv[i + 1]);
+		}
+	}
+
+	return allocator;
+}
+
+int32 main(int32 argc, char *argv[]) {
+	benchmark_install_allocator(find_backing_allocator(argc, argv));
+
+	FlagManager *flag_manager = flag_manager_create();
+	FlagValue *filter = flag_manager_register(flag_manager, "filter", FLAG_TYPE_STRING, FLAG_VAL(str, ""), "Only run benchmarks whose name contains this.");
+	FlagValue *iterations = flag_manager_register(flag_manager, "iterations", FLAG_TYPE_INT, FLAG_VAL(i32, 10), "Timed runs per benchmark, the median and the fastest are reported.");
+	FlagValue *resources = flag_manager_register(flag_manager, "resources", FLAG_TYPE_STRING, FLAG_VAL(str, "misc/resources"), "Directory with the sample assets.");
+	FlagValue *items = flag_manager_register(flag_manager, "items", FLAG_TYPE_INT, FLAG_VAL(i32, 100000), "Elements in the hashtable and slice benchmarks.");
+	FlagValue *sprites = flag_manager_register(flag_manager, "sprites", FLAG_TYPE_INT, FLAG_VAL(i32, 10000), "Sprites drawn per frame by the sprite benchmarks.");
+	FlagValue *voices = flag_manager_register(flag_manager, "voices", FLAG_TYPE_INT, FLAG_VAL(i32, 32), "Voices playing in the audio mix benchmark and max voices in the sound play one.");
+	FlagValue *ui_depth = flag_manager_register(flag_manager, "ui-depth", FLAG_TYPE_INT, FLAG_VAL(i32, 10), "Nesting depth of the UI layout tree, every container has two children.");
+	FlagValue *allocator = flag_manager_register(flag_manager, "allocator", FLAG_TYPE_STRING, FLAG_VAL(str, "system"), "Backing allocator, system or bump.");
+
+	BenchmarkContext context = { 0 };
+	context.core = core_create_headless(flag_manager);
+	context.renderer = renderer_create(context.core);
+
+	flag_manager_parse(flag_manager, argc, argv, false);
+
+	if (!ls_find_allocator(allocator->str)) {
+		ls_log(LOG_LEVEL_WARNING, "Unknown allocator %s, using system.\n", allocator->str);
+	}
+
+	core_start(context.core);
+	renderer_start(context.renderer);
+	batch_renderer_init(context.renderer);
+
+	context.resources = resources->str;
+	context.items = items->i32 > 0 ? items->i32 : 1;
+	context.sprites = sprites->i32 > 0 ? sprites->i32 : 1;
+	context.voices = voices->i32 > 0 ? voices->i32 : 1;
+	context.ui_depth = ui_depth->i32 > 0 ? ui_depth->i32 : 0;
+
+	register_core_benchmarks();
+	register_renderer_benchmarks();
+	register_module_benchmarks();
+
+	int32 ran = benchmark_run_all(&context, filter->str, iterations->i32);
+	if (ran == 0) {
+		ls_log(LOG_LEVEL_WARNING, "No benchmark matches %s\n", filter->str);
+	}
+
+	benchmark_deinit();
+	batch_renderer_deinit();
+	renderer_destroy(context.renderer);
+	core_destroy(context.core);
+
+	return ran > 0 ? 0 : 1;
+}
\ No newline at end of file
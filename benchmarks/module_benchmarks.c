@@ -0,0 +1,254 @@
+#include "benchmark.h"
+
+#include "modules/modules_enabled.gen.h"
+
+#if defined(MODULE_PNG_ENABLED)
+#include "modules/png/png_parser.h"
+#endif // MODULE_PNG_ENABLED
+
+#if defined(MODULE_AUDIO_ENABLED)
+#include "modules/audio/audio_server.h"
+#include "modules/audio/audio_stream.h"
+#include "modules/audio/internal/audio_buffer.h"
+#include "modules/audio/internal/audio_server.h"
+#endif // MODULE_AUDIO_ENABLED
+
+#if defined(MODULE_UI_ENABLED)
+#include "modules/ui/elements.h"
+#endif // MODULE_UI_ENABLED
+
+static volatile uint64 sink = 0;
+
+#if defined(MODULE_PNG_ENABLED)
+static void *png_decode_setup(const BenchmarkContext *context) {
+	char *path = os_path_add(context->resources, "moon.png");
+	if (!os_path_is_file(path)) {
+		ls_log_fatal("Missing benchmark image %s, point --resources at misc/resources\n", path);
+	}
+
+	return path;
+}
+
+// Reads and decodes the file like a texture load does
+static uint64 png_decode_run(void *user_data) {
+	uint32 width = 0;
+	uint32 height = 0;
+	uint8 *data = NULL;
+	parse_png_texture(user_data, &width, &height, &data);
+
+	sink = width * height;
+	ls_free(data);
+
+	return 1;
+}
+
+static void png_decode_teardown(void *user_data) {
+	ls_free(user_data);
+}
+#endif // MODULE_PNG_ENABLED
+
+#if defined(MODULE_AUDIO_ENABLED)
+// About a second of source audio per voice, looped
+#define AUDIO_VOICE_FRAMES 44100
+#define AUDIO_MIX_PERIOD 512
+#define AUDIO_MIX_PERIODS 16
+
+typedef struct {
+	int32 count;
+	AudioBuffer **voices;
+	float32 output[AUDIO_MIX_PERIOD * AUDIO_DEVICE_CHANNELS];
+} AudioBenchmark;
+
+static AudioBenchmark *audio_mix_create(const BenchmarkContext *context, uint32 sample_rate) {
+	AudioBenchmark *benchmark = ls_calloc(1, sizeof(AudioBenchmark));
+	benchmark->count = context->voices;
+	benchmark->voices = ls_malloc(benchmark->count * sizeof(AudioBuffer *));
+
+	for (int32 i = 0; i < benchmark->count; i++) {
+		AudioBuffer *voice = audio_buffer_create(ma_format_f32, 2, sample_rate, AUDIO_VOICE_FRAMES, AUDIO_BUFFER_USAGE_STATIC);
+
+		float32 *samples = (float32 *)voice->data;
+		float32 step = 2.0f * PI * (220.0f + 20.0f * i) / (float32)sample_rate;
+		for (uint32 frame = 0; frame < AUDIO_VOICE_FRAMES; frame++) {
+			float32 sample = math_sinf(step * frame) * 0.1f;
+			samples[frame * 2] = sample;
+			samples[frame * 2 + 1] = sample;
+		}
+
+		audio_buffer_set_looping(voice, true);
+		audio_buffer_set_pan(voice, (float32)i / (float32)benchmark->count);
+		audio_buffer_play(voice);
+
+		benchmark->voices[i] = voice;
+	}
+
+	return benchmark;
+}
+
+// 44.1kHz sources, so the mix includes resampling to the device rate
+static void *audio_mix_setup(const BenchmarkContext *context) {
+	audio_server_init_offline();
+
+	return audio_mix_create(context, 44100);
+}
+
+// Sources already at the device rate like loaded sounds, mixed without the converter
+static void *audio_mix_device_rate_setup(const BenchmarkContext *context) {
+	audio_server_init_offline();
+
+	return audio_mix_create(context, audio_server_get_device().sampleRate);
+}
+
+static uint64 audio_mix_run(void *user_data) {
+	AudioBenchmark *benchmark = user_data;
+
+	for (int32 i = 0; i < AUDIO_MIX_PERIODS; i++) {
+		audio_server_mix(benchmark->output, AUDIO_MIX_PERIOD);
+	}
+	sink = (uint64)(benchmark->output[0] * 1000.0f);
+
+	// Time per voice per output frame
+	return (uint64)AUDIO_MIX_PERIOD * AUDIO_MIX_PERIODS * benchmark->count;
+}
+
+static void audio_mix_teardown(void *user_data) {
+	AudioBenchmark *benchmark = user_data;
+	for (int32 i = 0; i < benchmark->count; i++) {
+		audio_buffer_destroy(benchmark->voices[i]);
+	}
+	ls_free(benchmark->voices);
+	ls_free(benchmark);
+
+	audio_server_deinit();
+}
+
+// Sounds started between two mixes, far more than --voices so most plays steal
+#define AUDIO_PLAYS_PER_PERIOD 64
+
+typedef struct {
+	Sound *sounds[4];
+	float32 output[AUDIO_MIX_PERIOD * AUDIO_DEVICE_CHANNELS];
+} SoundBenchmark;
+
+static void *audio_sound_play_setup(const BenchmarkContext *context) {
+	char *path = os_path_add(context->resources, "chirp_test.wav");
+	if (!os_path_is_file(path)) {
+		ls_log_fatal("Missing benchmark sound %s, point --resources at misc/resources\n", path);
+	}
+
+	audio_server_init_offline();
+	audio_server_set_max_voices(context->voices);
+
+	SoundBenchmark *benchmark = ls_calloc(1, sizeof(SoundBenchmark));
+	benchmark->sounds[0] = sound_create(path);
+	ls_free(path);
+
+	// Aliases with their own priorities and limits, like the shots and hits of a busy scene
+	for (int32 i = 1; i < 4; i++) {
+		benchmark->sounds[i] = sound_alias(benchmark->sounds[0]);
+		sound_set_priority(benchmark->sounds[i], i % 2);
+		sound_set_max_instances(benchmark->sounds[i], i * 4);
+	}
+
+	return benchmark;
+}
+
+static uint64 audio_sound_play_run(void *user_data) {
+	SoundBenchmark *benchmark = user_data;
+
+	for (int32 i = 0; i < AUDIO_MIX_PERIODS; i++) {
+		for (int32 j = 0; j < AUDIO_PLAYS_PER_PERIOD; j++) {
+			sound_play(benchmark->sounds[j % 4]);
+		}
+
+		audio_server_mix(benchmark->output, AUDIO_MIX_PERIOD);
+	}
+	sink = audio_server_get_active_voice_count();
+
+	return (uint64)AUDIO_PLAYS_PER_PERIOD * AUDIO_MIX_PERIODS;
+}
+
+static void audio_sound_play_teardown(void *user_data) {
+	SoundBenchmark *benchmark = user_data;
+	for (int32 i = 3; i >= 0; i--) {
+		sound_destroy(benchmark->sounds[i]);
+	}
+	ls_free(benchmark);
+
+	audio_server_deinit();
+}
+#endif // MODULE_AUDIO_ENABLED
+
+#if defined(MODULE_UI_ENABLED)
+typedef struct {
+	UIElement *root;
+	uint64 elements;
+} UIBenchmark;
+
+// Nests containers depth levels deep, alternating direction, with two children each.
+// The leaves are empty containers with a minimum size.
+static UIElement *ui_benchmark_build(int32 depth, bool vertical, uint64 *elements) {
+	(*elements)++;
+
+	UIElement *element = vertical ? ui_vertical_container_create(4, UI_ALIGNMENT_BEGIN) : ui_horizontal_container_create(4, UI_ALIGNMENT_CENTER);
+	if (depth == 0) {
+		ui_element_set_min_size(element, vec2u(32, 16));
+		return element;
+	}
+
+	for (int32 i = 0; i < 2; i++) {
+		UIElement *child = ui_benchmark_build(depth - 1, !vertical, elements);
+		if (vertical) {
+			ui_vertical_container_add_child(element, child);
+		} else {
+			ui_horizontal_container_add_child(element, child);
+		}
+	}
+
+	return element;
+}
+
+static void *ui_layout_setup(const BenchmarkContext *context) {
+	UIBenchmark *benchmark = ls_calloc(1, sizeof(UIBenchmark));
+	benchmark->root = ui_benchmark_build(context->ui_depth, true, &benchmark->elements);
+
+	return benchmark;
+}
+
+static uint64 ui_layout_run(void *user_data) {
+	UIBenchmark *benchmark = user_data;
+
+	ui_element_calculate_position(benchmark->root, vec2u(1920, 1080), vec2u(0, 0));
+	sink = ui_element_get_size(benchmark->root).x;
+
+	return benchmark->elements;
+}
+
+static void ui_layout_teardown(void *user_data) {
+	UIBenchmark *benchmark = user_data;
+	ui_element_destroy(benchmark->root);
+	ls_free(benchmark);
+}
+#endif // MODULE_UI_ENABLED
+
+static const Benchmark module_benchmarks[] = {
+#if defined(MODULE_PNG_ENABLED)
+	{ .name = "png_decode", .unit = "image", .setup = png_decode_setup, .run = png_decode_run, .teardown = png_decode_teardown },
+#endif // MODULE_PNG_ENABLED
+#if defined(MODULE_AUDIO_ENABLED)
+	{ .name = "audio_mix", .unit = "voice frame", .setup = audio_mix_setup, .run = audio_mix_run, .teardown = audio_mix_teardown },
+	{ .name = "audio_mix_device_rate", .unit = "voice frame", .setup = audio_mix_device_rate_setup, .run = audio_mix_run, .teardown = audio_mix_teardown },
+	{ .name = "audio_sound_play", .unit = "play", .setup = audio_sound_play_setup, .run = audio_sound_play_run, .teardown = audio_sound_play_teardown },
+#endif // MODULE_AUDIO_ENABLED
+#if defined(MODULE_UI_ENABLED)
+	{ .name = "ui_layout", .unit = "element", .setup = ui_layout_setup, .run = ui_layout_run, .teardown = ui_layout_teardown },
+#endif // MODULE_UI_ENABLED
+	{ 0 },
+};
+
+void register_module_benchmarks() {
+	// The table ends with an empty entry so it is never empty when every module is disabled
+	for (size_t i = 0; module_benchmarks[i].name; i++) {
+		benchmark_register(module_benchmarks[i]);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "benchmark.h"
+
+#include "renderer/batch_renderer.h"
+#include "renderer/shader.h"
+#include "renderer/sprite.h"
+#include "renderer/sprite_batch.h"
+#include "renderer/texture.h"
+
+// Generated from renderer/shaders/batch.shader
+extern const char *const BATCH_SHADER_SOURCE;
+
+#define BENCHMARK_SEED 0x2545F491u
+#define SPRITE_TEXTURES 4
+// A single parse is too short for the microsecond clock
+#define SHADER_PARSES 64
+
+static volatile uint64 sink = 0;
+
+typedef struct {
+	int32 count;
+	uint32 frame;
+
+	// Sprites are sorted by texture like a typical scene, every texture is one run
+	Texture *textures[SPRITE_TEXTURES];
+
+	SpriteBatch *batch;
+	Sprite **sprites;
+} SpriteBenchmark;
+
+static SpriteBenchmark *sprite_benchmark_create(const BenchmarkContext *context) {
+	SpriteBenchmark *benchmark = ls_calloc(1, sizeof(SpriteBenchmark));
+	benchmark->count = context->sprites;
+
+	// The NONE backend only records the size, no pixels are needed
+	for (int32 i = 0; i < SPRITE_TEXTURES; i++) {
+		benchmark->textures[i] = texture_create(64, 64, TEXTURE_FORMAT_RGBA, NULL);
+	}
+
+	return benchmark;
+}
+
+static Texture *sprite_benchmark_texture(const SpriteBenchmark *benchmark, int32 index) {
+	return benchmark->textures[(int64)index * SPRITE_TEXTURES / benchmark->count];
+}
+
+static void sprite_benchmark_teardown(void *user_data) {
+	SpriteBenchmark *benchmark = user_data;
+	if (benchmark->batch) {
+		sprite_batch_destroy(benchmark->batch);
+	}
+
+	if (benchmark->sprites) {
+		for (int32 i = 0; i < benchmark->count; i++) {
+			sprite_destroy(benchmark->sprites[i]);
+		}
+		ls_free(benchmark->sprites);
+	}
+
+	for (int32 i = 0; i < SPRITE_TEXTURES; i++) {
+		texture_destroy(benchmark->textures[i]);
+	}
+
+	ls_free(benchmark);
+}
+
+static void *sprite_batch_setup(const BenchmarkContext *context) {
+	SpriteBenchmark *benchmark = sprite_benchmark_create(context);
+	benchmark->batch = sprite_batch_create(benchmark->count);
+
+	uint32 state = BENCHMARK_SEED;
+	for (int32 i = 0; i < benchmark->count; i++) {
+		Vector2 position = vec2(benchmark_random_range(&state, 0.0f, 1920.0f), benchmark_random_range(&state, 0.0f, 1080.0f));
+		float32 rotation = benchmark_random_range(&state, 0.0f, 360.0f);
+		sprite_batch_add(benchmark->batch, sprite_benchmark_texture(benchmark, i), position, vec2(1.0f, 1.0f), rotation);
+	}
+
+	return benchmark;
+}
+
+// Every sprite moves each frame, so each quad is rebuilt before it is batched
+static uint64 sprite_batch_run(void *user_data) {
+	SpriteBenchmark *benchmark = user_data;
+
+	float32 offset = (benchmark->frame++ & 1) ? 1.0f : -1.0f;
+	Vector2 *positions = sprite_batch_edit_positions(benchmark->batch);
+	for (int32 i = 0; i < benchmark->count; i++) {
+		positions[i].x += offset;
+	}
+
+	sprite_batch_emit(benchmark->batch);
+	batch_renderer_end_frame();
+
+	return benchmark->count;
+}
+
+static void *sprite_draw_setup(const BenchmarkContext *context) {
+	SpriteBenchmark *benchmark = sprite_benchmark_create(context);
+	benchmark->sprites = ls_malloc(benchmark->count * sizeof(Sprite *));
+
+	uint32 state = BENCHMARK_SEED;
+	for (int32 i = 0; i < benchmark->count; i++) {
+		Vector2 position = vec2(benchmark_random_range(&state, 0.0f, 1920.0f), benchmark_random_range(&state, 0.0f, 1080.0f));
+		float32 rotation = benchmark_random_range(&state, 0.0f, 360.0f);
+		Texture *texture = texture_ref(sprite_benchmark_texture(benchmark, i));
+		benchmark->sprites[i] = renderer_create_sprite_texture(context->renderer, texture, position, vec2(1.0f, 1.0f), rotation);
+	}
+
+	return benchmark;
+}
+
+// Same scene as sprite_batch, drawn one Sprite at a time
+static uint64 sprite_draw_run(void *user_data) {
+	SpriteBenchmark *benchmark = user_data;
+
+	float32 offset = (benchmark->frame++ & 1) ? 1.0f : -1.0f;
+	for (int32 i = 0; i < benchmark->count; i++) {
+		Sprite *sprite = benchmark->sprites[i];
+		Vector2 position = sprite_get_position(sprite);
+		sprite_set_position(sprite, vec2(position.x + offset, position.y));
+		sprite_draw(sprite);
+	}
+
+	batch_renderer_end_frame();
+
+	return benchmark->count;
+}
+
+static void *shader_parse_setup(const BenchmarkContext *context) {
+	return context->renderer;
+}
+
+// With the NONE backend only the preprocessor and the stage split run
+static uint64 shader_parse_run(void *user_data) {
+	const Renderer *renderer = user_data;
+
+	size_t length = ls_str_length(BATCH_SHADER_SOURCE);
+	for (int32 i = 0; i < SHADER_PARSES; i++) {
+		Shader *shader = renderer_create_shader(renderer, BATCH_SHADER_SOURCE, length);
+		sink += shader != NULL;
+		shader_destroy(shader);
+	}
+
+	return SHADER_PARSES;
+}
+
+static const Benchmark renderer_benchmarks[] = {
+	{ .name = "sprite_batch", .unit = "sprite", .setup = sprite_batch_setup, .run = sprite_batch_run, .teardown = sprite_benchmark_teardown },
+	{ .name = "sprite_draw", .unit = "sprite", .setup = sprite_draw_setup, .run = sprite_draw_run, .teardown = sprite_benchmark_teardown },
+	{ .name = "shader_parse", .unit = "shader", .setup = shader_parse_setup, .run = shader_parse_run, .teardown = NULL },
+};
+
+void register_renderer_benchmarks() {
+	for (size_t i = 0; i < sizeof(renderer_benchmarks) / sizeof(renderer_benchmarks[0]); i++) {
+		benchmark_register(renderer_benchmarks[i]);
+	}
+}
\ No newline at end of file
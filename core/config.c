@@ -2,6 +2,7 @@
 #include "core/debug.h"
 #include "core/log.h"
 #include "core/os/os.h"
+#include "core/types/array.h"
 #include "core/types/hashtable.h"
 #include "core/types/slice.h"
 #include "core/types/string.h"
@@ -25,7 +26,7 @@ void write_config(String path, const Hashtable *config) {
 	Slice *keys = hashtable_get_keys(config);
 
 	for (size_t i = 0; i < slice_get_size(keys); i++) {
-		String key = slice_get(keys, i).str;
+		String key = ((const HashtableKey *)slice_get(keys, i).cptr)->str;
 		String value = hashtable_get(config, HASH_KEY(str, key)).str;
 
 		char *line = ls_str_format("%s: %s\n", key, value);
@@ -57,8 +58,10 @@ Hashtable *read_config(String path) {
 
 	enum ConfigParserState state = CONFIG_STATE_NONE;
 
-	Slice8 *current_key = slice8_create(32);
-	Slice8 *current_value = slice8_create(32);
+	CharArray current_key;
+	CharArray current_value;
+	char_array_init(&current_key, 32);
+	char_array_init(&current_value, 32);
 	char *cur_char = file_data;
 	while (*cur_char) {
 		switch (state) {
@@ -87,7 +90,7 @@ Hashtable *read_config(String path) {
 				} else if ((*cur_char >= 'A' && *cur_char <= 'z') ||
 						(*cur_char >= '0' && *cur_char <= '9') ||
 						*cur_char == '.') {
-					slice8_append(current_key, SLICE_VAL8(chr, *cur_char));
+					char_array_append(&current_key, *cur_char);
 				} else {
 					ls_log(LOG_LEVEL_ERROR, "Invalid character '%c' in config file %s\n", *cur_char, path);
 					goto error;
@@ -96,17 +99,17 @@ Hashtable *read_config(String path) {
 			case CONFIG_STATE_VALUE: {
 				if ((*cur_char == '\n') || (*cur_char == '\r' && *(cur_char + 1) == '\n')) {
 					state = CONFIG_STATE_NONE;
-					slice8_append(current_key, SLICE_VAL8(chr, '\0'));
-					slice8_append(current_value, SLICE_VAL8(chr, '\0'));
+					char_array_append(&current_key, '\0');
+					char_array_append(&current_value, '\0');
 
-					char *key = ls_str_copy(slice8_get_data(current_key));
-					char *value = ls_str_copy(slice8_get_data(current_value));
+					char *key = ls_str_copy(current_key.data);
+					char *value = ls_str_copy(current_value.data);
 
 					hashtable_set(config, HASH_KEY(str, key), HASH_VAL(str, value));
-					slice8_clear(current_key);
-					slice8_clear(current_value);
+					char_array_clear(&current_key);
+					char_array_clear(&current_value);
 				} else if ((*cur_char >= ' ' && *cur_char <= '~')) {
-					slice8_append(current_value, SLICE_VAL8(chr, *cur_char));
+					char_array_append(&current_value, *cur_char);
 				} else {
 					ls_log(LOG_LEVEL_ERROR, "Invalid character '%c' in config file %s\n", *cur_char, path);
 					goto error;
@@ -117,20 +120,20 @@ Hashtable *read_config(String path) {
 	}
 
 	if (state == CONFIG_STATE_VALUE) {
-		slice8_append(current_key, SLICE_VAL8(chr, '\0'));
-		slice8_append(current_value, SLICE_VAL8(chr, '\0'));
+		char_array_append(&current_key, '\0');
+		char_array_append(&current_value, '\0');
 
-		char *key = ls_str_copy(slice8_get_data(current_key));
-		char *value = ls_str_copy(slice8_get_data(current_value));
+		char *key = ls_str_copy(current_key.data);
+		char *value = ls_str_copy(current_value.data);
 
 		hashtable_set(config, HASH_KEY(str, key), HASH_VAL(str, value));
-		slice8_clear(current_key);
-		slice8_clear(current_value);
+		char_array_clear(&current_key);
+		char_array_clear(&current_value);
 	}
 
 error:
-	slice8_destroy(current_key);
-	slice8_destroy(current_value);
+	char_array_destroy(&current_key);
+	char_array_destroy(&current_value);
 	ls_free(file_data);
 
 	return config;
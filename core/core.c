@@ -4,6 +4,7 @@
 #include "core/flags.h"
 #include "core/input/input_manager.h"
 #include "core/log.h"
+#include "core/profiler.h"
 #include "core/types/string.h"
 
 struct LSCore {
@@ -19,13 +20,14 @@ struct LSCore {
 
 static void core_check_flags(const LSCore *core);
 
-LSCore *core_create(FlagManager *flag_manager) {
+static LSCore *core_create_internal(FlagManager *flag_manager, bool headless) {
 	LSCore *core = ls_malloc(sizeof(LSCore));
 
 	core->flag_manager = flag_manager;
 
 	core->log_level = flag_manager_register(core->flag_manager, "log-level", FLAG_TYPE_STRING, (FlagValue){ .str = "INFO" },
 			"The log level to use. Valid values are `INFO`, `DEBUG`, `WARNING` and `ERROR`");
+	profiler_register_flags(core->flag_manager);
 
 	core->event_manager = event_manager_create();
 	LS_ASSERT(core->event_manager);
@@ -33,14 +35,26 @@ LSCore *core_create(FlagManager *flag_manager) {
 	core->input_manager = ls_create_input_manager(core->event_manager);
 	LS_ASSERT(core->input_manager);
 
-	core->os = ls_create_os(core->input_manager);
-	LS_ASSERT(core->os);
+	core->os = NULL;
+	if (!headless) {
+		core->os = ls_create_os(core->input_manager);
+		LS_ASSERT(core->os);
+	}
 
 	return core;
 }
 
+LSCore *core_create(FlagManager *flag_manager) {
+	return core_create_internal(flag_manager, false);
+}
+
+LSCore *core_create_headless(FlagManager *flag_manager) {
+	return core_create_internal(flag_manager, true);
+}
+
 void core_start(const LSCore *core) {
 	core_check_flags(core);
+	profiler_init();
 }
 
 void core_poll(const LSCore *core) {
@@ -48,8 +62,12 @@ void core_poll(const LSCore *core) {
 }
 
 void core_destroy(LSCore *core) {
-	ls_destroy_os(core->os);
-	core->os = NULL;
+	profiler_deinit();
+
+	if (core->os) {
+		ls_destroy_os(core->os);
+		core->os = NULL;
+	}
 
 	input_manager_destroy(core->input_manager);
 	core->input_manager = NULL;
@@ -62,6 +80,9 @@ void core_destroy(LSCore *core) {
 	flag_manager_destroy(core->flag_manager);
 #endif // !LS_WINDOWS
 	core->flag_manager = NULL;
+
+	ls_atoms_deinit();
+	ls_memory_deinit();
 }
 
 FlagManager *core_get_flag_manager(const LSCore *core) {
@@ -4,9 +4,11 @@
 #include "core/api.h"
 
 /* --------------TYPES-------------- */
+#include "core/types/array.h"
 #include "core/types/color.h"
 #include "core/types/hashtable.h"
 #include "core/types/slice.h"
+#include "core/types/spatial_index.h"
 #include "core/types/string.h"
 /* --------------------------------- */
 
@@ -26,12 +28,16 @@
 #include "core/memory.h"
 #include "core/os/os.h"
 #include "core/os/thread.h"
+#include "core/os/worker_pool.h"
+#include "core/profiler.h"
 #include "core/version.h"
 /* -------------------------------------- */
 
 typedef struct LSCore LSCore;
 
 LSCore *core_create(FlagManager *flag_manager);
+// Creates a core without a display server, windows cannot be created and the renderer falls back to NONE.
+LSCore *core_create_headless(FlagManager *flag_manager);
 void core_destroy(LSCore *core);
 
 void core_start(const LSCore *core);
@@ -40,6 +46,7 @@ void core_poll(const LSCore *core);
 LS_EXPORT FlagManager *core_get_flag_manager(const LSCore *core);
 LS_EXPORT InputManager *core_get_input_manager(const LSCore *core);
 LS_EXPORT EventManager *core_get_event_manager(const LSCore *core);
+// Returns NULL for a headless core.
 LS_EXPORT const OS *core_get_os(const LSCore *core);
 
 #endif // CORE_H
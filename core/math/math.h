@@ -14,6 +14,8 @@ _FORCE_INLINE_ int32 math_min(int32 a, int32 b) { return a < b ? a : b; }
 
 _FORCE_INLINE_ int32 math_clamp(int32 value, int32 min, int32 max) { return math_max(min, math_min(max, value)); }
 
+_FORCE_INLINE_ float32 math_absf(float32 x) { return x < 0.0f ? -x : x; }
+
 // Angle in radians
 LS_EXPORT float32 math_tanf(float32 x);
 // Taylor series, angle in radians
@@ -1,6 +1,24 @@
 #include "core/math/matrix.h"
 #include "core/log.h"
 #include "core/math/math.h"
+#include "core/math/simd.h"
+
+#if defined(SIMD_ENABLED)
+// One row of a * b, the row of a scaling the rows of b
+_FORCE_INLINE_ f32x4 mat4_multiply_row(const float32 *a_row, const f32x4 b_rows[4]) {
+	f32x4 row = f32x4_mul(f32x4_splat(a_row[3]), b_rows[3]);
+	row = f32x4_madd(f32x4_splat(a_row[2]), b_rows[2], row);
+	row = f32x4_madd(f32x4_splat(a_row[1]), b_rows[1], row);
+	return f32x4_madd(f32x4_splat(a_row[0]), b_rows[0], row);
+}
+
+// Transforms a point by the matrix columns, the last lane holds the w row and is dropped by callers
+_FORCE_INLINE_ f32x4 mat4_transform_point(const f32x4 columns[4], float32 x, float32 y, float32 z) {
+	f32x4 result = f32x4_madd(columns[2], f32x4_splat(z), columns[3]);
+	result = f32x4_madd(columns[1], f32x4_splat(y), result);
+	return f32x4_madd(columns[0], f32x4_splat(x), result);
+}
+#endif
 
 Matrix4 mat4_ortho(float32 left, float32 right, float32 bottom, float32 top, float32 near, float32 far) {
 	Matrix4 result = MAT4_IDENTITY;
@@ -75,6 +93,12 @@ Matrix4 mat4_scale(const Vector3 scale) {
 Matrix4 mat4_multiply(const Matrix4 a, const Matrix4 b) {
 	Matrix4 result;
 
+#if defined(SIMD_ENABLED)
+	const f32x4 b_rows[4] = { f32x4_load(&b.mat[0]), f32x4_load(&b.mat[4]), f32x4_load(&b.mat[8]), f32x4_load(&b.mat[12]) };
+	for (int32 i = 0; i < 4; i++) {
+		f32x4_store(&result.mat[i * 4], mat4_multiply_row(&a.mat[i * 4], b_rows));
+	}
+#else
 	for (int32 i = 0; i < 4; i++) {
 		for (int32 j = 0; j < 4; j++) {
 			result.mat[i * 4 + j] = 0.0f;
@@ -83,20 +107,79 @@ Matrix4 mat4_multiply(const Matrix4 a, const Matrix4 b) {
 			}
 		}
 	}
+#endif
 
 	return result;
 }
 
+void mat4a_multiply(Matrix4A *out, const Matrix4A *a, const Matrix4A *b) {
+#if defined(SIMD_ENABLED)
+	const f32x4 b_rows[4] = { f32x4_load_aligned(&b->mat[0]), f32x4_load_aligned(&b->mat[4]), f32x4_load_aligned(&b->mat[8]), f32x4_load_aligned(&b->mat[12]) };
+
+	// Every row is computed before storing, out may alias a or b
+	f32x4 rows[4];
+	for (int32 i = 0; i < 4; i++) {
+		rows[i] = mat4_multiply_row(&a->mat[i * 4], b_rows);
+	}
+
+	for (int32 i = 0; i < 4; i++) {
+		f32x4_store_aligned(&out->mat[i * 4], rows[i]);
+	}
+#else
+	out->m = mat4_multiply(a->m, b->m);
+#endif
+}
+
 Vector3 mat4_multiply_vec3(const Matrix4 matrix, const Vector3 vector) {
 	Vector3 result;
 
+#if defined(SIMD_ENABLED)
+	f32x4 columns[4];
+	f32x4_load_columns(matrix.mat, columns);
+	f32x4_store3(result.vec, mat4_transform_point(columns, vector.x, vector.y, vector.z));
+#else
 	result.x = matrix.x0 * vector.x + matrix.y0 * vector.y + matrix.z0 * vector.z + matrix.w0;
 	result.y = matrix.x1 * vector.x + matrix.y1 * vector.y + matrix.z1 * vector.z + matrix.w1;
 	result.z = matrix.x2 * vector.x + matrix.y2 * vector.y + matrix.z2 * vector.z + matrix.w2;
+#endif
 
 	return result;
 }
 
+void mat4_transform_vec3_array(const Matrix4 *matrix, const Vector3 *vectors, Vector3 *out, size_t count) {
+#if defined(SIMD_ENABLED)
+	f32x4 columns[4];
+	f32x4_load_columns(matrix->mat, columns);
+
+	for (size_t i = 0; i < count; i++) {
+		const Vector3 vector = vectors[i];
+		f32x4_store3(out[i].vec, mat4_transform_point(columns, vector.x, vector.y, vector.z));
+	}
+#else
+	for (size_t i = 0; i < count; i++) {
+		out[i] = mat4_multiply_vec3(*matrix, vectors[i]);
+	}
+#endif
+}
+
+void mat4a_transform_vec3a_array(const Matrix4A *matrix, const Vector3A *vectors, Vector3A *out, size_t count) {
+#if defined(SIMD_ENABLED)
+	f32x4 columns[4];
+	f32x4_load_columns(matrix->mat, columns);
+
+	for (size_t i = 0; i < count; i++) {
+		const Vector3A vector = vectors[i];
+		// The padding lane holds w after the transform, cleared to match vec3a
+		f32x4_store_aligned(out[i].vec, f32x4_clear_w(mat4_transform_point(columns, vector.x, vector.y, vector.z)));
+	}
+#else
+	for (size_t i = 0; i < count; i++) {
+		Vector3 result = mat4_multiply_vec3(matrix->m, vec3(vectors[i].x, vectors[i].y, vectors[i].z));
+		out[i] = vec3a(result.x, result.y, result.z);
+	}
+#endif
+}
+
 Matrix4 mat4_divide(const Matrix4 matrix, float32 value) {
 	Matrix4 result = MAT4_IDENTITY;
 
@@ -27,6 +27,13 @@ typedef union {
 	float32 mat[16];
 } Matrix4;
 
+// Matrix4 aligned to 16 bytes for the SIMD kernels.
+// Pass it by pointer, MSVC cannot pass over aligned types by value on x86_32.
+typedef union {
+	Matrix4 m;
+	_ALIGN_(16) float32 mat[16];
+} Matrix4A;
+
 #define MAT4_IDENTITY   \
 	(Matrix4) {         \
 		{               \
@@ -56,6 +63,11 @@ LS_EXPORT Matrix4 mat4_rotate(float32 angle, const Vector3 axis);
 LS_EXPORT Matrix4 mat4_scale(const Vector3 scale);
 LS_EXPORT Matrix4 mat4_multiply(const Matrix4 a, const Matrix4 b);
 LS_EXPORT Vector3 mat4_multiply_vec3(const Matrix4 matrix, const Vector3 vector);
+// Transforms count points by matrix, the same as calling mat4_multiply_vec3 on each. out may be vectors.
+LS_EXPORT void mat4_transform_vec3_array(const Matrix4 *matrix, const Vector3 *vectors, Vector3 *out, size_t count);
+// Aligned variants of mat4_multiply and mat4_transform_vec3_array. out may be one of the inputs.
+LS_EXPORT void mat4a_multiply(Matrix4A *out, const Matrix4A *a, const Matrix4A *b);
+LS_EXPORT void mat4a_transform_vec3a_array(const Matrix4A *matrix, const Vector3A *vectors, Vector3A *out, size_t count);
 LS_EXPORT Matrix4 mat4_divide(const Matrix4 matrix, float32 value);
 LS_EXPORT Matrix4 mat4_add(const Matrix4 a, const Matrix4 b);
 LS_EXPORT Matrix4 mat4_subtract(const Matrix4 a, const Matrix4 b);
@@ -0,0 +1,121 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include "core/types/typedefs.h"
+
+// Minimal four lane float helpers over SSE2 or NEON, selected by the simd build option.
+// SIMD_ENABLED is left undefined when neither is available and callers use their scalar path.
+
+#if defined(SIMD_SSE_ENABLED)
+#include <emmintrin.h>
+#define SIMD_ENABLED
+
+typedef __m128 f32x4;
+
+_FORCE_INLINE_ f32x4 f32x4_load(const float32 *p) {
+	return _mm_loadu_ps(p);
+}
+
+_FORCE_INLINE_ f32x4 f32x4_load_aligned(const float32 *p) {
+	return _mm_load_ps(p);
+}
+
+_FORCE_INLINE_ void f32x4_store(float32 *p, f32x4 v) {
+	_mm_storeu_ps(p, v);
+}
+
+_FORCE_INLINE_ void f32x4_store_aligned(float32 *p, f32x4 v) {
+	_mm_store_ps(p, v);
+}
+
+// Stores the first three lanes
+_FORCE_INLINE_ void f32x4_store3(float32 *p, f32x4 v) {
+	_mm_storel_pi((__m64 *)p, v);
+	_mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+}
+
+_FORCE_INLINE_ f32x4 f32x4_splat(float32 x) {
+	return _mm_set1_ps(x);
+}
+
+// a * b + c
+_FORCE_INLINE_ f32x4 f32x4_madd(f32x4 a, f32x4 b, f32x4 c) {
+	return _mm_add_ps(_mm_mul_ps(a, b), c);
+}
+
+_FORCE_INLINE_ f32x4 f32x4_mul(f32x4 a, f32x4 b) {
+	return _mm_mul_ps(a, b);
+}
+
+// Returns v with the last lane set to 0
+_FORCE_INLINE_ f32x4 f32x4_clear_w(f32x4 v) {
+	return _mm_and_ps(v, _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)));
+}
+
+// Loads a row major 4x4 matrix as its four columns
+_FORCE_INLINE_ void f32x4_load_columns(const float32 *m, f32x4 columns[4]) {
+	columns[0] = _mm_loadu_ps(m);
+	columns[1] = _mm_loadu_ps(m + 4);
+	columns[2] = _mm_loadu_ps(m + 8);
+	columns[3] = _mm_loadu_ps(m + 12);
+	_MM_TRANSPOSE4_PS(columns[0], columns[1], columns[2], columns[3]);
+}
+
+#elif defined(SIMD_NEON_ENABLED)
+#include <arm_neon.h>
+#define SIMD_ENABLED
+
+typedef float32x4_t f32x4;
+
+_FORCE_INLINE_ f32x4 f32x4_load(const float32 *p) {
+	return vld1q_f32(p);
+}
+
+_FORCE_INLINE_ f32x4 f32x4_load_aligned(const float32 *p) {
+	return vld1q_f32(p);
+}
+
+_FORCE_INLINE_ void f32x4_store(float32 *p, f32x4 v) {
+	vst1q_f32(p, v);
+}
+
+_FORCE_INLINE_ void f32x4_store_aligned(float32 *p, f32x4 v) {
+	vst1q_f32(p, v);
+}
+
+// Stores the first three lanes
+_FORCE_INLINE_ void f32x4_store3(float32 *p, f32x4 v) {
+	vst1_f32(p, vget_low_f32(v));
+	vst1q_lane_f32(p + 2, v, 2);
+}
+
+_FORCE_INLINE_ f32x4 f32x4_splat(float32 x) {
+	return vdupq_n_f32(x);
+}
+
+// a * b + c
+_FORCE_INLINE_ f32x4 f32x4_madd(f32x4 a, f32x4 b, f32x4 c) {
+	return vmlaq_f32(c, a, b);
+}
+
+_FORCE_INLINE_ f32x4 f32x4_mul(f32x4 a, f32x4 b) {
+	return vmulq_f32(a, b);
+}
+
+// Returns v with the last lane set to 0
+_FORCE_INLINE_ f32x4 f32x4_clear_w(f32x4 v) {
+	return vsetq_lane_f32(0.0f, v, 3);
+}
+
+// Loads a row major 4x4 matrix as its four columns
+_FORCE_INLINE_ void f32x4_load_columns(const float32 *m, f32x4 columns[4]) {
+	float32x4x4_t deinterleaved = vld4q_f32(m);
+	columns[0] = deinterleaved.val[0];
+	columns[1] = deinterleaved.val[1];
+	columns[2] = deinterleaved.val[2];
+	columns[3] = deinterleaved.val[3];
+}
+
+#endif
+
+#endif // SIMD_H
\ No newline at end of file
@@ -37,6 +37,18 @@ typedef union {
 	float32 vec[3];
 } Vector3;
 
+// Vector3 padded to four floats and 16 byte aligned, so SIMD kernels can load and store it whole.
+typedef union {
+	struct {
+		float32 x;
+		float32 y;
+		float32 z;
+		// Padding, ignored by the kernels
+		float32 w;
+	};
+	_ALIGN_(16) float32 vec[4];
+} Vector3A;
+
 typedef union {
 	struct {
 		int32 x;
@@ -59,6 +71,7 @@ typedef union {
 #define vec2i(x, y) ((Vector2i){ { x, y } })
 #define vec2u(x, y) ((Vector2u){ { x, y } })
 #define vec3(x, y, z) ((Vector3){ { x, y, z } })
+#define vec3a(x, y, z) ((Vector3A){ { x, y, z, 0.0f } })
 #define vec3i(x, y, z) ((Vector3i){ { x, y, z } })
 #define vec3u(x, y, z) ((Vector3u){ { x, y, z } })
 
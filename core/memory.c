@@ -1,26 +1,705 @@
 #include "core/memory.h"
 
-#include <malloc.h>
+#include "core/debug.h"
+
 #include <stdarg.h>
+#include <stdatomic.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
-void *ls_malloc(size_t size) {
+// Alignment of arena, pool and bump allocations, enough for any type the engine stores.
+#define LS_MEMORY_ALIGNMENT 16
+#define LS_MEMORY_ALIGN(size) (((size) + (LS_MEMORY_ALIGNMENT - 1)) & ~(size_t)(LS_MEMORY_ALIGNMENT - 1))
+
+#define FRAME_ARENA_BLOCK_SIZE (64 * 1024)
+#define BUMP_BLOCK_SIZE (4 * 1024 * 1024)
+
+// System allocator
+
+static void *system_malloc(size_t size, void *user_data) {
 	return malloc(size);
 }
 
-void *ls_realloc(void *ptr, size_t size) {
+static void *system_calloc(size_t count, size_t size, void *user_data) {
+	return calloc(count, size);
+}
+
+static void *system_realloc(void *ptr, size_t size, void *user_data) {
 	return realloc(ptr, size);
 }
 
-void *ls_calloc(size_t count, size_t size) {
-	return calloc(count, size);
+static void system_free(void *ptr, void *user_data) {
+	free(ptr);
+}
+
+static const LSAllocator system_allocator = {
+	.name = "system",
+	.malloc = system_malloc,
+	.calloc = system_calloc,
+	.realloc = system_realloc,
+	.free = system_free,
+	.user_data = NULL,
+};
+
+// Bump allocator
+// Every allocation is prefixed with its size so realloc knows how much to copy.
+// Blocks come from calloc and are never reused, so all memory it returns is already zeroed.
+// Each thread bumps through its own block, so worker and audio threads allocate without locking.
+
+typedef struct {
+	uint8 *data;
+	size_t used;
+	size_t size;
+} BumpState;
+
+static _Thread_local BumpState bump_state = { 0 };
+
+static void *bump_malloc(size_t size, void *user_data) {
+	BumpState *state = &bump_state;
+	if (size > SIZE_MAX - 2 * LS_MEMORY_ALIGNMENT) {
+		return NULL;
+	}
+	size_t needed = LS_MEMORY_ALIGNMENT + LS_MEMORY_ALIGN(size);
+
+	if (needed > BUMP_BLOCK_SIZE / 2) {
+		uint8 *data = calloc(1, needed);
+		if (!data) {
+			return NULL;
+		}
+		*(size_t *)data = size;
+		return data + LS_MEMORY_ALIGNMENT;
+	}
+
+	if (!state->data || state->used + needed > state->size) {
+		// The rest of the old block is abandoned
+		state->data = calloc(1, BUMP_BLOCK_SIZE);
+		if (!state->data) {
+			return NULL;
+		}
+		state->used = 0;
+		state->size = BUMP_BLOCK_SIZE;
+	}
+
+	uint8 *data = state->data + state->used;
+	state->used += needed;
+	*(size_t *)data = size;
+
+	return data + LS_MEMORY_ALIGNMENT;
+}
+
+static void *bump_calloc(size_t count, size_t size, void *user_data) {
+	if (size != 0 && count > SIZE_MAX / size) {
+		return NULL;
+	}
+
+	return bump_malloc(count * size, user_data);
+}
+
+static void *bump_realloc(void *ptr, size_t size, void *user_data) {
+	void *new_ptr = bump_malloc(size, user_data);
+	if (ptr && new_ptr) {
+		size_t old_size = *(size_t *)((uint8 *)ptr - LS_MEMORY_ALIGNMENT);
+		memcpy(new_ptr, ptr, old_size < size ? old_size : size);
+	}
+
+	return new_ptr;
+}
+
+static void bump_free(void *ptr, void *user_data) {
 }
 
-void *ls_alloca(size_t size) {
-	return alloca(size);
+static const LSAllocator bump_allocator = {
+	.name = "bump",
+	.malloc = bump_malloc,
+	.calloc = bump_calloc,
+	.realloc = bump_realloc,
+	.free = bump_free,
+	.user_data = NULL,
+};
+
+static const LSAllocator *allocator = &system_allocator;
+// Set by the first allocation from any thread, after that the allocator can no longer change.
+static atomic_bool allocator_used = false;
+
+_FORCE_INLINE_ void mark_allocator_used() {
+	// Loaded first so allocations do not keep writing the shared flag
+	if (!atomic_load_explicit(&allocator_used, memory_order_relaxed)) {
+		atomic_store_explicit(&allocator_used, true, memory_order_relaxed);
+	}
 }
 
+const LSAllocator *ls_get_system_allocator() {
+	return &system_allocator;
+}
+
+const LSAllocator *ls_get_bump_allocator() {
+	return &bump_allocator;
+}
+
+const LSAllocator *ls_find_allocator(const char *name) {
+	if (strcmp(name, system_allocator.name) == 0) {
+		return &system_allocator;
+	}
+
+	if (strcmp(name, bump_allocator.name) == 0) {
+		return &bump_allocator;
+	}
+
+	return NULL;
+}
+
+bool ls_set_allocator(const LSAllocator *new_allocator) {
+	LS_ASSERT(new_allocator);
+
+	if (atomic_load(&allocator_used) && new_allocator != allocator) {
+		return false;
+	}
+
+	allocator = new_allocator;
+	return true;
+}
+
+const LSAllocator *ls_get_allocator() {
+	return allocator;
+}
+
+// The definitions are parenthesized so the call site macros of tracked builds do not expand them.
+
+#if !defined(MEMORY_TRACKING_ENABLED)
+
+void *(ls_malloc)(size_t size) {
+	mark_allocator_used();
+	return allocator->malloc(size, allocator->user_data);
+}
+
+void *(ls_realloc)(void *ptr, size_t size) {
+	mark_allocator_used();
+	return allocator->realloc(ptr, size, allocator->user_data);
+}
+
+void *(ls_calloc)(size_t count, size_t size) {
+	mark_allocator_used();
+	return allocator->calloc(count, size, allocator->user_data);
+}
+
+void ls_free(void *ptr) {
+	allocator->free(ptr, allocator->user_data);
+}
+
+void *ls_malloc_at(size_t size, const char *file, int32 line) {
+	return (ls_malloc)(size);
+}
+
+void *ls_calloc_at(size_t count, size_t size, const char *file, int32 line) {
+	return (ls_calloc)(count, size);
+}
+
+void *ls_realloc_at(void *ptr, size_t size, const char *file, int32 line) {
+	return (ls_realloc)(ptr, size);
+}
+
+bool ls_memory_is_tracking() {
+	return false;
+}
+
+LSMemoryStats ls_memory_get_stats() {
+	return (LSMemoryStats){ 0 };
+}
+
+size_t ls_memory_get_site_count() {
+	return 0;
+}
+
+bool ls_memory_get_site(size_t index, LSMemorySiteStats *stats) {
+	return false;
+}
+
+void ls_memory_end_frame() {
+}
+
+void ls_memory_set_frame_budget(int32 max_allocations) {
+}
+
+bool ls_memory_dump(const char *path) {
+	ls_log(LOG_LEVEL_WARNING, "Memory tracking is disabled, build with memory_tracking=yes to dump allocations.\n");
+	return false;
+}
+
+#else // MEMORY_TRACKING_ENABLED
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+
+#include <stdio.h>
+
+// Power of two, one extra site collects call sites that no longer fit.
+#define MEMORY_MAX_SITES 4096
+#define MEMORY_OVERFLOW_SITE MEMORY_MAX_SITES
+
+// Prefixed to every allocation so frees know the size and site to credit.
+typedef union {
+	struct {
+		size_t size;
+		uint32 site;
+	} info;
+	uint8 padding[LS_MEMORY_ALIGNMENT];
+} MemoryHeader;
+
+typedef struct {
+	const char *file;
+	int32 line;
+	uint32 hash;
+
+	size_t live_bytes;
+	size_t live_count;
+	size_t total_bytes;
+	size_t total_count;
+
+	// Counters of the frame in progress and of the last completed one
+	size_t current_frame_bytes;
+	size_t current_frame_count;
+	size_t frame_bytes;
+	size_t frame_count;
+} MemorySite;
+
+static struct {
+	LSMutex *mutex;
+	bool creating_mutex;
+
+	MemorySite sites[MEMORY_MAX_SITES + 1];
+	// Slots of the used sites in first use order
+	uint32 used_sites[MEMORY_MAX_SITES + 1];
+	uint32 nused_sites;
+
+	LSMemoryStats stats;
+	size_t current_frame_bytes;
+	size_t current_frame_count;
+
+	int32 frame_budget;
+} tracker = { .frame_budget = -1 };
+
+static void memory_lock() {
+	// The mutex allocates, so it is created by the first tracked allocation. Threads only start after that.
+	if (!tracker.mutex && !tracker.creating_mutex) {
+		tracker.creating_mutex = true;
+		LSMutex *mutex = os_mutex_create();
+		tracker.creating_mutex = false;
+		tracker.mutex = mutex;
+	}
+
+	if (tracker.mutex) {
+		os_mutex_lock(tracker.mutex);
+	}
+}
+
+static void memory_unlock() {
+	if (tracker.mutex) {
+		os_mutex_unlock(tracker.mutex);
+	}
+}
+
+static uint32 memory_site_hash(const char *file, int32 line) {
+	// __FILE__ strings are compared by content, headers expand to a different pointer in every unit
+	uint32 hash = 5381;
+	for (const char *c = file; *c; c++) {
+		hash = hash * 33 + (uint8)*c;
+	}
+	hash ^= (uint32)line * 0x9E3779B1u;
+
+	return hash;
+}
+
+static uint32 memory_find_site(const char *file, int32 line) {
+	if (!file) {
+		file = "unknown";
+	}
+
+	uint32 hash = memory_site_hash(file, line);
+	uint32 index = hash & (MEMORY_MAX_SITES - 1);
+	while (true) {
+		MemorySite *site = &tracker.sites[index];
+		if (!site->file) {
+			break;
+		}
+
+		if (site->hash == hash && site->line == line && (site->file == file || strcmp(site->file, file) == 0)) {
+			return index;
+		}
+
+		index = (index + 1) & (MEMORY_MAX_SITES - 1);
+	}
+
+	// Keep the table at most 3/4 full
+	if (tracker.nused_sites >= MEMORY_MAX_SITES / 4 * 3) {
+		MemorySite *overflow = &tracker.sites[MEMORY_OVERFLOW_SITE];
+		if (!overflow->file) {
+			overflow->file = "other";
+			tracker.used_sites[tracker.nused_sites++] = MEMORY_OVERFLOW_SITE;
+		}
+		return MEMORY_OVERFLOW_SITE;
+	}
+
+	MemorySite *site = &tracker.sites[index];
+	site->file = file;
+	site->line = line;
+	site->hash = hash;
+	tracker.used_sites[tracker.nused_sites++] = index;
+
+	return index;
+}
+
+static void memory_track_alloc(MemoryHeader *header, size_t size, const char *file, int32 line) {
+	memory_lock();
+
+	uint32 index = memory_find_site(file, line);
+	header->info.size = size;
+	header->info.site = index;
+
+	MemorySite *site = &tracker.sites[index];
+	site->live_bytes += size;
+	site->live_count++;
+	site->total_bytes += size;
+	site->total_count++;
+	site->current_frame_bytes += size;
+	site->current_frame_count++;
+
+	LSMemoryStats *stats = &tracker.stats;
+	stats->live_bytes += size;
+	stats->live_count++;
+	stats->total_bytes += size;
+	stats->total_count++;
+	if (stats->live_bytes > stats->peak_bytes) {
+		stats->peak_bytes = stats->live_bytes;
+	}
+	tracker.current_frame_bytes += size;
+	tracker.current_frame_count++;
+
+	memory_unlock();
+}
+
+static void memory_track_free(const MemoryHeader *header) {
+	memory_lock();
+
+	MemorySite *site = &tracker.sites[header->info.site];
+	site->live_bytes -= header->info.size;
+	site->live_count--;
+
+	tracker.stats.live_bytes -= header->info.size;
+	tracker.stats.live_count--;
+
+	memory_unlock();
+}
+
+void *(ls_malloc)(size_t size) {
+	return ls_malloc_at(size, NULL, 0);
+}
+
+void *(ls_realloc)(void *ptr, size_t size) {
+	return ls_realloc_at(ptr, size, NULL, 0);
+}
+
+void *(ls_calloc)(size_t count, size_t size) {
+	return ls_calloc_at(count, size, NULL, 0);
+}
+
+void *ls_malloc_at(size_t size, const char *file, int32 line) {
+	mark_allocator_used();
+
+	MemoryHeader *header = allocator->malloc(sizeof(MemoryHeader) + size, allocator->user_data);
+	if (!header) {
+		return NULL;
+	}
+
+	memory_track_alloc(header, size, file, line);
+	return header + 1;
+}
+
+void *ls_calloc_at(size_t count, size_t size, const char *file, int32 line) {
+	mark_allocator_used();
+
+	if (size != 0 && count > (SIZE_MAX - sizeof(MemoryHeader)) / size) {
+		return NULL;
+	}
+
+	MemoryHeader *header = allocator->calloc(1, sizeof(MemoryHeader) + count * size, allocator->user_data);
+	if (!header) {
+		return NULL;
+	}
+
+	memory_track_alloc(header, count * size, file, line);
+	return header + 1;
+}
+
+void *ls_realloc_at(void *ptr, size_t size, const char *file, int32 line) {
+	if (!ptr) {
+		return ls_malloc_at(size, file, line);
+	}
+
+	// The whole block moves to the site of the realloc
+	MemoryHeader *header = (MemoryHeader *)ptr - 1;
+	MemoryHeader old_header = *header;
+	memory_track_free(&old_header);
+
+	MemoryHeader *new_header = allocator->realloc(header, sizeof(MemoryHeader) + size, allocator->user_data);
+	if (!new_header) {
+		memory_lock();
+		MemorySite *site = &tracker.sites[old_header.info.site];
+		site->live_bytes += old_header.info.size;
+		site->live_count++;
+		tracker.stats.live_bytes += old_header.info.size;
+		tracker.stats.live_count++;
+		memory_unlock();
+		return NULL;
+	}
+
+	memory_track_alloc(new_header, size, file, line);
+	return new_header + 1;
+}
+
+void ls_free(void *ptr) {
+	if (!ptr) {
+		return;
+	}
+
+	MemoryHeader *header = (MemoryHeader *)ptr - 1;
+	memory_track_free(header);
+
+	allocator->free(header, allocator->user_data);
+}
+
+// Takes the subsystem from the first known top level directory in the path.
+static void memory_site_tag(const char *file, char *tag, size_t tag_size) {
+	static const char *const roots[] = { "core/", "renderer/", "main/", "thirdparty/", "modules/", "platform/" };
+	// Modules and platforms are split by their own directory
+	static const bool nested[] = { false, false, false, false, true, true };
+
+	char path[256];
+	size_t length = 0;
+	for (; file[length] && length < sizeof(path) - 1; length++) {
+		path[length] = file[length] == '\\' ? '/' : file[length];
+	}
+	path[length] = '\0';
+
+	const char *best = NULL;
+	size_t best_root = 0;
+	for (size_t i = 0; i < sizeof(roots) / sizeof(roots[0]); i++) {
+		for (const char *match = strstr(path, roots[i]); match; match = strstr(match + 1, roots[i])) {
+			if (match == path || match[-1] == '/') {
+				if (!best || match < best) {
+					best = match;
+					best_root = i;
+				}
+				break;
+			}
+		}
+	}
+
+	if (!best) {
+		snprintf(tag, tag_size, "%s", "other");
+		return;
+	}
+
+	const char *end = best + strlen(roots[best_root]) - 1;
+	if (nested[best_root]) {
+		const char *slash = strchr(end + 1, '/');
+		if (slash) {
+			end = slash;
+		}
+	}
+
+	snprintf(tag, tag_size, "%.*s", (int)(end - best), best);
+}
+
+static void memory_site_to_stats(const MemorySite *site, LSMemorySiteStats *stats) {
+	stats->file = site->file;
+	stats->line = site->line;
+	memory_site_tag(site->file, stats->tag, sizeof(stats->tag));
+
+	stats->live_bytes = site->live_bytes;
+	stats->live_count = site->live_count;
+	stats->total_bytes = site->total_bytes;
+	stats->total_count = site->total_count;
+	stats->frame_bytes = site->frame_bytes;
+	stats->frame_count = site->frame_count;
+}
+
+bool ls_memory_is_tracking() {
+	return true;
+}
+
+LSMemoryStats ls_memory_get_stats() {
+	memory_lock();
+	LSMemoryStats stats = tracker.stats;
+	memory_unlock();
+
+	return stats;
+}
+
+size_t ls_memory_get_site_count() {
+	memory_lock();
+	size_t count = tracker.nused_sites;
+	memory_unlock();
+
+	return count;
+}
+
+bool ls_memory_get_site(size_t index, LSMemorySiteStats *stats) {
+	LS_ASSERT(stats);
+
+	memory_lock();
+	if (index >= tracker.nused_sites) {
+		memory_unlock();
+		return false;
+	}
+
+	MemorySite site = tracker.sites[tracker.used_sites[index]];
+	memory_unlock();
+
+	memory_site_to_stats(&site, stats);
+	return true;
+}
+
+void ls_memory_end_frame() {
+	memory_lock();
+
+	LSMemoryStats *stats = &tracker.stats;
+	stats->frame_bytes = tracker.current_frame_bytes;
+	stats->frame_count = tracker.current_frame_count;
+	if (stats->frame_count > stats->peak_frame_count) {
+		stats->peak_frame_count = stats->frame_count;
+	}
+	stats->frames++;
+
+	tracker.current_frame_bytes = 0;
+	tracker.current_frame_count = 0;
+
+	const MemorySite *worst = NULL;
+	for (uint32 i = 0; i < tracker.nused_sites; i++) {
+		MemorySite *site = &tracker.sites[tracker.used_sites[i]];
+		site->frame_bytes = site->current_frame_bytes;
+		site->frame_count = site->current_frame_count;
+		site->current_frame_bytes = 0;
+		site->current_frame_count = 0;
+
+		if (!worst || site->frame_count > worst->frame_count) {
+			worst = site;
+		}
+	}
+
+	bool over_budget = tracker.frame_budget >= 0 && stats->frame_count > (size_t)tracker.frame_budget;
+	size_t frame_count = stats->frame_count;
+	uint64 frame = stats->frames;
+	MemorySite worst_site = worst ? *worst : (MemorySite){ .file = "none" };
+
+	memory_unlock();
+
+	// Logging allocates, so it happens outside the lock
+	if (over_budget) {
+		ls_log(LOG_LEVEL_WARNING, "Frame %llu made %zu allocations, budget is %d. Most from %s:%d (%zu).\n",
+				frame, frame_count, tracker.frame_budget, worst_site.file, worst_site.line, worst_site.frame_count);
+	}
+}
+
+void ls_memory_set_frame_budget(int32 max_allocations) {
+	tracker.frame_budget = max_allocations;
+}
+
+static int memory_compare_live_bytes(const void *a, const void *b) {
+	const LSMemorySiteStats *site_a = a;
+	const LSMemorySiteStats *site_b = b;
+
+	if (site_a->live_bytes != site_b->live_bytes) {
+		return site_a->live_bytes < site_b->live_bytes ? 1 : -1;
+	}
+
+	return site_a->total_count < site_b->total_count ? 1 : (site_a->total_count > site_b->total_count ? -1 : 0);
+}
+
+static void memory_dump_line(LSFile file, const char *format, ...) {
+	char line[512];
+
+	va_list args;
+	va_start(args, format);
+	int length = vsnprintf(line, sizeof(line), format, args);
+	va_end(args);
+
+	if (length > 0) {
+		os_write_file_data(file, line, (size_t)length < sizeof(line) ? (size_t)length : sizeof(line) - 1);
+	}
+}
+
+bool ls_memory_dump(const char *path) {
+	LS_ASSERT(path);
+
+	// The report uses the C heap directly so dumping does not show up in it
+	LSMemorySiteStats *sites = malloc((MEMORY_MAX_SITES + 1) * sizeof(LSMemorySiteStats));
+	if (!sites) {
+		return false;
+	}
+
+	memory_lock();
+	LSMemoryStats stats = tracker.stats;
+	size_t nsites = tracker.nused_sites;
+	for (size_t i = 0; i < nsites; i++) {
+		memory_site_to_stats(&tracker.sites[tracker.used_sites[i]], &sites[i]);
+	}
+	memory_unlock();
+
+	qsort(sites, nsites, sizeof(LSMemorySiteStats), memory_compare_live_bytes);
+
+	LSFile file = os_open_file(path, "w");
+	if (!file) {
+		ls_log(LOG_LEVEL_ERROR, "Failed to open memory dump file %s\n", path);
+		free(sites);
+		return false;
+	}
+
+	memory_dump_line(file, "Live: %zu bytes in %zu allocations, peak %zu bytes\n", stats.live_bytes, stats.live_count, stats.peak_bytes);
+	memory_dump_line(file, "Total: %zu bytes in %zu allocations\n", stats.total_bytes, stats.total_count);
+	memory_dump_line(file, "Frames: %llu, last frame %zu allocations (%zu bytes), peak %zu allocations\n\n",
+			stats.frames, stats.frame_count, stats.frame_bytes, stats.peak_frame_count);
+
+	// Per tag totals, sites of a tag are merged in first seen order
+	memory_dump_line(file, "%-24s %14s %10s %14s %10s\n", "Tag", "Live bytes", "Live", "Total", "Frame");
+	for (size_t i = 0; i < nsites; i++) {
+		bool seen = false;
+		for (size_t j = 0; j < i && !seen; j++) {
+			seen = strcmp(sites[i].tag, sites[j].tag) == 0;
+		}
+		if (seen) {
+			continue;
+		}
+
+		LSMemorySiteStats tag = sites[i];
+		for (size_t j = i + 1; j < nsites; j++) {
+			if (strcmp(sites[j].tag, tag.tag) == 0) {
+				tag.live_bytes += sites[j].live_bytes;
+				tag.live_count += sites[j].live_count;
+				tag.total_count += sites[j].total_count;
+				tag.frame_count += sites[j].frame_count;
+			}
+		}
+
+		memory_dump_line(file, "%-24s %14zu %10zu %14zu %10zu\n", tag.tag, tag.live_bytes, tag.live_count, tag.total_count, tag.frame_count);
+	}
+
+	memory_dump_line(file, "\n%-56s %14s %10s %14s %10s\n", "Call site", "Live bytes", "Live", "Total", "Frame");
+	for (size_t i = 0; i < nsites; i++) {
+		char site[256];
+		snprintf(site, sizeof(site), "%s:%d", sites[i].file, sites[i].line);
+		memory_dump_line(file, "%-56s %14zu %10zu %14zu %10zu\n", site,
+				sites[i].live_bytes, sites[i].live_count, sites[i].total_count, sites[i].frame_count);
+	}
+
+	os_close_file(file);
+	free(sites);
+
+	return true;
+}
+
+#endif // MEMORY_TRACKING_ENABLED
+
 void ls_memset(void *dest, int32 value, size_t size) {
 	memset(dest, value, size);
 }
@@ -33,6 +712,263 @@ void ls_memmove(void *dest, const void *src, size_t size) {
 	memmove(dest, src, size);
 }
 
-void ls_free(void *ptr) {
-	free(ptr);
+// Arena
+
+typedef struct ArenaBlock {
+	struct ArenaBlock *prev;
+	size_t size;
+	size_t used;
+} ArenaBlock;
+
+#define ARENA_BLOCK_HEADER_SIZE LS_MEMORY_ALIGN(sizeof(ArenaBlock))
+
+struct LSArena {
+	ArenaBlock *current;
+	size_t block_size;
+	size_t used;
+};
+
+static ArenaBlock *arena_block_create(ArenaBlock *prev, size_t size) {
+	ArenaBlock *block = ls_malloc(ARENA_BLOCK_HEADER_SIZE + size);
+	block->prev = prev;
+	block->size = size;
+	block->used = 0;
+
+	return block;
+}
+
+LSArena *ls_arena_create(size_t block_size) {
+	LS_ASSERT(block_size > 0);
+
+	LSArena *arena = ls_malloc(sizeof(LSArena));
+	arena->current = NULL;
+	arena->block_size = LS_MEMORY_ALIGN(block_size);
+	arena->used = 0;
+
+	return arena;
+}
+
+static void arena_free_blocks(ArenaBlock *block) {
+	while (block) {
+		ArenaBlock *prev = block->prev;
+		ls_free(block);
+		block = prev;
+	}
+}
+
+void ls_arena_destroy(LSArena *arena) {
+	LS_ASSERT(arena);
+
+	arena_free_blocks(arena->current);
+	ls_free(arena);
+}
+
+void *ls_arena_alloc(LSArena *arena, size_t size) {
+	LS_ASSERT(arena);
+
+	size = LS_MEMORY_ALIGN(size);
+
+	ArenaBlock *block = arena->current;
+	if (!block || block->used + size > block->size) {
+		size_t block_size = size > arena->block_size ? size : arena->block_size;
+		block = arena_block_create(block, block_size);
+		arena->current = block;
+	}
+
+	void *ptr = (uint8 *)block + ARENA_BLOCK_HEADER_SIZE + block->used;
+	block->used += size;
+	arena->used += size;
+
+	return ptr;
+}
+
+void *ls_arena_calloc(LSArena *arena, size_t count, size_t size) {
+	void *ptr = ls_arena_alloc(arena, count * size);
+	memset(ptr, 0, count * size);
+
+	return ptr;
+}
+
+char *ls_arena_str_copy(LSArena *arena, const char *string, size_t length) {
+	char *copy = ls_arena_alloc(arena, length + 1);
+	memcpy(copy, string, length);
+	copy[length] = '\0';
+
+	return copy;
+}
+
+void ls_arena_reset(LSArena *arena) {
+	LS_ASSERT(arena);
+
+	ArenaBlock *block = arena->current;
+	if (block && block->prev) {
+		// Coalesce into one block big enough for the whole last cycle
+		size_t total = 0;
+		for (ArenaBlock *it = block; it; it = it->prev) {
+			total += it->size;
+		}
+
+		arena_free_blocks(block);
+		block = arena_block_create(NULL, total);
+		arena->current = block;
+	}
+
+	if (block) {
+		block->used = 0;
+	}
+
+	arena->used = 0;
+}
+
+size_t ls_arena_get_used(const LSArena *arena) {
+	LS_ASSERT(arena);
+
+	return arena->used;
+}
+
+// Pool
+
+typedef struct PoolBlock {
+	struct PoolBlock *next;
+} PoolBlock;
+
+#define POOL_BLOCK_HEADER_SIZE LS_MEMORY_ALIGN(sizeof(PoolBlock))
+
+typedef struct PoolSlot {
+	struct PoolSlot *next;
+} PoolSlot;
+
+struct LSPool {
+	size_t element_size;
+	size_t elements_per_block;
+
+	PoolBlock *blocks;
+	PoolSlot *free_list;
+
+	size_t count;
+};
+
+LSPool *ls_pool_create(size_t element_size, size_t elements_per_block) {
+	LS_ASSERT(element_size > 0);
+	LS_ASSERT(elements_per_block > 0);
+
+	LSPool *pool = ls_malloc(sizeof(LSPool));
+	pool->element_size = LS_MEMORY_ALIGN(element_size);
+	pool->elements_per_block = elements_per_block;
+	pool->blocks = NULL;
+	pool->free_list = NULL;
+	pool->count = 0;
+
+	return pool;
+}
+
+void ls_pool_destroy(LSPool *pool) {
+	LS_ASSERT(pool);
+
+	PoolBlock *block = pool->blocks;
+	while (block) {
+		PoolBlock *next = block->next;
+		ls_free(block);
+		block = next;
+	}
+
+	ls_free(pool);
+}
+
+static bool pool_grow(LSPool *pool) {
+	PoolBlock *block = ls_malloc(POOL_BLOCK_HEADER_SIZE + pool->element_size * pool->elements_per_block);
+	if (!block) {
+		return false;
+	}
+
+	block->next = pool->blocks;
+	pool->blocks = block;
+
+	// Thread the new slots onto the free list in address order
+	uint8 *data = (uint8 *)block + POOL_BLOCK_HEADER_SIZE;
+	for (size_t i = pool->elements_per_block; i > 0; i--) {
+		PoolSlot *slot = (PoolSlot *)(data + (i - 1) * pool->element_size);
+		slot->next = pool->free_list;
+		pool->free_list = slot;
+	}
+
+	return true;
+}
+
+void *ls_pool_alloc(LSPool *pool) {
+	LS_ASSERT(pool);
+
+	if (!pool->free_list && !pool_grow(pool)) {
+		return NULL;
+	}
+
+	PoolSlot *slot = pool->free_list;
+	pool->free_list = slot->next;
+	pool->count++;
+
+	return slot;
+}
+
+void ls_pool_free(LSPool *pool, void *ptr) {
+	LS_ASSERT(pool);
+
+	if (!ptr) {
+		return;
+	}
+
+	LS_ASSERT(pool->count > 0);
+
+	PoolSlot *slot = ptr;
+	slot->next = pool->free_list;
+	pool->free_list = slot;
+	pool->count--;
+}
+
+size_t ls_pool_get_element_size(const LSPool *pool) {
+	LS_ASSERT(pool);
+
+	return pool->element_size;
+}
+
+size_t ls_pool_get_count(const LSPool *pool) {
+	LS_ASSERT(pool);
+
+	return pool->count;
+}
+
+// Frame scratch
+
+static LSArena *frame_arena = NULL;
+
+void *ls_frame_alloc(size_t size) {
+	if (!frame_arena) {
+		frame_arena = ls_arena_create(FRAME_ARENA_BLOCK_SIZE);
+	}
+
+	return ls_arena_alloc(frame_arena, size);
+}
+
+void *ls_frame_calloc(size_t count, size_t size) {
+	if (!frame_arena) {
+		frame_arena = ls_arena_create(FRAME_ARENA_BLOCK_SIZE);
+	}
+
+	return ls_arena_calloc(frame_arena, count, size);
+}
+
+void ls_frame_reset() {
+	if (frame_arena) {
+		ls_arena_reset(frame_arena);
+	}
+}
+
+size_t ls_frame_get_used() {
+	return frame_arena ? ls_arena_get_used(frame_arena) : 0;
+}
+
+void ls_memory_deinit() {
+	if (frame_arena) {
+		ls_arena_destroy(frame_arena);
+		frame_arena = NULL;
+	}
 }
\ No newline at end of file
@@ -4,10 +4,33 @@
 #include "core/api.h"
 #include "core/types/typedefs.h"
 
+// Every ls_malloc family call goes through the active allocator.
+typedef struct {
+	const char *name;
+
+	void *(*malloc)(size_t size, void *user_data);
+	void *(*calloc)(size_t count, size_t size, void *user_data);
+	void *(*realloc)(void *ptr, size_t size, void *user_data);
+	void (*free)(void *ptr, void *user_data);
+
+	void *user_data;
+} LSAllocator;
+
+// The C runtime heap, the default.
+LS_EXPORT const LSAllocator *ls_get_system_allocator();
+// Bump allocates from large blocks and never frees. Only useful to measure allocation cost in benchmarks.
+LS_EXPORT const LSAllocator *ls_get_bump_allocator();
+// Returns the built in allocator called name, or NULL.
+LS_EXPORT const LSAllocator *ls_find_allocator(const char *name);
+
+// Allocations must be freed by the allocator that made them, so the allocator can only be replaced
+// before the first allocation. Returns false if anything was already allocated.
+LS_EXPORT bool ls_set_allocator(const LSAllocator *allocator);
+LS_EXPORT const LSAllocator *ls_get_allocator();
+
 LS_EXPORT void *ls_malloc(size_t size);
 LS_EXPORT void *ls_realloc(void *ptr, size_t size);
 LS_EXPORT void *ls_calloc(size_t count, size_t size);
-LS_EXPORT void *ls_alloca(size_t size);
 
 LS_EXPORT void ls_memcpy(void *dest, const void *src, size_t size);
 LS_EXPORT void ls_memset(void *dest, int value, size_t size);
@@ -15,4 +38,99 @@ LS_EXPORT void ls_memmove(void *dest, const void *src, size_t size);
 
 LS_EXPORT void ls_free(void *ptr);
 
+// Allocation tracking, recorded in builds with memory_tracking=yes (MEMORY_TRACKING_ENABLED).
+// ls_malloc, ls_calloc and ls_realloc then record their call site. Other builds return zeroed stats.
+
+typedef struct {
+	size_t live_bytes;
+	size_t live_count;
+	size_t peak_bytes;
+
+	size_t total_bytes;
+	size_t total_count;
+
+	// Allocations during the last completed frame
+	size_t frame_bytes;
+	size_t frame_count;
+	size_t peak_frame_count;
+
+	uint64 frames;
+} LSMemoryStats;
+
+typedef struct {
+	const char *file;
+	int32 line;
+	// Subsystem the call site belongs to, taken from its path, e.g. "renderer" or "modules/ui"
+	char tag[32];
+
+	size_t live_bytes;
+	size_t live_count;
+
+	size_t total_bytes;
+	size_t total_count;
+
+	size_t frame_bytes;
+	size_t frame_count;
+} LSMemorySiteStats;
+
+LS_EXPORT void *ls_malloc_at(size_t size, const char *file, int32 line);
+LS_EXPORT void *ls_calloc_at(size_t count, size_t size, const char *file, int32 line);
+LS_EXPORT void *ls_realloc_at(void *ptr, size_t size, const char *file, int32 line);
+
+LS_EXPORT bool ls_memory_is_tracking();
+LS_EXPORT LSMemoryStats ls_memory_get_stats();
+// Number of call sites that allocated so far, sites are indexed 0 to count - 1.
+LS_EXPORT size_t ls_memory_get_site_count();
+LS_EXPORT bool ls_memory_get_site(size_t index, LSMemorySiteStats *stats);
+// Closes the frame counters, called by batch_renderer_end_frame.
+LS_EXPORT void ls_memory_end_frame();
+// Logs a warning for every frame that allocates more than max_allocations times. Negative disables it.
+LS_EXPORT void ls_memory_set_frame_budget(int32 max_allocations);
+// Writes totals, per tag and per call site stats to path as text.
+LS_EXPORT bool ls_memory_dump(const char *path);
+
+#if defined(MEMORY_TRACKING_ENABLED)
+#define ls_malloc(size) ls_malloc_at(size, __FILE__, __LINE__)
+#define ls_calloc(count, size) ls_calloc_at(count, size, __FILE__, __LINE__)
+#define ls_realloc(ptr, size) ls_realloc_at(ptr, size, __FILE__, __LINE__)
+#endif // MEMORY_TRACKING_ENABLED
+
+// Linear allocator. Allocations are freed all at once by ls_arena_reset or ls_arena_destroy.
+// After a reset the arena keeps a single block large enough for everything allocated before it,
+// so a steady per frame workload stops allocating after the first frame.
+typedef struct LSArena LSArena;
+
+LS_EXPORT LSArena *ls_arena_create(size_t block_size);
+LS_EXPORT void ls_arena_destroy(LSArena *arena);
+// Returns memory aligned for any type, valid until the next reset.
+LS_EXPORT void *ls_arena_alloc(LSArena *arena, size_t size);
+LS_EXPORT void *ls_arena_calloc(LSArena *arena, size_t count, size_t size);
+LS_EXPORT char *ls_arena_str_copy(LSArena *arena, const char *string, size_t length);
+LS_EXPORT void ls_arena_reset(LSArena *arena);
+// Bytes handed out since the last reset.
+LS_EXPORT size_t ls_arena_get_used(const LSArena *arena);
+
+// Fixed size object pool. Freed elements are reused before new blocks are allocated,
+// blocks are only returned when the pool is destroyed.
+typedef struct LSPool LSPool;
+
+LS_EXPORT LSPool *ls_pool_create(size_t element_size, size_t elements_per_block);
+LS_EXPORT void ls_pool_destroy(LSPool *pool);
+// Returns NULL when a new block can not be allocated.
+LS_EXPORT void *ls_pool_alloc(LSPool *pool);
+LS_EXPORT void ls_pool_free(LSPool *pool, void *ptr);
+LS_EXPORT size_t ls_pool_get_element_size(const LSPool *pool);
+// Elements currently allocated.
+LS_EXPORT size_t ls_pool_get_count(const LSPool *pool);
+
+// Per frame scratch memory, valid until the end of the current frame. Only use it from the render loop thread.
+LS_EXPORT void *ls_frame_alloc(size_t size);
+LS_EXPORT void *ls_frame_calloc(size_t count, size_t size);
+// Releases all frame memory, called by batch_renderer_end_frame.
+LS_EXPORT void ls_frame_reset();
+LS_EXPORT size_t ls_frame_get_used();
+
+// Frees the frame scratch memory.
+void ls_memory_deinit();
+
 #endif // MEMORY_H
\ No newline at end of file
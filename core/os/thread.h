@@ -11,6 +11,30 @@ LS_EXPORT void os_mutex_destroy(LSMutex *mutex);
 LS_EXPORT void os_mutex_lock(LSMutex *mutex);
 LS_EXPORT void os_mutex_unlock(LSMutex *mutex);
 
+typedef struct LSCond LSCond;
+
+LS_EXPORT LSCond *os_cond_create();
+LS_EXPORT void os_cond_destroy(LSCond *cond);
+
+// Atomically unlocks the mutex and waits for a signal, the mutex is locked again before returning.
+// Wakeups can be spurious, always wait in a loop checking the condition.
+LS_EXPORT void os_cond_wait(LSCond *cond, LSMutex *mutex);
+// Wakes one waiting thread.
+LS_EXPORT void os_cond_signal(LSCond *cond);
+// Wakes all waiting threads.
+LS_EXPORT void os_cond_broadcast(LSCond *cond);
+
+typedef struct LSSemaphore LSSemaphore;
+
+// Creates a semaphore with a count of 0.
+LS_EXPORT LSSemaphore *os_semaphore_create();
+LS_EXPORT void os_semaphore_destroy(LSSemaphore *semaphore);
+
+// Waits until the count is above 0, then decrements it.
+LS_EXPORT void os_semaphore_wait(LSSemaphore *semaphore);
+// Increments the count and wakes a waiting thread. Does not take a lock, safe to call from real time threads.
+LS_EXPORT void os_semaphore_post(LSSemaphore *semaphore);
+
 typedef struct LSThread LSThread;
 
 typedef void (*LSThreadFunction)(void *data);
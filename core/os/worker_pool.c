@@ -0,0 +1,131 @@
+#include "core/os/worker_pool.h"
+
+#include "core/debug.h"
+#include "core/memory.h"
+#include "core/os/thread.h"
+
+typedef struct WorkerJob {
+	WorkerJobFunction function;
+	void *data;
+
+	struct WorkerJob *next;
+} WorkerJob;
+
+struct WorkerPool {
+	LSThread **threads;
+	uint32 thread_count;
+
+	LSMutex *mutex;
+	LSCond *cond;
+
+	WorkerJob *head;
+	WorkerJob *tail;
+	uint32 pending;
+
+	bool stopping;
+};
+
+static void worker_pool_thread(void *data) {
+	WorkerPool *pool = data;
+
+	os_mutex_lock(pool->mutex);
+	while (true) {
+		while (!pool->head && !pool->stopping) {
+			os_cond_wait(pool->cond, pool->mutex);
+		}
+
+		// Queued jobs are still run when stopping
+		if (!pool->head) {
+			break;
+		}
+
+		WorkerJob *job = pool->head;
+		pool->head = job->next;
+		if (!pool->head) {
+			pool->tail = NULL;
+		}
+		os_mutex_unlock(pool->mutex);
+
+		job->function(job->data);
+		ls_free(job);
+
+		os_mutex_lock(pool->mutex);
+		pool->pending--;
+	}
+	os_mutex_unlock(pool->mutex);
+}
+
+WorkerPool *worker_pool_create(uint32 thread_count) {
+	LS_ASSERT(thread_count > 0);
+
+	WorkerPool *pool = ls_calloc(1, sizeof(WorkerPool));
+	pool->mutex = os_mutex_create();
+	pool->cond = os_cond_create();
+
+	pool->thread_count = thread_count;
+	pool->threads = ls_malloc(thread_count * sizeof(LSThread *));
+	for (uint32 i = 0; i < thread_count; i++) {
+		pool->threads[i] = os_thread_create(worker_pool_thread, pool);
+	}
+
+	return pool;
+}
+
+void worker_pool_destroy(WorkerPool *pool) {
+	LS_ASSERT(pool);
+
+	os_mutex_lock(pool->mutex);
+	pool->stopping = true;
+	os_cond_broadcast(pool->cond);
+	os_mutex_unlock(pool->mutex);
+
+	for (uint32 i = 0; i < pool->thread_count; i++) {
+		os_thread_join(pool->threads[i]);
+		os_thread_destroy(pool->threads[i]);
+	}
+
+	os_cond_destroy(pool->cond);
+	os_mutex_destroy(pool->mutex);
+	ls_free(pool->threads);
+	ls_free(pool);
+}
+
+void worker_pool_submit(WorkerPool *pool, WorkerJobFunction function, void *data) {
+	LS_ASSERT(pool);
+	LS_ASSERT(function);
+
+	WorkerJob *job = ls_malloc(sizeof(WorkerJob));
+	job->function = function;
+	job->data = data;
+	job->next = NULL;
+
+	os_mutex_lock(pool->mutex);
+	LS_ASSERT_MSG(!pool->stopping, "%s", "Job submitted to a stopping worker pool");
+
+	if (pool->tail) {
+		pool->tail->next = job;
+	} else {
+		pool->head = job;
+	}
+	pool->tail = job;
+	pool->pending++;
+
+	os_cond_signal(pool->cond);
+	os_mutex_unlock(pool->mutex);
+}
+
+uint32 worker_pool_get_pending_count(WorkerPool *pool) {
+	LS_ASSERT(pool);
+
+	os_mutex_lock(pool->mutex);
+	uint32 pending = pool->pending;
+	os_mutex_unlock(pool->mutex);
+
+	return pending;
+}
+
+uint32 worker_pool_get_thread_count(const WorkerPool *pool) {
+	LS_ASSERT(pool);
+
+	return pool->thread_count;
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include "core/api.h"
+#include "core/types/typedefs.h"
+
+// A fixed set of threads running jobs in submission order.
+typedef struct WorkerPool WorkerPool;
+
+typedef void (*WorkerJobFunction)(void *data);
+
+LS_EXPORT WorkerPool *worker_pool_create(uint32 thread_count);
+// Runs every job still queued, then joins the threads.
+LS_EXPORT void worker_pool_destroy(WorkerPool *pool);
+
+// Queues a job, it runs on one of the pool threads. Safe to call from any thread.
+LS_EXPORT void worker_pool_submit(WorkerPool *pool, WorkerJobFunction function, void *data);
+
+// Returns the number of jobs queued or running.
+LS_EXPORT uint32 worker_pool_get_pending_count(WorkerPool *pool);
+LS_EXPORT uint32 worker_pool_get_thread_count(const WorkerPool *pool);
+
+#endif // WORKER_POOL_H
\ No newline at end of file
@@ -0,0 +1,500 @@
+#include "core/profiler.h"
+
+#include "core/debug.h"
+#include "core/log.h"
+#include "core/memory.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/types/array.h"
+#include "core/types/string.h"
+
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdio.h>
+
+#define PROFILER_MAX_DEPTH 64
+#define PROFILER_MAX_THREADS 32
+#define PROFILER_MAX_REALTIME_THREADS 4
+// Zones a real time thread can record between two profiler_end_frame calls, a power of two.
+#define PROFILER_REALTIME_ZONES 256
+// Marks an open zone that was begun while the profiler was disabled.
+#define PROFILER_NO_ZONE 0xFFFFFFFFu
+// Marks an open zone of a real time thread, kept in its ring until it ends.
+#define PROFILER_REALTIME_ZONE 0xFFFFFFFEu
+
+LS_ARRAY_DEFINE(ProfilerZoneArray, profiler_zone_array, ProfilerZone)
+
+typedef struct {
+	ProfilerZoneArray zones;
+	uint64 index;
+	uint64 start;
+	uint64 end;
+} ProfilerFrame;
+
+static struct {
+	bool enabled;
+	LSMutex *mutex;
+
+	ProfilerFrame *frames;
+	uint32 nframes;
+	// Frame in progress, the ring slot is index % nframes
+	uint64 frame_index;
+	// Thread that ends frames
+	uint32 frame_thread;
+
+	uint32 nthreads;
+	const char *thread_names[PROFILER_MAX_THREADS];
+
+	FlagValue *enabled_flag;
+	FlagValue *frames_flag;
+	FlagValue *trace_flag;
+} profiler = { 0 };
+
+// Single producer ring of a real time thread. The thread pushes finished zones without locking or
+// allocating, profiler_end_frame drains them into the frame under the mutex.
+typedef struct {
+	atomic_bool registered;
+	const char *name;
+	// Assigned by the draining thread, 0 until the ring is first drained
+	uint32 thread;
+
+	// Open zones, only touched by the owning thread
+	const char *open_names[PROFILER_MAX_DEPTH];
+	uint64 open_starts[PROFILER_MAX_DEPTH];
+
+	atomic_uint head;
+	atomic_uint tail;
+	ProfilerZone zones[PROFILER_REALTIME_ZONES];
+} ProfilerRealtimeRing;
+
+static ProfilerRealtimeRing profiler_realtime[PROFILER_MAX_REALTIME_THREADS];
+static atomic_uint profiler_realtime_count = 0;
+
+// Open zones of the calling thread, remembered as frame and zone index so they can be closed after
+// their frame was rotated out of the ring slot in progress.
+static _Thread_local struct {
+	uint32 id;
+	uint32 depth;
+	uint32 zones[PROFILER_MAX_DEPTH];
+	uint64 frames[PROFILER_MAX_DEPTH];
+
+	// Set by profiler_set_thread_realtime, ring is NULL when every ring was taken and zones are dropped
+	bool realtime;
+	ProfilerRealtimeRing *ring;
+} profiler_thread = { 0 };
+
+void profiler_register_flags(FlagManager *flag_manager) {
+	profiler.enabled_flag = flag_manager_register(flag_manager, "profile", FLAG_TYPE_BOOL, FLAG_VAL(b, false),
+			"Record profiler zones from startup.");
+	profiler.frames_flag = flag_manager_register(flag_manager, "profile-frames", FLAG_TYPE_INT, FLAG_VAL(i32, 120),
+			"Number of frames the profiler keeps.");
+	profiler.trace_flag = flag_manager_register(flag_manager, "profile-trace", FLAG_TYPE_STRING, FLAG_VAL(str, ""),
+			"Write the profiled frames to this file as a Chrome trace on exit. Implies --profile.");
+}
+
+void profiler_init() {
+	LS_ASSERT(profiler.frames_flag);
+
+	int32 nframes = profiler.frames_flag->i32;
+	if (nframes < 2) {
+		ls_log(LOG_LEVEL_WARNING, "Profiler needs at least 2 frames, got %d.\n", nframes);
+		nframes = 2;
+	}
+
+	profiler.mutex = os_mutex_create();
+	profiler.nframes = nframes;
+	profiler.frames = ls_calloc(profiler.nframes, sizeof(ProfilerFrame));
+	profiler.frame_index = 0;
+	profiler.frames[0].start = os_get_time();
+
+	profiler.nthreads = PROFILER_GPU_THREAD + 1;
+	profiler.thread_names[PROFILER_GPU_THREAD] = "GPU";
+	for (uint32 i = 0; i < PROFILER_MAX_REALTIME_THREADS; i++) {
+		profiler_realtime[i].thread = 0;
+	}
+
+	profiler.enabled = profiler.enabled_flag->b || profiler.trace_flag->str[0] != '\0';
+}
+
+void profiler_deinit() {
+	if (!profiler.frames) {
+		return;
+	}
+
+	if (profiler.trace_flag && profiler.trace_flag->str[0] != '\0') {
+		if (profiler_export_chrome_trace(profiler.trace_flag->str)) {
+			ls_log(LOG_LEVEL_INFO, "Wrote profiler trace to %s.\n", profiler.trace_flag->str);
+		}
+	}
+
+	profiler.enabled = false;
+
+	for (uint32 i = 0; i < profiler.nframes; i++) {
+		profiler_zone_array_destroy(&profiler.frames[i].zones);
+	}
+	ls_free(profiler.frames);
+	profiler.frames = NULL;
+
+	os_mutex_destroy(profiler.mutex);
+	profiler.mutex = NULL;
+}
+
+void profiler_set_enabled(bool enabled) {
+	// Zones begun while disabled are never recorded, so there is nothing to fix up when toggling
+	profiler.enabled = enabled && profiler.frames != NULL;
+}
+
+bool profiler_is_enabled() {
+	return profiler.enabled;
+}
+
+// Must hold the mutex.
+static uint32 profiler_new_thread_id() {
+	return profiler.nthreads < PROFILER_MAX_THREADS ? profiler.nthreads++ : PROFILER_MAX_THREADS - 1;
+}
+
+// Must hold the mutex.
+static uint32 profiler_thread_id() {
+	if (!profiler_thread.id) {
+		profiler_thread.id = profiler_new_thread_id();
+	}
+
+	return profiler_thread.id;
+}
+
+void profiler_set_thread_name(const char *name) {
+	if (!profiler.frames) {
+		return;
+	}
+
+	os_mutex_lock(profiler.mutex);
+	profiler.thread_names[profiler_thread_id()] = name;
+	os_mutex_unlock(profiler.mutex);
+}
+
+void profiler_set_thread_realtime(const char *name) {
+	if (profiler_thread.realtime) {
+		return;
+	}
+
+	profiler_thread.realtime = true;
+	uint32 slot = atomic_fetch_add(&profiler_realtime_count, 1);
+	if (slot >= PROFILER_MAX_REALTIME_THREADS) {
+		return;
+	}
+
+	ProfilerRealtimeRing *ring = &profiler_realtime[slot];
+	ring->name = name;
+	atomic_store_explicit(&ring->registered, true, memory_order_release);
+	profiler_thread.ring = ring;
+}
+
+static void profiler_realtime_push(ProfilerRealtimeRing *ring, const char *name, uint64 start, uint64 end, uint32 depth) {
+	uint32 head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	uint32 tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+	// Full when frames stop being ended, the zone is dropped rather than waiting
+	if (head - tail >= PROFILER_REALTIME_ZONES) {
+		return;
+	}
+
+	ring->zones[head % PROFILER_REALTIME_ZONES] = (ProfilerZone){
+		.name = name,
+		.start = start,
+		.duration = end - start,
+		.thread = 0,
+		.depth = depth,
+	};
+	atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+_FORCE_INLINE_ ProfilerFrame *profiler_current_frame() {
+	return &profiler.frames[profiler.frame_index % profiler.nframes];
+}
+
+void profiler_begin_zone(const char *name) {
+	uint32 depth = profiler_thread.depth++;
+	if (depth >= PROFILER_MAX_DEPTH) {
+		return;
+	}
+
+	profiler_thread.zones[depth] = PROFILER_NO_ZONE;
+	if (!profiler.enabled) {
+		return;
+	}
+
+	if (profiler_thread.realtime) {
+		ProfilerRealtimeRing *ring = profiler_thread.ring;
+		if (ring) {
+			ring->open_names[depth] = name;
+			ring->open_starts[depth] = os_get_time();
+			profiler_thread.zones[depth] = PROFILER_REALTIME_ZONE;
+		}
+		return;
+	}
+
+	uint64 start = os_get_time();
+
+	os_mutex_lock(profiler.mutex);
+
+	ProfilerFrame *frame = profiler_current_frame();
+	ProfilerZone zone = {
+		.name = name,
+		.start = start,
+		.duration = 0,
+		.thread = profiler_thread_id(),
+		.depth = depth,
+	};
+	profiler_zone_array_append(&frame->zones, zone);
+
+	profiler_thread.zones[depth] = (uint32)frame->zones.size - 1;
+	profiler_thread.frames[depth] = profiler.frame_index;
+
+	os_mutex_unlock(profiler.mutex);
+}
+
+void profiler_end_zone() {
+	LS_ASSERT_MSG(profiler_thread.depth > 0, "%s", "profiler_end_zone without a matching profiler_begin_zone");
+	if (profiler_thread.depth == 0) {
+		return;
+	}
+
+	uint32 depth = --profiler_thread.depth;
+	if (depth >= PROFILER_MAX_DEPTH || profiler_thread.zones[depth] == PROFILER_NO_ZONE || !profiler.frames) {
+		return;
+	}
+
+	uint64 end = os_get_time();
+
+	if (profiler_thread.zones[depth] == PROFILER_REALTIME_ZONE) {
+		ProfilerRealtimeRing *ring = profiler_thread.ring;
+		profiler_realtime_push(ring, ring->open_names[depth], ring->open_starts[depth], end, depth);
+		return;
+	}
+
+	os_mutex_lock(profiler.mutex);
+
+	// The frame the zone began in may already have been overwritten
+	uint64 frame_index = profiler_thread.frames[depth];
+	ProfilerFrame *frame = &profiler.frames[frame_index % profiler.nframes];
+	if (frame->index == frame_index && profiler_thread.zones[depth] < frame->zones.size) {
+		ProfilerZone *zone = &frame->zones.data[profiler_thread.zones[depth]];
+		zone->duration = end - zone->start;
+	}
+
+	os_mutex_unlock(profiler.mutex);
+}
+
+void profiler_add_zone(const char *name, uint32 thread, uint64 start, uint64 end) {
+	if (!profiler.enabled) {
+		return;
+	}
+
+	os_mutex_lock(profiler.mutex);
+
+	ProfilerZone zone = {
+		.name = name,
+		.start = start,
+		.duration = end > start ? end - start : 0,
+		.thread = thread,
+		.depth = 0,
+	};
+	profiler_zone_array_append(&profiler_current_frame()->zones, zone);
+
+	os_mutex_unlock(profiler.mutex);
+}
+
+// Must hold the mutex.
+static void profiler_drain_realtime(ProfilerFrame *frame) {
+	for (uint32 i = 0; i < PROFILER_MAX_REALTIME_THREADS; i++) {
+		ProfilerRealtimeRing *ring = &profiler_realtime[i];
+		if (!atomic_load_explicit(&ring->registered, memory_order_acquire)) {
+			continue;
+		}
+
+		if (!ring->thread) {
+			ring->thread = profiler_new_thread_id();
+			profiler.thread_names[ring->thread] = ring->name;
+		}
+
+		uint32 head = atomic_load_explicit(&ring->head, memory_order_acquire);
+		uint32 tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+		for (; tail != head; tail++) {
+			ProfilerZone zone = ring->zones[tail % PROFILER_REALTIME_ZONES];
+			zone.thread = ring->thread;
+			profiler_zone_array_append(&frame->zones, zone);
+		}
+		atomic_store_explicit(&ring->tail, tail, memory_order_release);
+	}
+}
+
+void profiler_end_frame() {
+	if (!profiler.frames) {
+		return;
+	}
+
+	uint64 now = os_get_time();
+
+	os_mutex_lock(profiler.mutex);
+
+	profiler.frame_thread = profiler_thread_id();
+	profiler_drain_realtime(profiler_current_frame());
+	profiler_current_frame()->end = now;
+
+	profiler.frame_index++;
+	ProfilerFrame *frame = profiler_current_frame();
+	profiler_zone_array_clear(&frame->zones);
+	frame->index = profiler.frame_index;
+	frame->start = now;
+	frame->end = 0;
+
+	os_mutex_unlock(profiler.mutex);
+}
+
+uint32 profiler_get_frame_count() {
+	if (!profiler.frames) {
+		return 0;
+	}
+
+	uint64 completed = profiler.frame_index;
+	return completed < profiler.nframes - 1 ? (uint32)completed : profiler.nframes - 1;
+}
+
+// Must hold the mutex.
+static ProfilerFrame *profiler_get_completed_frame(uint32 age) {
+	if (age >= profiler_get_frame_count()) {
+		return NULL;
+	}
+
+	return &profiler.frames[(profiler.frame_index - 1 - age) % profiler.nframes];
+}
+
+uint64 profiler_get_frame_time(uint32 age) {
+	if (!profiler.frames) {
+		return 0;
+	}
+
+	os_mutex_lock(profiler.mutex);
+	ProfilerFrame *frame = profiler_get_completed_frame(age);
+	uint64 time = frame ? frame->end - frame->start : 0;
+	os_mutex_unlock(profiler.mutex);
+
+	return time;
+}
+
+size_t profiler_get_frame_zones(uint32 age, ProfilerZone *zones, size_t max_zones) {
+	if (!profiler.frames) {
+		return 0;
+	}
+
+	os_mutex_lock(profiler.mutex);
+
+	size_t count = 0;
+	ProfilerFrame *frame = profiler_get_completed_frame(age);
+	if (frame) {
+		count = frame->zones.size < max_zones ? frame->zones.size : max_zones;
+		ls_memcpy(zones, frame->zones.data, count * sizeof(ProfilerZone));
+	}
+
+	os_mutex_unlock(profiler.mutex);
+
+	return count;
+}
+
+uint64 profiler_get_zone_time(const char *name) {
+	if (!profiler.frames) {
+		return 0;
+	}
+
+	os_mutex_lock(profiler.mutex);
+
+	uint64 time = 0;
+	ProfilerFrame *frame = profiler_get_completed_frame(0);
+	if (frame) {
+		for (size_t i = 0; i < frame->zones.size; i++) {
+			const ProfilerZone *zone = &frame->zones.data[i];
+			if (zone->name == name || ls_str_equals(zone->name, name)) {
+				time += zone->duration;
+			}
+		}
+	}
+
+	os_mutex_unlock(profiler.mutex);
+
+	return time;
+}
+
+static void profiler_write(LSFile file, const char *format, ...) {
+	char line[512];
+
+	va_list args;
+	va_start(args, format);
+	int32 length = vsnprintf(line, sizeof(line), format, args);
+	va_end(args);
+
+	if (length > 0) {
+		os_write_file_data(file, line, (size_t)length < sizeof(line) ? (size_t)length : sizeof(line) - 1);
+	}
+}
+
+// Copies name into buffer with the characters JSON needs escaped replaced.
+static const char *profiler_json_name(const char *name, char *buffer, size_t size) {
+	size_t length = 0;
+	for (const char *c = name ? name : "?"; *c && length < size - 1; c++) {
+		buffer[length++] = (*c == '"' || *c == '\\' || (uint8)*c < 0x20) ? '_' : *c;
+	}
+	buffer[length] = '\0';
+
+	return buffer;
+}
+
+bool profiler_export_chrome_trace(const char *path) {
+	LS_ASSERT(path);
+
+	if (!profiler.frames) {
+		ls_log(LOG_LEVEL_WARNING, "Profiler is not initialized, nothing to export.\n");
+		return false;
+	}
+
+	LSFile file = os_open_file(path, "w");
+	if (!file) {
+		ls_log(LOG_LEVEL_ERROR, "Failed to open profiler trace file %s\n", path);
+		return false;
+	}
+
+	os_mutex_lock(profiler.mutex);
+
+	char name[128];
+	profiler_write(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	profiler_write(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Lunar Sprites\"}}");
+
+	for (uint32 i = 1; i < profiler.nthreads; i++) {
+		if (profiler.thread_names[i]) {
+			profiler_write(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+					i, profiler_json_name(profiler.thread_names[i], name, sizeof(name)));
+		}
+	}
+
+	// Oldest frame first, the frame in progress is left out
+	uint32 nframes = profiler_get_frame_count();
+	for (uint32 age = nframes; age > 0; age--) {
+		const ProfilerFrame *frame = profiler_get_completed_frame(age - 1);
+
+		profiler_write(file, ",\n{\"name\":\"Frame %llu\",\"cat\":\"frame\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%llu,\"pid\":1,\"tid\":%u}",
+				frame->index, frame->start, frame->end - frame->start, profiler.frame_thread);
+
+		for (size_t i = 0; i < frame->zones.size; i++) {
+			const ProfilerZone *zone = &frame->zones.data[i];
+			profiler_write(file, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%llu,\"pid\":1,\"tid\":%u}",
+					profiler_json_name(zone->name, name, sizeof(name)), zone->thread == PROFILER_GPU_THREAD ? "gpu" : "cpu",
+					zone->start, zone->duration, zone->thread);
+		}
+	}
+
+	profiler_write(file, "\n]}\n");
+
+	os_mutex_unlock(profiler.mutex);
+
+	os_close_file(file);
+
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "core/api.h"
+#include "core/flags.h"
+#include "core/types/typedefs.h"
+
+// Frame profiler. Zones are recorded per thread into a ring of the last frames and can be exported
+// in the Chrome trace format (chrome://tracing, Perfetto). Times are in microseconds of os_get_time.
+// While disabled, beginning and ending a zone only touches a thread local counter.
+
+// Thread id used for zones measured on the GPU.
+#define PROFILER_GPU_THREAD 1
+
+typedef struct {
+	const char *name;
+	uint64 start;
+	uint64 duration;
+	uint32 thread;
+	uint32 depth;
+} ProfilerZone;
+
+// Registers --profile, --profile-frames and --profile-trace.
+void profiler_register_flags(FlagManager *flag_manager);
+void profiler_init();
+// Writes the --profile-trace file if one was requested and frees the frames.
+void profiler_deinit();
+
+LS_EXPORT void profiler_set_enabled(bool enabled);
+LS_EXPORT bool profiler_is_enabled();
+
+// Names the calling thread in exported traces. name must outlive the profiler.
+LS_EXPORT void profiler_set_thread_name(const char *name);
+// Names the calling thread and records its zones into a preallocated ring without locking, drained by
+// profiler_end_frame. Call it first on threads that must not block, such as the audio callback.
+LS_EXPORT void profiler_set_thread_realtime(const char *name);
+
+// Zones nest per thread and must be ended on the thread that began them.
+// While enabled these lock and may grow the frame unless the thread is set real time.
+// name must stay valid until the zone leaves the ring, use string literals or ls_str_intern.
+LS_EXPORT void profiler_begin_zone(const char *name);
+LS_EXPORT void profiler_end_zone();
+// Adds a zone measured elsewhere, e.g. by GPU timer queries, to the frame in progress.
+LS_EXPORT void profiler_add_zone(const char *name, uint32 thread, uint64 start, uint64 end);
+
+// Closes the frame in progress, called by the render loop once per frame.
+LS_EXPORT void profiler_end_frame();
+
+// Number of completed frames held in the ring.
+LS_EXPORT uint32 profiler_get_frame_count();
+// Duration in microseconds of a completed frame, age 0 is the last one.
+LS_EXPORT uint64 profiler_get_frame_time(uint32 age);
+// Copies up to max_zones zones of a completed frame and returns how many were copied.
+LS_EXPORT size_t profiler_get_frame_zones(uint32 age, ProfilerZone *zones, size_t max_zones);
+// Total microseconds spent in zones called name during the last completed frame.
+LS_EXPORT uint64 profiler_get_zone_time(const char *name);
+
+// Writes every frame in the ring as Chrome trace JSON.
+LS_EXPORT bool profiler_export_chrome_trace(const char *path);
+
+#define LS_PROFILE_BEGIN(name) profiler_begin_zone(name)
+#define LS_PROFILE_END() profiler_end_zone()
+// Profiles the statement or block that follows. Leaving it with return, break or goto skips the end of the zone.
+#define LS_PROFILE_SCOPE(name) \
+	for (int32 _profile_scope = (profiler_begin_zone(name), 1); _profile_scope; _profile_scope = (profiler_end_zone(), 0))
+
+#endif // PROFILER_H
\ No newline at end of file
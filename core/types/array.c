@@ -0,0 +1,11 @@
+#include "core/types/array.h"
+
+void *ls_array_grow(void *data, size_t *capacity, size_t min_capacity, size_t element_size) {
+	size_t new_capacity = *capacity ? *capacity * 2 : 8;
+	if (new_capacity < min_capacity) {
+		new_capacity = min_capacity;
+	}
+
+	*capacity = new_capacity;
+	return ls_realloc(data, new_capacity * element_size);
+}
\ No newline at end of file
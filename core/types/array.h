@@ -0,0 +1,117 @@
+#ifndef ARRAY_H
+#define ARRAY_H
+
+#include "core/api.h"
+#include "core/debug.h"
+#include "core/memory.h"
+#include "core/types/typedefs.h"
+
+// Returns data reallocated to hold at least min_capacity elements, at least doubling *capacity.
+LS_EXPORT void *ls_array_grow(void *data, size_t *capacity, size_t min_capacity, size_t element_size);
+
+// Defines the typed dynamic array `name` and its prefix_* functions.
+// Elements are stored unboxed and moved with memcpy/memmove. Arrays are plain values, a zeroed array
+// is empty and valid. Element access is only bounds checked in debug builds, data can be indexed directly.
+#define LS_ARRAY_DEFINE(name, prefix, type)                                                             \
+	typedef struct {                                                                                    \
+		type *data;                                                                                     \
+		size_t size;                                                                                    \
+		size_t capacity;                                                                                \
+	} name;                                                                                             \
+                                                                                                        \
+	_FORCE_INLINE_ void prefix##_init(name *array, size_t capacity) {                                   \
+		array->data = capacity ? ls_malloc(capacity * sizeof(type)) : NULL;                             \
+		array->size = 0;                                                                                \
+		array->capacity = capacity;                                                                     \
+	}                                                                                                   \
+                                                                                                        \
+	_FORCE_INLINE_ void prefix##_destroy(name *array) {                                                 \
+		ls_free(array->data);                                                                           \
+		array->data = NULL;                                                                             \
+		array->size = 0;                                                                                \
+		array->capacity = 0;                                                                            \
+	}                                                                                                   \
+                                                                                                        \
+	_FORCE_INLINE_ void prefix##_reserve(name *array, size_t capacity) {                                \
+		if (capacity > array->capacity) {                                                               \
+			array->data = ls_array_grow(array->data, &array->capacity, capacity, sizeof(type));         \
+		}                                                                                               \
+	}                                                                                                   \
+                                                                                                        \
+	/* Sets the size, new elements are left uninitialized. */                                           \
+	_FORCE_INLINE_ void prefix##_resize(name *array, size_t size) {                                     \
+		prefix##_reserve(array, size);                                                                  \
+		array->size = size;                                                                             \
+	}                                                                                                   \
+                                                                                                        \
+	_FORCE_INLINE_ void prefix##_append(name *array, type value) {                                      \
+		if (array->size == array->capacity) {                                                           \
+			array->data = ls_array_grow(array->data, &array->capacity, array->size + 1, sizeof(type));  \
+		}                                                                                               \
+		array->data[array->size++] = value;                                                             \
+	}                                                                                                   \
+                                                                                                        \
+	_FORCE_INLINE_ void prefix##_append_array(name *array, const type *values, size_t count) {          \
+		prefix##_reserve(array, array->size + count);                                                   \
+		ls_memcpy(array->data + array->size, values, count * sizeof(type));                             \
+		array->size += count;                                                                           \
+	}                                                                                                   \
+                                                                                                        \
+	_FORCE_INLINE_ void prefix##_insert(name *array, size_t index, type value) {                        \
+		LS_ASSERT(index <= array->size);                                                                \
+		prefix##_reserve(array, array->size + 1);                                                       \
+		ls_memmove(array->data + index + 1, array->data + index, (array->size - index) * sizeof(type)); \
+		array->data[index] = value;                                                                     \
+		array->size++;                                                                                  \
+	}                                                                                                   \
+                                                                                                        \
+	_FORCE_INLINE_ void prefix##_remove_range(name *array, size_t index, size_t count) {                \
+		LS_ASSERT(index + count <= array->size);                                                        \
+		ls_memmove(array->data + index, array->data + index + count,                                    \
+				(array->size - index - count) * sizeof(type));                                          \
+		array->size -= count;                                                                           \
+	}                                                                                                   \
+                                                                                                        \
+	/* Keeps the order of the remaining elements. */                                                    \
+	_FORCE_INLINE_ void prefix##_remove(name *array, size_t index) {                                    \
+		prefix##_remove_range(array, index, 1);                                                         \
+	}                                                                                                   \
+                                                                                                        \
+	/* Moves the last element into index, O(1) but does not keep order. */                              \
+	_FORCE_INLINE_ void prefix##_swap_remove(name *array, size_t index) {                               \
+		LS_ASSERT(index < array->size);                                                                 \
+		array->data[index] = array->data[--array->size];                                                \
+	}                                                                                                   \
+                                                                                                        \
+	_FORCE_INLINE_ void prefix##_clear(name *array) {                                                   \
+		array->size = 0;                                                                                \
+	}                                                                                                   \
+                                                                                                        \
+	_FORCE_INLINE_ type prefix##_get(const name *array, size_t index) {                                 \
+		LS_ASSERT(index < array->size);                                                                 \
+		return array->data[index];                                                                      \
+	}                                                                                                   \
+                                                                                                        \
+	_FORCE_INLINE_ type prefix##_get_last(const name *array) {                                          \
+		LS_ASSERT(array->size > 0);                                                                     \
+		return array->data[array->size - 1];                                                            \
+	}                                                                                                   \
+                                                                                                        \
+	_FORCE_INLINE_ void prefix##_set(name *array, size_t index, type value) {                           \
+		LS_ASSERT(index < array->size);                                                                 \
+		array->data[index] = value;                                                                     \
+	}                                                                                                   \
+                                                                                                        \
+	_FORCE_INLINE_ size_t prefix##_get_size(const name *array) {                                        \
+		return array->size;                                                                             \
+	}                                                                                                   \
+                                                                                                        \
+	_FORCE_INLINE_ bool prefix##_is_empty(const name *array) {                                          \
+		return array->size == 0;                                                                        \
+	}
+
+LS_ARRAY_DEFINE(CharArray, char_array, char)
+LS_ARRAY_DEFINE(U32Array, u32_array, uint32)
+LS_ARRAY_DEFINE(PtrArray, ptr_array, void *)
+
+#endif // ARRAY_H
\ No newline at end of file
@@ -2,23 +2,29 @@
 
 #include "core/debug.h"
 
-// https://en.wikipedia.org/wiki/Universal_hashing#Hashing_integers
-#define GOLDEN_RATIO_HASH 0x9E3779B9
+// Open addressing with Robin Hood probing.
+// Entries that probed further than the one in a slot take the slot, so probe lengths stay short and
+// even, and a lookup can stop as soon as it passes an entry closer to home than the key would be.
+// Removal shifts the following entries back by one instead of leaving tombstones.
 
-typedef struct HashtableEntry {
+#define HASHTABLE_MIN_CAPACITY 8
+
+typedef struct {
 	HashtableKey key;
 	HashtableValue value;
 
-	// Used for when collisions occur
-	struct HashtableEntry *next;
+	// Full hash of the key, compared before the key and reused when growing.
+	uint32 hash;
+	// Distance from the home slot plus one, 0 marks an empty slot.
+	uint32 distance;
 } HashtableEntry;
 
 struct Hashtable {
 	size_t size;
+	// Always a power of two
 	size_t capacity;
-	size_t initial_size;
+	size_t initial_capacity;
 
-	int32 collision_count;
 	bool should_free;
 
 	HashtableKeyType key_type;
@@ -26,140 +32,164 @@ struct Hashtable {
 	HashtableEntry *entries;
 };
 
-static size_t hashtable_index(const Hashtable *hashtable, HashtableKey key) {
-	LS_ASSERT(hashtable);
+// Murmur3 finalizer, spreads the low entropy of small integer keys and djb2 over every bit.
+_FORCE_INLINE_ uint32 hashtable_mix(uint32 hash) {
+	hash ^= hash >> 16;
+	hash *= 0x85EBCA6B;
+	hash ^= hash >> 13;
+	hash *= 0xC2B2AE35;
+	hash ^= hash >> 16;
+	return hash;
+}
 
+static uint32 hashtable_hash(const Hashtable *hashtable, HashtableKey key) {
 	switch (hashtable->key_type) {
 		case HASHTABLE_KEY_INT32:
-			return (size_t)key.i32 * GOLDEN_RATIO_HASH % hashtable->capacity;
+			return hashtable_mix((uint32)key.i32);
 		case HASHTABLE_KEY_UINT32:
-			return (size_t)key.u32 * GOLDEN_RATIO_HASH % hashtable->capacity;
-		case HASHTABLE_KEY_FLOAT32:
-			return (size_t)key.f32 * GOLDEN_RATIO_HASH % hashtable->capacity;
-		case HASHTABLE_KEY_STRING:
-			return ls_str_hash_djb2(key.str) % hashtable->capacity;
+			return hashtable_mix(key.u32);
+		case HASHTABLE_KEY_ATOM:
+			return hashtable_mix(key.atom);
+		case HASHTABLE_KEY_FLOAT32: {
+			// -0.0 and 0.0 compare equal so they must hash the same
+			HashtableKey bits = { .f32 = key.f32 == 0.0f ? 0.0f : key.f32 };
+			return hashtable_mix(bits.u32);
+		}
+		case HASHTABLE_KEY_STRING: {
+			uint64 hash = ls_str_hash_djb2(key.str);
+			return hashtable_mix((uint32)(hash ^ (hash >> 32)));
+		}
 		default:
 			ls_log_fatal("Unknown hashtable key type: %d\n", hashtable->key_type);
 			return 0;
 	}
 }
 
-static void hashtable_resize(Hashtable *hashtable, size_t new_capacity) {
-	LS_ASSERT(hashtable);
-
-	HashtableEntry *old_entries = hashtable->entries;
-	size_t old_capacity = hashtable->capacity;
-
-	hashtable->capacity = new_capacity;
-	hashtable->size = 0;
-	hashtable->collision_count = 0;
-	hashtable->entries = ls_calloc(new_capacity, sizeof(HashtableEntry));
-
-	for (size_t i = 0; i < old_capacity; i++) {
-		HashtableEntry *entry = &old_entries[i];
-		if (entry->value.ptr) {
-			hashtable_set(hashtable, entry->key, entry->value);
-		}
-	}
-
-	ls_free(old_entries);
-}
-
-static void clear_childern(HashtableEntry *entry, bool should_free) {
-	HashtableEntry *next = entry->next;
-	while (next) {
-		HashtableEntry *temp = next->next;
-		if (should_free && next->value.ptr) {
-			ls_free(next->value.ptr);
-		}
-		ls_free(next);
-		next = temp;
-	}
-}
-
 static bool keys_match(HashtableKeyType key_type, HashtableKey a, HashtableKey b) {
 	switch (key_type) {
 		case HASHTABLE_KEY_INT32:
 			return a.i32 == b.i32;
 		case HASHTABLE_KEY_UINT32:
 			return a.u32 == b.u32;
+		case HASHTABLE_KEY_ATOM:
+			return a.atom == b.atom;
 		case HASHTABLE_KEY_FLOAT32:
 			return a.f32 == b.f32;
 		case HASHTABLE_KEY_STRING:
-			return ls_str_equals(a.str, b.str);
+			return a.str == b.str || ls_str_equals(a.str, b.str);
 		default:
 			ls_log_fatal("Unknown hashtable key type: %d\n", key_type);
 			return false;
 	}
 }
 
-// Will always return a valid entry. If the entry does not exist, it will be created.
-static HashtableEntry *hashtable_get_entry_create(Hashtable *hashtable, HashtableKey key) {
-	LS_ASSERT(hashtable);
-
-	const size_t index = hashtable_index(hashtable, key);
-	HashtableEntry *entry = &hashtable->entries[index];
-
-	if (!entry->key.u32 || keys_match(hashtable->key_type, entry->key, key)) {
-		return entry;
+static size_t hashtable_capacity_for(size_t size) {
+	// Keep the table at most 3/4 full at the requested size
+	size_t capacity = HASHTABLE_MIN_CAPACITY;
+	while (capacity * 3 < size * 4) {
+		capacity *= 2;
 	}
 
-	while (entry->next) {
-		if (keys_match(hashtable->key_type, entry->key, key)) {
-			return entry;
+	return capacity;
+}
+
+// Places an entry known not to be in the table, displacing entries closer to their home slot.
+static void hashtable_place(Hashtable *hashtable, HashtableEntry entry) {
+	const size_t mask = hashtable->capacity - 1;
+	size_t index = entry.hash & mask;
+	entry.distance = 1;
+
+	while (true) {
+		HashtableEntry *slot = &hashtable->entries[index];
+		if (!slot->distance) {
+			*slot = entry;
+			return;
 		}
-		entry = entry->next;
-	}
 
-	entry->next = ls_calloc(1, sizeof(HashtableEntry));
-	entry = entry->next;
-	hashtable->collision_count++;
+		if (slot->distance < entry.distance) {
+			HashtableEntry displaced = *slot;
+			*slot = entry;
+			entry = displaced;
+		}
 
-	return entry;
+		index = (index + 1) & mask;
+		entry.distance++;
+	}
 }
 
-static HashtableEntry *hashtable_get_entry(const Hashtable *hashtable, HashtableKey key) {
+static void hashtable_resize(Hashtable *hashtable, size_t new_capacity) {
 	LS_ASSERT(hashtable);
 
-	const size_t index = hashtable_index(hashtable, key);
-	HashtableEntry *entry = &hashtable->entries[index];
-	if (!entry->key.u32) {
-		return NULL;
+	HashtableEntry *old_entries = hashtable->entries;
+	size_t old_capacity = hashtable->capacity;
+
+	hashtable->capacity = new_capacity;
+	hashtable->entries = ls_calloc(new_capacity, sizeof(HashtableEntry));
+
+	// Hashes are cached, so moving entries never touches the keys
+	for (size_t i = 0; i < old_capacity; i++) {
+		if (old_entries[i].distance) {
+			hashtable_place(hashtable, old_entries[i]);
+		}
 	}
 
-	while (entry) {
-		if (keys_match(hashtable->key_type, entry->key, key)) {
+	ls_free(old_entries);
+}
+
+static HashtableEntry *hashtable_find(const Hashtable *hashtable, HashtableKey key, uint32 hash) {
+	const size_t mask = hashtable->capacity - 1;
+	size_t index = hash & mask;
+
+	for (uint32 distance = 1;; distance++) {
+		HashtableEntry *entry = &hashtable->entries[index];
+		// An empty slot or an entry closer to home means the key would have been placed before it
+		if (entry->distance < distance) {
+			return NULL;
+		}
+
+		if (entry->hash == hash && keys_match(hashtable->key_type, entry->key, key)) {
 			return entry;
 		}
-		entry = entry->next;
+
+		index = (index + 1) & mask;
 	}
+}
+
+static HashtableEntry *hashtable_get_entry(const Hashtable *hashtable, HashtableKey key) {
+	LS_ASSERT(hashtable);
 
-	return NULL;
+	return hashtable_find(hashtable, key, hashtable_hash(hashtable, key));
 }
 
 Hashtable *hashtable_create(HashtableKeyType key_type, size_t initial_size, bool should_free) {
 	Hashtable *hashtable = ls_malloc(sizeof(Hashtable));
 	hashtable->key_type = key_type;
-	hashtable->capacity = initial_size;
-	hashtable->initial_size = initial_size;
+	hashtable->capacity = hashtable_capacity_for(initial_size);
+	hashtable->initial_capacity = hashtable->capacity;
 	hashtable->size = 0;
-	hashtable->collision_count = 0;
 	hashtable->should_free = should_free;
-	hashtable->entries = ls_calloc(initial_size, sizeof(HashtableEntry));
+	hashtable->entries = ls_calloc(hashtable->capacity, sizeof(HashtableEntry));
 
 	return hashtable;
 }
 
-void hashtable_destroy(Hashtable *hashtable) {
-	LS_ASSERT(hashtable);
+static void hashtable_free_values(Hashtable *hashtable) {
+	if (!hashtable->should_free) {
+		return;
+	}
 
 	for (size_t i = 0; i < hashtable->capacity; i++) {
 		HashtableEntry *entry = &hashtable->entries[i];
-		clear_childern(entry, hashtable->should_free);
-		if (hashtable->should_free && entry->value.ptr) {
+		if (entry->distance && entry->value.ptr) {
 			ls_free(entry->value.ptr);
 		}
 	}
+}
+
+void hashtable_destroy(Hashtable *hashtable) {
+	LS_ASSERT(hashtable);
+
+	hashtable_free_values(hashtable);
 
 	ls_free(hashtable->entries);
 	ls_free(hashtable);
@@ -168,20 +198,23 @@ void hashtable_destroy(Hashtable *hashtable) {
 void hashtable_set(Hashtable *hashtable, HashtableKey key, HashtableValue value) {
 	LS_ASSERT(hashtable);
 
-	if (hashtable->size >= hashtable->capacity * 0.75f) {
-		hashtable_resize(hashtable, hashtable->capacity * 2);
-	}
-
-	HashtableEntry *entry = hashtable_get_entry_create(hashtable, key);
-
-	if (entry->key.u32) {
+	uint32 hash = hashtable_hash(hashtable, key);
+	HashtableEntry *entry = hashtable_find(hashtable, key, hash);
+	if (entry) {
 		entry->value = value;
 		return;
 	}
 
-	entry->key = key;
-	entry->value = value;
-	entry->next = NULL;
+	if ((hashtable->size + 1) * 4 > hashtable->capacity * 3) {
+		hashtable_resize(hashtable, hashtable->capacity * 2);
+	}
+
+	HashtableEntry new_entry = {
+		.key = key,
+		.value = value,
+		.hash = hash,
+	};
+	hashtable_place(hashtable, new_entry);
 
 	hashtable->size++;
 }
@@ -189,65 +222,56 @@ void hashtable_set(Hashtable *hashtable, HashtableKey key, HashtableValue value)
 void hashtable_clear(Hashtable *hashtable) {
 	LS_ASSERT(hashtable);
 
-	for (size_t i = 0; i < hashtable->capacity; i++) {
-		HashtableEntry *entry = &hashtable->entries[i];
-		clear_childern(entry, hashtable->should_free);
-
-		if (hashtable->should_free && entry->value.ptr) {
-			ls_free(entry->value.ptr);
-		}
+	hashtable_free_values(hashtable);
 
-		entry->key.u32 = 0;
-		entry->value.ptr = NULL;
-		entry->next = NULL;
+	if (hashtable->capacity != hashtable->initial_capacity) {
+		ls_free(hashtable->entries);
+		hashtable->capacity = hashtable->initial_capacity;
+		hashtable->entries = ls_calloc(hashtable->capacity, sizeof(HashtableEntry));
+	} else {
+		ls_memset(hashtable->entries, 0, hashtable->capacity * sizeof(HashtableEntry));
 	}
 
 	hashtable->size = 0;
-
-	hashtable_resize(hashtable, hashtable->initial_size);
 }
 
 bool hashtable_remove(Hashtable *hashtable, HashtableKey key) {
 	LS_ASSERT(hashtable);
 
-	const size_t index = hashtable_index(hashtable, key);
-	HashtableEntry *entry = &hashtable->entries[index];
-	if (!entry->key.u32) {
+	HashtableEntry *entry = hashtable_get_entry(hashtable, key);
+	if (!entry) {
 		return false;
 	}
 
-	while (entry) {
-		if (keys_match(hashtable->key_type, entry->key, key)) {
-			HashtableEntry *next = entry->next;
-
-			if (hashtable->should_free && entry->value.ptr) {
-				ls_free(entry->value.ptr);
-			}
-
-			hashtable->size--;
+	if (hashtable->should_free && entry->value.ptr) {
+		ls_free(entry->value.ptr);
+	}
 
-			if (next) {
-				hashtable->entries[index] = *next;
-				ls_free(next);
-			}
+	// Backward shift: pull every following displaced entry one slot closer to home
+	const size_t mask = hashtable->capacity - 1;
+	size_t index = entry - hashtable->entries;
+	size_t next = (index + 1) & mask;
+	while (hashtable->entries[next].distance > 1) {
+		hashtable->entries[index] = hashtable->entries[next];
+		hashtable->entries[index].distance--;
+		index = next;
+		next = (next + 1) & mask;
+	}
+	ls_memset(&hashtable->entries[index], 0, sizeof(HashtableEntry));
 
-			if (hashtable->size < hashtable->capacity * 0.25f) {
-				hashtable_resize(hashtable, hashtable->capacity / 2);
-			}
+	hashtable->size--;
 
-			return true;
-		}
-		entry = entry->next;
+	if (hashtable->capacity > hashtable->initial_capacity && hashtable->size * 4 < hashtable->capacity) {
+		hashtable_resize(hashtable, hashtable->capacity / 2);
 	}
 
-	return false;
+	return true;
 }
 
 bool hashtable_contains(const Hashtable *hashtable, HashtableKey key) {
 	LS_ASSERT(hashtable);
 
-	HashtableEntry *entry = hashtable_get_entry(hashtable, key);
-	return entry && entry->key.u32;
+	return hashtable_get_entry(hashtable, key) != NULL;
 }
 
 HashtableValue hashtable_get(const Hashtable *hashtable, HashtableKey key) {
@@ -255,7 +279,7 @@ HashtableValue hashtable_get(const Hashtable *hashtable, HashtableKey key) {
 
 	HashtableEntry *entry = hashtable_get_entry(hashtable, key);
 	if (!entry) {
-		return HASH_VAL(u32, 0);
+		return HASH_VAL(u64, 0);
 	}
 
 	return entry->value;
@@ -276,7 +300,14 @@ size_t hashtable_get_capacity(const Hashtable *hashtable) {
 int32 hashtable_get_collisions(const Hashtable *hashtable) {
 	LS_ASSERT(hashtable);
 
-	return hashtable->collision_count;
+	int32 collisions = 0;
+	for (size_t i = 0; i < hashtable->capacity; i++) {
+		if (hashtable->entries[i].distance > 1) {
+			collisions++;
+		}
+	}
+
+	return collisions;
 }
 
 Slice *hashtable_get_keys(const Hashtable *table) {
@@ -286,11 +317,8 @@ Slice *hashtable_get_keys(const Hashtable *table) {
 
 	for (size_t i = 0; i < table->capacity; i++) {
 		HashtableEntry *entry = &table->entries[i];
-		while (entry) {
-			if (entry->key.u32) {
-				slice_append(slice, SLICE_VAL(ptr, &entry->key));
-			}
-			entry = entry->next;
+		if (entry->distance) {
+			slice_append(slice, SLICE_VAL(ptr, &entry->key));
 		}
 	}
 
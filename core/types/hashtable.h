@@ -14,7 +14,9 @@ typedef enum {
 	HASHTABLE_KEY_INT32,
 	HASHTABLE_KEY_UINT32,
 	HASHTABLE_KEY_FLOAT32,
-	HASHTABLE_KEY_STRING
+	HASHTABLE_KEY_STRING,
+	// Interned string atoms from ls_atom_intern, compared as integers
+	HASHTABLE_KEY_ATOM
 } HashtableKeyType;
 
 typedef union {
@@ -22,6 +24,7 @@ typedef union {
 	uint32 u32;
 	float32 f32;
 	String str;
+	LSAtom atom;
 } HashtableKey;
 
 typedef union {
@@ -38,6 +41,8 @@ typedef union {
 
 typedef struct Hashtable Hashtable;
 
+// Open addressing table, inserts only allocate when the table grows.
+// String keys are not copied and must outlive their entry.
 // key_type must always be the same for a given hash table.
 // initial_size is the initial number of elements the hash table can hold.
 // should_free determines whether the hash table should free the value. Assumes value is a pointer.
@@ -59,7 +64,7 @@ LS_EXPORT int32 hashtable_get_collisions(const Hashtable *table);
 
 // Returns a slice of the keys in the hash table.
 // The slice should be destroyed by the caller.
-// The slize will contain HashtableKey references.
+// The slize will contain HashtableKey references, valid until the table is next modified.
 LS_EXPORT Slice *hashtable_get_keys(const Hashtable *table);
 
 #endif // HASHTABLE_H
\ No newline at end of file
@@ -0,0 +1,698 @@
+#include "core/types/spatial_index.h"
+
+#include "core/debug.h"
+#include "core/log.h"
+#include "core/memory.h"
+
+// Items covering more grid cells than this are kept in the overflow list instead of every cell.
+#define SPATIAL_GRID_MAX_ITEM_CELLS 16
+#define SPATIAL_GRID_INITIAL_CELLS 64
+#define SPATIAL_QUADTREE_NO_CHILDREN 0
+#define SPATIAL_ITEM_OVERFLOW 0xFFFFFFFFu
+
+typedef struct {
+	uint32 *handles;
+	uint32 count;
+	uint32 capacity;
+} SpatialList;
+
+typedef struct {
+	Vector2 min;
+	Vector2 max;
+	void *data;
+
+	// Query the item was last reported in, used to report items stored in several cells once.
+	uint32 query_mark;
+	bool alive;
+
+	// Quadtree: owning node, or SPATIAL_ITEM_OVERFLOW.
+	// Grid: SPATIAL_ITEM_OVERFLOW when the item covers too many cells, 0 when it is stored in its cells.
+	uint32 node;
+	// Position in the owning node or overflow list.
+	uint32 slot;
+
+	// Grid: covered cell range, unused when node is SPATIAL_ITEM_OVERFLOW.
+	int32 cell_min_x;
+	int32 cell_min_y;
+	int32 cell_max_x;
+	int32 cell_max_y;
+} SpatialItem;
+
+typedef struct {
+	uint64 key;
+	uint32 cell;
+	bool used;
+} SpatialCellSlot;
+
+typedef struct {
+	float32 cell_size;
+	float32 inv_cell_size;
+
+	// Open addressed map from packed cell coordinate to an index into cells.
+	// Cells are never removed, so lookups need no tombstones.
+	SpatialCellSlot *slots;
+	uint32 slot_capacity;
+
+	SpatialList *cells;
+	uint32 ncells;
+	uint32 cell_capacity;
+} SpatialGrid;
+
+typedef struct {
+	// Tight bounds are center +- half, loose bounds are center +- 2 * half.
+	Vector2 center;
+	float32 half;
+	uint32 depth;
+	uint32 children;
+	SpatialList items;
+} SpatialNode;
+
+typedef struct {
+	uint32 max_depth;
+
+	SpatialNode *nodes;
+	uint32 nnodes;
+	uint32 node_capacity;
+} SpatialQuadtree;
+
+struct SpatialIndex {
+	SpatialIndexType type;
+
+	SpatialItem *items;
+	uint32 nitems;
+	uint32 item_capacity;
+	size_t count;
+
+	uint32 *free_handles;
+	uint32 nfree;
+
+	// Items too large for the grid or outside the quadtree, tested on every query.
+	SpatialList overflow;
+
+	uint32 query_mark;
+
+	union {
+		SpatialGrid grid;
+		SpatialQuadtree quadtree;
+	};
+};
+
+static void spatial_list_push(SpatialList *list, uint32 handle) {
+	if (list->count == list->capacity) {
+		list->capacity = list->capacity ? list->capacity * 2 : 4;
+		list->handles = ls_realloc(list->handles, list->capacity * sizeof(uint32));
+	}
+
+	list->handles[list->count++] = handle;
+}
+
+// Swap removes the entry at slot, returns the handle moved into it or SPATIAL_INDEX_INVALID_HANDLE.
+static uint32 spatial_list_remove_at(SpatialList *list, uint32 slot) {
+	LS_ASSERT(slot < list->count);
+
+	list->count--;
+	if (slot == list->count) {
+		return SPATIAL_INDEX_INVALID_HANDLE;
+	}
+
+	list->handles[slot] = list->handles[list->count];
+	return list->handles[slot];
+}
+
+static void spatial_list_remove(SpatialList *list, uint32 handle) {
+	for (uint32 i = 0; i < list->count; i++) {
+		if (list->handles[i] == handle) {
+			spatial_list_remove_at(list, i);
+			return;
+		}
+	}
+}
+
+_FORCE_INLINE_ bool spatial_rect_overlaps(Vector2 a_min, Vector2 a_max, Vector2 b_min, Vector2 b_max) {
+	return a_min.x <= b_max.x && a_max.x >= b_min.x && a_min.y <= b_max.y && a_max.y >= b_min.y;
+}
+
+_FORCE_INLINE_ SpatialItem *spatial_index_get_item(const SpatialIndex *index, uint32 handle) {
+	LS_ASSERT(handle != SPATIAL_INDEX_INVALID_HANDLE && handle <= index->nitems);
+	SpatialItem *item = &index->items[handle - 1];
+	LS_ASSERT(item->alive);
+	return item;
+}
+
+static void spatial_overflow_add(SpatialIndex *index, uint32 handle) {
+	SpatialItem *item = &index->items[handle - 1];
+	item->node = SPATIAL_ITEM_OVERFLOW;
+	item->slot = index->overflow.count;
+	spatial_list_push(&index->overflow, handle);
+}
+
+static void spatial_overflow_remove(SpatialIndex *index, uint32 handle) {
+	uint32 moved = spatial_list_remove_at(&index->overflow, index->items[handle - 1].slot);
+	if (moved != SPATIAL_INDEX_INVALID_HANDLE) {
+		index->items[moved - 1].slot = index->items[handle - 1].slot;
+	}
+}
+
+/* --------------------------------- GRID --------------------------------- */
+
+_FORCE_INLINE_ int32 spatial_grid_coord(const SpatialGrid *grid, float32 value) {
+	float32 scaled = value * grid->inv_cell_size;
+	int32 coord = (int32)scaled;
+	return (scaled < (float32)coord) ? coord - 1 : coord;
+}
+
+_FORCE_INLINE_ uint64 spatial_grid_key(int32 x, int32 y) {
+	return ((uint64)(uint32)x << 32) | (uint64)(uint32)y;
+}
+
+_FORCE_INLINE_ uint32 spatial_grid_hash(uint64 key) {
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdULL;
+	key ^= key >> 33;
+	return (uint32)key;
+}
+
+static void spatial_grid_rehash(SpatialGrid *grid, uint32 capacity) {
+	SpatialCellSlot *old_slots = grid->slots;
+	uint32 old_capacity = grid->slot_capacity;
+
+	grid->slots = ls_calloc(capacity, sizeof(SpatialCellSlot));
+	grid->slot_capacity = capacity;
+
+	for (uint32 i = 0; i < old_capacity; i++) {
+		if (!old_slots[i].used) {
+			continue;
+		}
+
+		uint32 pos = spatial_grid_hash(old_slots[i].key) & (capacity - 1);
+		while (grid->slots[pos].used) {
+			pos = (pos + 1) & (capacity - 1);
+		}
+		grid->slots[pos] = old_slots[i];
+	}
+
+	ls_free(old_slots);
+}
+
+static SpatialList *spatial_grid_find_cell(const SpatialGrid *grid, int32 x, int32 y) {
+	uint64 key = spatial_grid_key(x, y);
+	uint32 pos = spatial_grid_hash(key) & (grid->slot_capacity - 1);
+	while (grid->slots[pos].used) {
+		if (grid->slots[pos].key == key) {
+			return &grid->cells[grid->slots[pos].cell];
+		}
+		pos = (pos + 1) & (grid->slot_capacity - 1);
+	}
+
+	return NULL;
+}
+
+static SpatialList *spatial_grid_get_cell(SpatialGrid *grid, int32 x, int32 y) {
+	SpatialList *cell = spatial_grid_find_cell(grid, x, y);
+	if (cell) {
+		return cell;
+	}
+
+	// Keep the load factor under 3/4
+	if ((grid->ncells + 1) * 4 > grid->slot_capacity * 3) {
+		spatial_grid_rehash(grid, grid->slot_capacity * 2);
+	}
+
+	if (grid->ncells == grid->cell_capacity) {
+		grid->cell_capacity *= 2;
+		grid->cells = ls_realloc(grid->cells, grid->cell_capacity * sizeof(SpatialList));
+	}
+
+	uint64 key = spatial_grid_key(x, y);
+	uint32 pos = spatial_grid_hash(key) & (grid->slot_capacity - 1);
+	while (grid->slots[pos].used) {
+		pos = (pos + 1) & (grid->slot_capacity - 1);
+	}
+
+	grid->slots[pos].key = key;
+	grid->slots[pos].cell = grid->ncells;
+	grid->slots[pos].used = true;
+
+	cell = &grid->cells[grid->ncells++];
+	cell->handles = NULL;
+	cell->count = 0;
+	cell->capacity = 0;
+
+	return cell;
+}
+
+static void spatial_grid_add(SpatialIndex *index, uint32 handle) {
+	SpatialGrid *grid = &index->grid;
+	SpatialItem *item = &index->items[handle - 1];
+
+	item->cell_min_x = spatial_grid_coord(grid, item->min.x);
+	item->cell_min_y = spatial_grid_coord(grid, item->min.y);
+	item->cell_max_x = spatial_grid_coord(grid, item->max.x);
+	item->cell_max_y = spatial_grid_coord(grid, item->max.y);
+
+	int64 ncells = ((int64)item->cell_max_x - item->cell_min_x + 1) * ((int64)item->cell_max_y - item->cell_min_y + 1);
+	if (ncells > SPATIAL_GRID_MAX_ITEM_CELLS) {
+		spatial_overflow_add(index, handle);
+		return;
+	}
+
+	item->node = 0;
+	for (int32 y = item->cell_min_y; y <= item->cell_max_y; y++) {
+		for (int32 x = item->cell_min_x; x <= item->cell_max_x; x++) {
+			spatial_list_push(spatial_grid_get_cell(grid, x, y), handle);
+		}
+	}
+}
+
+static void spatial_grid_remove(SpatialIndex *index, uint32 handle) {
+	SpatialItem *item = &index->items[handle - 1];
+	if (item->node == SPATIAL_ITEM_OVERFLOW) {
+		spatial_overflow_remove(index, handle);
+		return;
+	}
+
+	for (int32 y = item->cell_min_y; y <= item->cell_max_y; y++) {
+		for (int32 x = item->cell_min_x; x <= item->cell_max_x; x++) {
+			SpatialList *cell = spatial_grid_find_cell(&index->grid, x, y);
+			LS_ASSERT(cell);
+			spatial_list_remove(cell, handle);
+		}
+	}
+}
+
+static bool spatial_grid_same_cells(const SpatialIndex *index, const SpatialItem *item, Vector2 min, Vector2 max) {
+	const SpatialGrid *grid = &index->grid;
+	return item->node != SPATIAL_ITEM_OVERFLOW &&
+			item->cell_min_x == spatial_grid_coord(grid, min.x) && item->cell_min_y == spatial_grid_coord(grid, min.y) &&
+			item->cell_max_x == spatial_grid_coord(grid, max.x) && item->cell_max_y == spatial_grid_coord(grid, max.y);
+}
+
+/* ------------------------------- QUADTREE ------------------------------- */
+
+static uint32 spatial_quadtree_split(SpatialQuadtree *tree, uint32 node_index) {
+	if (tree->nnodes + 4 > tree->node_capacity) {
+		tree->node_capacity *= 2;
+		tree->nodes = ls_realloc(tree->nodes, tree->node_capacity * sizeof(SpatialNode));
+	}
+
+	SpatialNode *node = &tree->nodes[node_index];
+	uint32 first = tree->nnodes;
+	float32 half = node->half * 0.5f;
+	for (uint32 i = 0; i < 4; i++) {
+		SpatialNode *child = &tree->nodes[first + i];
+		child->center.x = node->center.x + ((i & 1) ? half : -half);
+		child->center.y = node->center.y + ((i & 2) ? half : -half);
+		child->half = half;
+		child->depth = node->depth + 1;
+		child->children = SPATIAL_QUADTREE_NO_CHILDREN;
+		child->items.handles = NULL;
+		child->items.count = 0;
+		child->items.capacity = 0;
+	}
+
+	tree->nnodes += 4;
+	node->children = first;
+	return first;
+}
+
+// Returns the deepest node whose loose bounds hold the rect, or SPATIAL_ITEM_OVERFLOW if it is centered outside the tree.
+static uint32 spatial_quadtree_find_node(SpatialQuadtree *tree, Vector2 min, Vector2 max) {
+	Vector2 center = vec2((min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f);
+	float32 extent = max.x - min.x;
+	if (max.y - min.y > extent) {
+		extent = max.y - min.y;
+	}
+
+	const SpatialNode *root = &tree->nodes[0];
+	if (center.x < root->center.x - root->half || center.x > root->center.x + root->half ||
+			center.y < root->center.y - root->half || center.y > root->center.y + root->half) {
+		return SPATIAL_ITEM_OVERFLOW;
+	}
+
+	// A rect of size up to the child's full tight size, centered anywhere in the child,
+	// stays within the child's loose bounds.
+	uint32 node_index = 0;
+	while (tree->nodes[node_index].depth < tree->max_depth && extent <= tree->nodes[node_index].half) {
+		uint32 children = tree->nodes[node_index].children;
+		if (children == SPATIAL_QUADTREE_NO_CHILDREN) {
+			children = spatial_quadtree_split(tree, node_index);
+		}
+
+		const SpatialNode *node = &tree->nodes[node_index];
+		uint32 quadrant = (center.x >= node->center.x ? 1 : 0) | (center.y >= node->center.y ? 2 : 0);
+		node_index = children + quadrant;
+	}
+
+	return node_index;
+}
+
+static void spatial_quadtree_add(SpatialIndex *index, uint32 handle, uint32 node_index) {
+	if (node_index == SPATIAL_ITEM_OVERFLOW) {
+		spatial_overflow_add(index, handle);
+		return;
+	}
+
+	SpatialItem *item = &index->items[handle - 1];
+	SpatialNode *node = &index->quadtree.nodes[node_index];
+	item->node = node_index;
+	item->slot = node->items.count;
+	spatial_list_push(&node->items, handle);
+}
+
+static void spatial_quadtree_remove(SpatialIndex *index, uint32 handle) {
+	SpatialItem *item = &index->items[handle - 1];
+	if (item->node == SPATIAL_ITEM_OVERFLOW) {
+		spatial_overflow_remove(index, handle);
+		return;
+	}
+
+	SpatialNode *node = &index->quadtree.nodes[item->node];
+	uint32 moved = spatial_list_remove_at(&node->items, item->slot);
+	if (moved != SPATIAL_INDEX_INVALID_HANDLE) {
+		index->items[moved - 1].slot = item->slot;
+	}
+}
+
+/* --------------------------------- INDEX -------------------------------- */
+
+static SpatialIndex *spatial_index_create(SpatialIndexType type) {
+	SpatialIndex *index = ls_calloc(1, sizeof(SpatialIndex));
+	index->type = type;
+	index->item_capacity = 16;
+	index->items = ls_malloc(index->item_capacity * sizeof(SpatialItem));
+	index->free_handles = ls_malloc(index->item_capacity * sizeof(uint32));
+
+	return index;
+}
+
+SpatialIndex *spatial_index_create_grid(float32 cell_size) {
+	LS_ASSERT(cell_size > 0.0f);
+
+	SpatialIndex *index = spatial_index_create(SPATIAL_INDEX_GRID);
+	SpatialGrid *grid = &index->grid;
+	grid->cell_size = cell_size;
+	grid->inv_cell_size = 1.0f / cell_size;
+	grid->slot_capacity = SPATIAL_GRID_INITIAL_CELLS * 2;
+	grid->slots = ls_calloc(grid->slot_capacity, sizeof(SpatialCellSlot));
+	grid->cell_capacity = SPATIAL_GRID_INITIAL_CELLS;
+	grid->cells = ls_malloc(grid->cell_capacity * sizeof(SpatialList));
+
+	return index;
+}
+
+SpatialIndex *spatial_index_create_quadtree(Vector2 min, Vector2 max, uint32 max_depth) {
+	LS_ASSERT(max.x > min.x && max.y > min.y);
+
+	SpatialIndex *index = spatial_index_create(SPATIAL_INDEX_QUADTREE);
+	SpatialQuadtree *tree = &index->quadtree;
+	tree->max_depth = max_depth;
+	tree->node_capacity = 33;
+	tree->nodes = ls_malloc(tree->node_capacity * sizeof(SpatialNode));
+	tree->nnodes = 1;
+
+	// The root is square so every level splits into square cells
+	SpatialNode *root = &tree->nodes[0];
+	root->center = vec2((min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f);
+	root->half = (max.x - min.x > max.y - min.y ? max.x - min.x : max.y - min.y) * 0.5f;
+	root->depth = 0;
+	root->children = SPATIAL_QUADTREE_NO_CHILDREN;
+	root->items.handles = NULL;
+	root->items.count = 0;
+	root->items.capacity = 0;
+
+	return index;
+}
+
+static void spatial_index_free_storage(SpatialIndex *index) {
+	if (index->type == SPATIAL_INDEX_GRID) {
+		for (uint32 i = 0; i < index->grid.ncells; i++) {
+			ls_free(index->grid.cells[i].handles);
+		}
+	} else {
+		for (uint32 i = 0; i < index->quadtree.nnodes; i++) {
+			ls_free(index->quadtree.nodes[i].items.handles);
+		}
+	}
+}
+
+void spatial_index_destroy(SpatialIndex *index) {
+	spatial_index_free_storage(index);
+
+	if (index->type == SPATIAL_INDEX_GRID) {
+		ls_free(index->grid.slots);
+		ls_free(index->grid.cells);
+	} else {
+		ls_free(index->quadtree.nodes);
+	}
+
+	ls_free(index->overflow.handles);
+	ls_free(index->free_handles);
+	ls_free(index->items);
+	ls_free(index);
+}
+
+SpatialIndexType spatial_index_get_type(const SpatialIndex *index) {
+	return index->type;
+}
+
+uint32 spatial_index_insert(SpatialIndex *index, Vector2 min, Vector2 max, void *data) {
+	uint32 handle;
+	if (index->nfree > 0) {
+		handle = index->free_handles[--index->nfree];
+	} else {
+		if (index->nitems == index->item_capacity) {
+			index->item_capacity *= 2;
+			index->items = ls_realloc(index->items, index->item_capacity * sizeof(SpatialItem));
+			index->free_handles = ls_realloc(index->free_handles, index->item_capacity * sizeof(uint32));
+		}
+		handle = ++index->nitems;
+	}
+
+	SpatialItem *item = &index->items[handle - 1];
+	item->min = min;
+	item->max = max;
+	item->data = data;
+	item->query_mark = index->query_mark;
+	item->alive = true;
+	index->count++;
+
+	if (index->type == SPATIAL_INDEX_GRID) {
+		spatial_grid_add(index, handle);
+	} else {
+		spatial_quadtree_add(index, handle, spatial_quadtree_find_node(&index->quadtree, min, max));
+	}
+
+	return handle;
+}
+
+void spatial_index_update(SpatialIndex *index, uint32 handle, Vector2 min, Vector2 max) {
+	SpatialItem *item = spatial_index_get_item(index, handle);
+
+	if (index->type == SPATIAL_INDEX_GRID) {
+		if (spatial_grid_same_cells(index, item, min, max)) {
+			item->min = min;
+			item->max = max;
+			return;
+		}
+
+		spatial_grid_remove(index, handle);
+		item->min = min;
+		item->max = max;
+		spatial_grid_add(index, handle);
+	} else {
+		uint32 node_index = spatial_quadtree_find_node(&index->quadtree, min, max);
+		item->min = min;
+		item->max = max;
+		if (node_index == item->node) {
+			return;
+		}
+
+		spatial_quadtree_remove(index, handle);
+		spatial_quadtree_add(index, handle, node_index);
+	}
+}
+
+void spatial_index_remove(SpatialIndex *index, uint32 handle) {
+	SpatialItem *item = spatial_index_get_item(index, handle);
+
+	if (index->type == SPATIAL_INDEX_GRID) {
+		spatial_grid_remove(index, handle);
+	} else {
+		spatial_quadtree_remove(index, handle);
+	}
+
+	item->alive = false;
+	item->data = NULL;
+	index->free_handles[index->nfree++] = handle;
+	index->count--;
+}
+
+void spatial_index_clear(SpatialIndex *index) {
+	// Keep allocated cells and nodes around, they are likely to be filled again
+	if (index->type == SPATIAL_INDEX_GRID) {
+		for (uint32 i = 0; i < index->grid.ncells; i++) {
+			index->grid.cells[i].count = 0;
+		}
+	} else {
+		for (uint32 i = 0; i < index->quadtree.nnodes; i++) {
+			index->quadtree.nodes[i].items.count = 0;
+		}
+	}
+
+	index->overflow.count = 0;
+	index->nitems = 0;
+	index->nfree = 0;
+	index->count = 0;
+}
+
+bool spatial_index_contains(const SpatialIndex *index, uint32 handle) {
+	return handle != SPATIAL_INDEX_INVALID_HANDLE && handle <= index->nitems && index->items[handle - 1].alive;
+}
+
+void *spatial_index_get_data(const SpatialIndex *index, uint32 handle) {
+	return spatial_index_get_item(index, handle)->data;
+}
+
+void spatial_index_set_data(SpatialIndex *index, uint32 handle, void *data) {
+	spatial_index_get_item(index, handle)->data = data;
+}
+
+void spatial_index_get_bounds(const SpatialIndex *index, uint32 handle, Vector2 *min, Vector2 *max) {
+	const SpatialItem *item = spatial_index_get_item(index, handle);
+	if (min) {
+		*min = item->min;
+	}
+	if (max) {
+		*max = item->max;
+	}
+}
+
+size_t spatial_index_get_count(const SpatialIndex *index) {
+	return index->count;
+}
+
+typedef struct {
+	SpatialIndex *index;
+	Vector2 min;
+	Vector2 max;
+	SpatialIndexQueryFunc func;
+	void *user_data;
+	size_t nreported;
+	bool stopped;
+} SpatialQuery;
+
+// Tests every item in the list against the query, returns false once the callback stops the query.
+static bool spatial_query_list(SpatialQuery *query, const SpatialList *list) {
+	SpatialItem *items = query->index->items;
+	uint32 mark = query->index->query_mark;
+	for (uint32 i = 0; i < list->count; i++) {
+		uint32 handle = list->handles[i];
+		SpatialItem *item = &items[handle - 1];
+		if (item->query_mark == mark || !spatial_rect_overlaps(item->min, item->max, query->min, query->max)) {
+			continue;
+		}
+
+		item->query_mark = mark;
+		query->nreported++;
+		if (!query->func(handle, item->data, query->user_data)) {
+			query->stopped = true;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void spatial_query_grid(SpatialQuery *query) {
+	const SpatialGrid *grid = &query->index->grid;
+	int32 min_x = spatial_grid_coord(grid, query->min.x);
+	int32 min_y = spatial_grid_coord(grid, query->min.y);
+	int32 max_x = spatial_grid_coord(grid, query->max.x);
+	int32 max_y = spatial_grid_coord(grid, query->max.y);
+
+	// Walking every occupied cell is cheaper than probing a range larger than the grid
+	int64 range = ((int64)max_x - min_x + 1) * ((int64)max_y - min_y + 1);
+	if (range > grid->ncells) {
+		for (uint32 i = 0; i < grid->ncells; i++) {
+			if (!spatial_query_list(query, &grid->cells[i])) {
+				return;
+			}
+		}
+		return;
+	}
+
+	for (int32 y = min_y; y <= max_y; y++) {
+		for (int32 x = min_x; x <= max_x; x++) {
+			const SpatialList *cell = spatial_grid_find_cell(grid, x, y);
+			if (cell && !spatial_query_list(query, cell)) {
+				return;
+			}
+		}
+	}
+}
+
+static void spatial_query_node(SpatialQuery *query, uint32 node_index) {
+	const SpatialNode *node = &query->index->quadtree.nodes[node_index];
+
+	// Items at the root may be larger than its loose bounds, so it is always visited
+	if (node_index != 0) {
+		float32 loose = node->half * 2.0f;
+		Vector2 node_min = vec2(node->center.x - loose, node->center.y - loose);
+		Vector2 node_max = vec2(node->center.x + loose, node->center.y + loose);
+		if (!spatial_rect_overlaps(node_min, node_max, query->min, query->max)) {
+			return;
+		}
+	}
+
+	if (!spatial_query_list(query, &node->items)) {
+		return;
+	}
+
+	uint32 children = node->children;
+	if (children == SPATIAL_QUADTREE_NO_CHILDREN) {
+		return;
+	}
+
+	for (uint32 i = 0; i < 4 && !query->stopped; i++) {
+		spatial_query_node(query, children + i);
+	}
+}
+
+size_t spatial_index_query_rect(SpatialIndex *index, Vector2 min, Vector2 max, SpatialIndexQueryFunc func, void *user_data) {
+	LS_ASSERT(func);
+
+	SpatialQuery query = {
+		.index = index,
+		.min = min,
+		.max = max,
+		.func = func,
+		.user_data = user_data,
+		.nreported = 0,
+		.stopped = false,
+	};
+
+	index->query_mark++;
+	if (index->query_mark == 0) {
+		// The mark wrapped around, reset it so stale marks can not match
+		for (uint32 i = 0; i < index->nitems; i++) {
+			index->items[i].query_mark = 0;
+		}
+		index->query_mark = 1;
+	}
+
+	if (!spatial_query_list(&query, &index->overflow)) {
+		return query.nreported;
+	}
+
+	if (index->type == SPATIAL_INDEX_GRID) {
+		spatial_query_grid(&query);
+	} else {
+		spatial_query_node(&query, 0);
+	}
+
+	return query.nreported;
+}
+
+size_t spatial_index_query_point(SpatialIndex *index, Vector2 point, SpatialIndexQueryFunc func, void *user_data) {
+	return spatial_index_query_rect(index, point, point, func, user_data);
+}
\ No newline at end of file
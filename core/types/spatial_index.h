@@ -0,0 +1,51 @@
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include "core/api.h"
+#include "core/math/vector.h"
+#include "core/types/typedefs.h"
+
+// Handles are never 0, a handle is valid until it is removed or the index is cleared.
+#define SPATIAL_INDEX_INVALID_HANDLE 0
+
+typedef enum {
+	// Uniform grid hashed by cell coordinate, best when items are of similar size.
+	SPATIAL_INDEX_GRID,
+	// Loose quadtree over fixed bounds, best when item sizes vary a lot.
+	SPATIAL_INDEX_QUADTREE,
+} SpatialIndexType;
+
+typedef struct SpatialIndex SpatialIndex;
+
+// Called for each item overlapping a query. Return false to stop the query early.
+typedef bool (*SpatialIndexQueryFunc)(uint32 handle, void *data, void *user_data);
+
+// Creates a grid with square cells of cell_size world units. The grid is unbounded.
+LS_EXPORT SpatialIndex *spatial_index_create_grid(float32 cell_size);
+// Creates a loose quadtree covering min to max, split at most max_depth times.
+// Items centered outside the bounds still work, they are kept in a list tested on every query.
+LS_EXPORT SpatialIndex *spatial_index_create_quadtree(Vector2 min, Vector2 max, uint32 max_depth);
+LS_EXPORT void spatial_index_destroy(SpatialIndex *index);
+
+LS_EXPORT SpatialIndexType spatial_index_get_type(const SpatialIndex *index);
+
+// Inserts an axis aligned rect and returns its handle.
+LS_EXPORT uint32 spatial_index_insert(SpatialIndex *index, Vector2 min, Vector2 max, void *data);
+// Moves an item. Cheap when the item stays in the same cells or node.
+LS_EXPORT void spatial_index_update(SpatialIndex *index, uint32 handle, Vector2 min, Vector2 max);
+LS_EXPORT void spatial_index_remove(SpatialIndex *index, uint32 handle);
+LS_EXPORT void spatial_index_clear(SpatialIndex *index);
+
+LS_EXPORT bool spatial_index_contains(const SpatialIndex *index, uint32 handle);
+LS_EXPORT void *spatial_index_get_data(const SpatialIndex *index, uint32 handle);
+LS_EXPORT void spatial_index_set_data(SpatialIndex *index, uint32 handle, void *data);
+LS_EXPORT void spatial_index_get_bounds(const SpatialIndex *index, uint32 handle, Vector2 *min, Vector2 *max);
+LS_EXPORT size_t spatial_index_get_count(const SpatialIndex *index);
+
+// Calls func for every item overlapping the rect, edges included. Each item is reported once.
+// Returns the number of items reported.
+LS_EXPORT size_t spatial_index_query_rect(SpatialIndex *index, Vector2 min, Vector2 max, SpatialIndexQueryFunc func, void *user_data);
+// Calls func for every item containing the point, edges included.
+LS_EXPORT size_t spatial_index_query_point(SpatialIndex *index, Vector2 point, SpatialIndexQueryFunc func, void *user_data);
+
+#endif // SPATIAL_INDEX_H
\ No newline at end of file
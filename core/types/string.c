@@ -1,6 +1,7 @@
 #include "core/types/string.h"
 #include "core/debug.h"
 #include "core/memory.h"
+#include "core/types/hashtable.h"
 
 #include <stdarg.h>
 #include <stdio.h>
@@ -29,9 +30,10 @@ size_t ls_str_length(String string) {
 size_t ls_str_hash_djb2(String string) {
 	LS_ASSERT(string);
 
+	// Walk to the terminator instead of measuring the string every iteration
 	size_t hash = 0;
-	for (size_t i = 0; i < ls_str_length(string); i++) {
-		hash = ((hash << 5) + hash) + string[i];
+	for (const char *c = string; *c; c++) {
+		hash = ((hash << 5) + hash) + *c;
 	}
 
 	return hash;
@@ -299,4 +301,77 @@ void ls_str_to_upper(char *string) {
 			string[i] -= 'a' - 'A';
 		}
 	}
+}
+
+typedef struct {
+	// Interned copy to atom
+	Hashtable *atoms;
+	// Atom - 1 to interned copy
+	char **strings;
+	uint32 count;
+	uint32 capacity;
+} AtomTable;
+
+static AtomTable atom_table = { 0 };
+
+LSAtom ls_atom_intern(String string) {
+	LS_ASSERT(string);
+
+	if (!atom_table.atoms) {
+		atom_table.atoms = hashtable_create(HASHTABLE_KEY_STRING, 256, false);
+		atom_table.capacity = 256;
+		atom_table.strings = ls_malloc(atom_table.capacity * sizeof(char *));
+	}
+
+	LSAtom atom = hashtable_get(atom_table.atoms, HASH_KEY(str, string)).u32;
+	if (atom != LS_ATOM_NONE) {
+		return atom;
+	}
+
+	if (atom_table.count == atom_table.capacity) {
+		atom_table.capacity *= 2;
+		atom_table.strings = ls_realloc(atom_table.strings, atom_table.capacity * sizeof(char *));
+	}
+
+	char *copy = ls_str_copy(string);
+	atom_table.strings[atom_table.count++] = copy;
+	atom = atom_table.count;
+
+	hashtable_set(atom_table.atoms, HASH_KEY(str, copy), HASH_VAL(u32, atom));
+
+	return atom;
+}
+
+LSAtom ls_atom_find(String string) {
+	LS_ASSERT(string);
+
+	if (!atom_table.atoms) {
+		return LS_ATOM_NONE;
+	}
+
+	return hashtable_get(atom_table.atoms, HASH_KEY(str, string)).u32;
+}
+
+String ls_atom_get_string(LSAtom atom) {
+	LS_ASSERT(atom != LS_ATOM_NONE && atom <= atom_table.count);
+
+	return atom_table.strings[atom - 1];
+}
+
+String ls_str_intern(String string) {
+	return ls_atom_get_string(ls_atom_intern(string));
+}
+
+void ls_atoms_deinit() {
+	if (!atom_table.atoms) {
+		return;
+	}
+
+	hashtable_destroy(atom_table.atoms);
+	for (uint32 i = 0; i < atom_table.count; i++) {
+		ls_free(atom_table.strings[i]);
+	}
+	ls_free(atom_table.strings);
+
+	atom_table = (AtomTable){ 0 };
 }
\ No newline at end of file
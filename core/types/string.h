@@ -34,4 +34,21 @@ LS_EXPORT bool ls_str_to_bool(String string, bool *out_value);
 LS_EXPORT void ls_str_to_lower(char *string);
 LS_EXPORT void ls_str_to_upper(char *string);
 
+// Interned strings. Equal strings intern to the same atom, so atoms compare with ==.
+// Atoms are never 0 and stay valid until ls_atoms_deinit. Interning is not thread safe.
+typedef uint32 LSAtom;
+#define LS_ATOM_NONE 0
+
+// Returns the atom for string, copying it on first use.
+LS_EXPORT LSAtom ls_atom_intern(String string);
+// Returns the atom for string if it was interned before, LS_ATOM_NONE otherwise. Never allocates.
+LS_EXPORT LSAtom ls_atom_find(String string);
+// Returns the interned copy of an atom's string.
+LS_EXPORT String ls_atom_get_string(LSAtom atom);
+// Returns the interned copy of string, equal strings share a pointer.
+LS_EXPORT String ls_str_intern(String string);
+
+// Frees every interned string.
+void ls_atoms_deinit();
+
 #endif // STRING_H
\ No newline at end of file
@@ -58,6 +58,11 @@ typedef unsigned long long size_t;
 #endif
 #endif
 
+// Aligns a variable or member to m_bytes.
+#ifndef _ALIGN_
+#define _ALIGN_(m_bytes) _Alignas(m_bytes)
+#endif
+
 #ifndef _NO_DISCARD_
 #define _NO_DISCARD_ [[nodiscard]]
 #endif
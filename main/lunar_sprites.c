@@ -22,6 +22,11 @@ struct Main {
 	Slice *update_callbacks;
 
 	FlagValue *path;
+	FlagValue *allocator;
+#if defined(MEMORY_TRACKING_ENABLED)
+	FlagValue *memory_frame_budget;
+	FlagValue *memory_dump;
+#endif // MEMORY_TRACKING_ENABLED
 
 	bool should_stop;
 	int32 exit_code;
@@ -30,13 +35,22 @@ struct Main {
 static struct Main main;
 
 static void check_path();
+static void select_allocator(int32 argc, char *argv[]);
 
 void ls_main_init(int32 argc, char *argv[]) {
 	main.should_stop = false;
 	main.exit_code = 0;
 
+	// Must happen before anything is allocated.
+	select_allocator(argc, argv);
+
 	main.flag_manager = flag_manager_create();
 	main.path = flag_manager_register(main.flag_manager, "path", FLAG_TYPE_STRING, FLAG_VAL(str, "./"), "Path to the game directory.");
+	main.allocator = flag_manager_register(main.flag_manager, "allocator", FLAG_TYPE_STRING, FLAG_VAL(str, "system"), "Backing allocator, system or bump. bump never frees and is only meant for benchmarking.");
+#if defined(MEMORY_TRACKING_ENABLED)
+	main.memory_frame_budget = flag_manager_register(main.flag_manager, "memory-frame-budget", FLAG_TYPE_INT, FLAG_VAL(i32, -1), "Warn when a frame makes more allocations than this, -1 disables the check.");
+	main.memory_dump = flag_manager_register(main.flag_manager, "memory-dump", FLAG_TYPE_STRING, FLAG_VAL(str, ""), "Write an allocation report to this file on exit.");
+#endif // MEMORY_TRACKING_ENABLED
 
 	main.update_callbacks = slice_create(16, false);
 
@@ -46,6 +60,9 @@ void ls_main_init(int32 argc, char *argv[]) {
 	main.core = core_create(main.flag_manager);
 	check_path();
 	ls_log(LOG_LEVEL_INFO, "Initializing Lunar Sprites.\n");
+	if (!ls_str_equals(main.allocator->str, ls_get_allocator()->name)) {
+		ls_log(LOG_LEVEL_WARNING, "Unknown allocator %s, using %s.\n", main.allocator->str, ls_get_allocator()->name);
+	}
 	initialize_modules(MODULE_INITIALIZATION_LEVEL_CORE, main.core);
 	ls_log(LOG_LEVEL_INFO, "Initialization level core done.\n");
 
@@ -56,10 +73,15 @@ void ls_main_init(int32 argc, char *argv[]) {
 	// Parse all flags.
 	flag_manager_parse(main.flag_manager, argc, argv, false);
 
+#if defined(MEMORY_TRACKING_ENABLED)
+	ls_memory_set_frame_budget(main.memory_frame_budget->i32);
+#endif // MEMORY_TRACKING_ENABLED
+
 	initialize_modules(MODULE_INITIALIZATION_LEVEL_FLAGS, NULL);
 	ls_log(LOG_LEVEL_INFO, "Initialization level flags done.\n");
 
 	core_start(main.core);
+	profiler_set_thread_name("Main");
 
 	renderer_start(main.renderer);
 
@@ -83,7 +105,11 @@ void ls_main_init(int32 argc, char *argv[]) {
 }
 
 void ls_update(float64 delta_time) {
-	main.application_interface.update(delta_time, main.application_interface.user_data);
+	LS_PROFILE_BEGIN("ls_update");
+
+	LS_PROFILE_SCOPE("application_update") {
+		main.application_interface.update(delta_time, main.application_interface.user_data);
+	}
 
 	size_t n_callbacks = slice_get_size(main.update_callbacks);
 	for (size_t i = 0; i < n_callbacks; i++) {
@@ -91,9 +117,17 @@ void ls_update(float64 delta_time) {
 		LS_ASSERT(callback);
 		callback(delta_time);
 	}
+
+	LS_PROFILE_END();
 }
 
 int32 ls_main_deinit() {
+#if defined(MEMORY_TRACKING_ENABLED)
+	// The flag manager is gone after core_destroy
+	char memory_dump_path[256];
+	ls_str_copy_to(memory_dump_path, main.memory_dump->str, sizeof(memory_dump_path));
+#endif // MEMORY_TRACKING_ENABLED
+
 	ls_main_loop_deinit();
 
 	uninitialize_modules(MODULE_INITIALIZATION_LEVEL_APPLICATION);
@@ -110,6 +144,13 @@ int32 ls_main_deinit() {
 	core_destroy(main.core);
 	slice_destroy(main.update_callbacks);
 
+#if defined(MEMORY_TRACKING_ENABLED)
+	// Whatever is still live here leaked
+	if (memory_dump_path[0]) {
+		ls_memory_dump(memory_dump_path);
+	}
+#endif // MEMORY_TRACKING_ENABLED
+
 	return main.exit_code;
 }
 
@@ -155,4 +196,18 @@ static void check_path() {
 		ls_log(LOG_LEVEL_INFO, "Setting working directory to %s.\n", main.path->str);
 		os_set_working_directory(main.path->str);
 	}
+}
+
+// The flag manager allocates, so the allocator flag is read straight from argv.
+static void select_allocator(int32 argc, char *argv[]) {
+	for (int32 i = 1; i + 1 < argc; i++) {
+		if (!ls_str_equals(argv[i], "--allocator")) {
+			continue;
+		}
+
+		const LSAllocator *allocator = ls_find_allocator(argv[i + 1]);
+		if (allocator) {
+			ls_set_allocator(allocator);
+		}
+	}
 }
\ No newline at end of file
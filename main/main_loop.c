@@ -5,6 +5,7 @@
 
 #include "renderer/batch_renderer.h"
 #include "renderer/renderer.h"
+#include "renderer/texture.h"
 #include "renderer/window.h"
 
 typedef struct {
@@ -48,6 +49,7 @@ void ls_main_loop_deinit() {
 static void ls_render_loop(void *data) {
 	ls_log(LOG_LEVEL_INFO, "Starting render loop.\n");
 	window_make_current(main_loop.root_window);
+	profiler_set_thread_name("Render");
 
 	while (!ls_should_stop()) {
 		os_mutex_lock(main_loop.render_mutex);
@@ -57,15 +59,24 @@ static void ls_render_loop(void *data) {
 		main_loop.last_frame_time = current_time;
 
 		renderer_clear(main_loop.renderer);
+
+		LS_PROFILE_SCOPE("texture_uploads") {
+			texture_manager_process_uploads();
+		}
+
 		ls_update(main_loop.delta_time);
 
 		batch_renderer_end_frame();
 
 		if (main_loop.root_window) {
-			window_make_current(main_loop.root_window);
-			window_swap_buffers(main_loop.root_window);
+			LS_PROFILE_SCOPE("swap_buffers") {
+				window_make_current(main_loop.root_window);
+				window_swap_buffers(main_loop.root_window);
+			}
 		}
 
+		profiler_end_frame();
+
 		os_mutex_unlock(main_loop.render_mutex);
 	}
 
@@ -74,9 +85,13 @@ static void ls_render_loop(void *data) {
 }
 
 void ls_main_loop() {
+	LS_PROFILE_BEGIN("poll");
+
 	core_poll(main_loop.core);
 
 	if (main_loop.root_window) {
 		window_poll(main_loop.root_window);
 	}
+
+	LS_PROFILE_END();
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 
 #include "renderer/batch_renderer.h"
 #include "renderer/renderer.h"
+#include "renderer/texture.h"
 #include "renderer/window.h"
 
 typedef struct {
@@ -37,6 +38,7 @@ void ls_main_loop() {
 	main_loop.last_frame_time = current_time;
 
 	renderer_clear(main_loop.renderer);
+	texture_manager_process_uploads();
 	ls_update(main_loop.delta_time);
 
 	batch_renderer_end_frame();
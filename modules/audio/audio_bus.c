@@ -0,0 +1,401 @@
+#include "audio_bus.h"
+
+#include "internal/audio_bus.h"
+#include "internal/audio_server.h"
+#include "internal/mix.h"
+
+// Trigger peak above which a ducked bus goes down, about -40dB
+#define AUDIO_BUS_DUCK_THRESHOLD 0.01f
+
+typedef struct {
+	AudioBusProcessFunction process;
+	void *user_data;
+} AudioBusProcessor;
+
+// The mixer's side of a bus, only touched by whichever thread applies commands
+typedef struct {
+	bool is_active;
+	AudioBus parent;
+	float32 gain;
+	// Gain the last block ended on, the next block ramps from it
+	float32 applied_gain;
+
+	// Run in order on the block, kept packed
+	AudioBusProcessor processors[AUDIO_BUS_MAX_PROCESSORS];
+	uint32 processor_count;
+
+	AudioBus duck_trigger;
+	float32 duck_depth;
+	float32 duck_attack;
+	float32 duck_release;
+	float32 duck_gain;
+	// Another bus ducks under this one, so its level is measured
+	bool is_duck_trigger;
+
+	// Peak of the last block the bus put out
+	float32 level;
+	// Leading frames of the block written since it was last cleared, 0 while it is silent.
+	// Blocks can be shorter than the one before, so this is what has to be cleared, not the block size.
+	uint32 dirty_frames;
+
+	float32 block[AUDIO_BUS_BLOCK_FRAMES * AUDIO_DEVICE_CHANNELS];
+} AudioBusState;
+
+// The game thread's copy of a bus, the mixer's copy follows through commands
+typedef struct {
+	char name[32];
+	float32 gain;
+
+	struct {
+		AudioBusProcessFunction process;
+		AudioBusReleaseFunction release;
+		void *user_data;
+	} processors[AUDIO_BUS_MAX_PROCESSORS];
+	uint32 processor_count;
+} AudioBusInfo;
+
+static struct {
+	// Game thread
+	AudioBusInfo info[AUDIO_MAX_BUSES];
+	uint32 count;
+
+	// Mixer
+	AudioBusState state[AUDIO_MAX_BUSES];
+	uint32 channels;
+	uint32 sample_rate;
+	uint32 block_frames;
+} buses = { 0 };
+
+static AudioBus audio_bus_add(String name, AudioBus parent);
+
+_FORCE_INLINE_ void audio_bus_mark_dirty(AudioBusState *bus) {
+	bus->dirty_frames = buses.block_frames;
+}
+
+_FORCE_INLINE_ bool audio_bus_is_valid(AudioBus bus) {
+	return bus < buses.count;
+}
+
+void audio_bus_init(uint32 channels, uint32 sample_rate) {
+	LS_ASSERT(channels <= AUDIO_DEVICE_CHANNELS);
+
+	ls_memset(&buses, 0, sizeof(buses));
+	buses.channels = channels;
+	buses.sample_rate = sample_rate;
+
+	audio_bus_add("master", AUDIO_BUS_INVALID);
+	audio_bus_add("music", AUDIO_BUS_MASTER);
+	audio_bus_add("sfx", AUDIO_BUS_MASTER);
+	audio_bus_add("ui", AUDIO_BUS_MASTER);
+}
+
+void audio_bus_deinit() {
+	for (uint32 i = 0; i < buses.count; i++) {
+		AudioBusInfo *info = &buses.info[i];
+		for (uint32 j = 0; j < info->processor_count; j++) {
+			if (info->processors[j].release) {
+				info->processors[j].release(info->processors[j].user_data);
+			}
+		}
+	}
+
+	buses.count = 0;
+}
+
+AudioBus audio_bus_create(String name, AudioBus parent) {
+	if (!audio_bus_is_valid(parent)) {
+		ls_log(LOG_LEVEL_ERROR, "Invalid parent bus %u for %s\n", parent, name);
+		return AUDIO_BUS_INVALID;
+	}
+
+	if (audio_bus_find(name) != AUDIO_BUS_INVALID) {
+		ls_log(LOG_LEVEL_ERROR, "Audio bus %s already exists\n", name);
+		return AUDIO_BUS_INVALID;
+	}
+
+	if (buses.count == AUDIO_MAX_BUSES) {
+		ls_log(LOG_LEVEL_ERROR, "Can't create audio bus %s, all %d are taken\n", name, AUDIO_MAX_BUSES);
+		return AUDIO_BUS_INVALID;
+	}
+
+	return audio_bus_add(name, parent);
+}
+
+AudioBus audio_bus_find(String name) {
+	for (uint32 i = 0; i < buses.count; i++) {
+		if (ls_str_equals(buses.info[i].name, name)) {
+			return i;
+		}
+	}
+
+	return AUDIO_BUS_INVALID;
+}
+
+void audio_bus_set_gain(AudioBus bus, float32 gain) {
+	if (!audio_bus_is_valid(bus)) {
+		return;
+	}
+
+	buses.info[bus].gain = gain;
+	audio_server_send_command((AudioCommand){ .type = AUDIO_COMMAND_SET_BUS_GAIN, .bus = bus, .value = gain });
+}
+
+float32 audio_bus_get_gain(AudioBus bus) {
+	if (!audio_bus_is_valid(bus)) {
+		return 0.0f;
+	}
+
+	return buses.info[bus].gain;
+}
+
+bool audio_bus_add_processor(AudioBus bus, AudioBusProcessFunction process, AudioBusReleaseFunction release, void *user_data) {
+	if (!audio_bus_is_valid(bus) || process == NULL) {
+		return false;
+	}
+
+	AudioBusInfo *info = &buses.info[bus];
+	if (info->processor_count == AUDIO_BUS_MAX_PROCESSORS) {
+		ls_log(LOG_LEVEL_ERROR, "Audio bus %s already has %d processors\n", info->name, AUDIO_BUS_MAX_PROCESSORS);
+		return false;
+	}
+
+	info->processors[info->processor_count].process = process;
+	info->processors[info->processor_count].release = release;
+	info->processors[info->processor_count].user_data = user_data;
+	info->processor_count++;
+
+	AudioCommand command = { .type = AUDIO_COMMAND_ADD_BUS_PROCESSOR, .bus = bus };
+	command.processor.process = process;
+	command.processor.user_data = user_data;
+	audio_server_send_command(command);
+
+	return true;
+}
+
+void audio_bus_remove_processor(AudioBus bus, AudioBusProcessFunction process, void *user_data) {
+	if (!audio_bus_is_valid(bus)) {
+		return;
+	}
+
+	AudioBusInfo *info = &buses.info[bus];
+	for (uint32 i = 0; i < info->processor_count; i++) {
+		if (info->processors[i].process != process || info->processors[i].user_data != user_data) {
+			continue;
+		}
+
+		AudioBusReleaseFunction release = info->processors[i].release;
+		info->processor_count--;
+		ls_memmove(&info->processors[i], &info->processors[i + 1], (info->processor_count - i) * sizeof(info->processors[0]));
+
+		AudioCommand command = { .type = AUDIO_COMMAND_REMOVE_BUS_PROCESSOR, .bus = bus };
+		command.processor.process = process;
+		command.processor.user_data = user_data;
+		audio_server_send_command(command);
+
+		if (release) {
+			audio_server_release(release, user_data);
+		}
+
+		return;
+	}
+}
+
+void audio_bus_set_ducking(AudioBus bus, AudioBus trigger, float32 depth, float32 attack, float32 release) {
+	if (!audio_bus_is_valid(bus)) {
+		return;
+	}
+
+	if (trigger != AUDIO_BUS_INVALID && (!audio_bus_is_valid(trigger) || trigger == bus)) {
+		ls_log(LOG_LEVEL_ERROR, "Invalid ducking trigger %u for audio bus %s\n", trigger, buses.info[bus].name);
+		return;
+	}
+
+	AudioCommand command = { .type = AUDIO_COMMAND_SET_BUS_DUCKING, .bus = bus };
+	command.ducking.trigger = trigger;
+	command.ducking.depth = depth < 0.0f ? 0.0f : (depth > 1.0f ? 1.0f : depth);
+	command.ducking.attack = attack > 0.0f ? attack : 0.0f;
+	command.ducking.release = release > 0.0f ? release : 0.0f;
+	audio_server_send_command(command);
+}
+
+void audio_bus_clear_ducking(AudioBus bus) {
+	audio_bus_set_ducking(bus, AUDIO_BUS_INVALID, 1.0f, 0.0f, 0.0f);
+}
+
+// Mixer side
+
+void audio_bus_apply_command(AudioCommand command) {
+	AudioBusState *bus = &buses.state[command.bus];
+
+	switch (command.type) {
+		case AUDIO_COMMAND_CREATE_BUS: {
+			bus->is_active = true;
+			bus->parent = command.parent;
+			bus->gain = 1.0f;
+			bus->applied_gain = 1.0f;
+			bus->processor_count = 0;
+			bus->duck_trigger = AUDIO_BUS_INVALID;
+			bus->duck_gain = 1.0f;
+			bus->is_duck_trigger = false;
+			bus->level = 0.0f;
+			bus->dirty_frames = 0;
+		} break;
+		case AUDIO_COMMAND_SET_BUS_GAIN: {
+			bus->gain = command.value;
+		} break;
+		case AUDIO_COMMAND_ADD_BUS_PROCESSOR: {
+			if (bus->processor_count < AUDIO_BUS_MAX_PROCESSORS) {
+				bus->processors[bus->processor_count].process = command.processor.process;
+				bus->processors[bus->processor_count].user_data = command.processor.user_data;
+				bus->processor_count++;
+			}
+		} break;
+		case AUDIO_COMMAND_REMOVE_BUS_PROCESSOR: {
+			for (uint32 i = 0; i < bus->processor_count; i++) {
+				if (bus->processors[i].process == command.processor.process && bus->processors[i].user_data == command.processor.user_data) {
+					bus->processor_count--;
+					ls_memmove(&bus->processors[i], &bus->processors[i + 1], (bus->processor_count - i) * sizeof(AudioBusProcessor));
+					break;
+				}
+			}
+		} break;
+		case AUDIO_COMMAND_SET_BUS_DUCKING: {
+			bus->duck_trigger = command.ducking.trigger;
+			bus->duck_depth = command.ducking.depth;
+			bus->duck_attack = command.ducking.attack;
+			bus->duck_release = command.ducking.release;
+			if (bus->duck_trigger == AUDIO_BUS_INVALID) {
+				bus->duck_gain = 1.0f;
+			}
+
+			for (uint32 i = 0; i < AUDIO_MAX_BUSES; i++) {
+				buses.state[i].is_duck_trigger = false;
+			}
+			for (uint32 i = 0; i < AUDIO_MAX_BUSES; i++) {
+				if (buses.state[i].is_active && buses.state[i].duck_trigger != AUDIO_BUS_INVALID) {
+					buses.state[buses.state[i].duck_trigger].is_duck_trigger = true;
+				}
+			}
+		} break;
+
+		default: {
+			ls_log(LOG_LEVEL_ERROR, "Unknown audio bus command: %d\n", command.type);
+		} break;
+	}
+}
+
+void audio_bus_begin_block(uint32 frame_count) {
+	LS_ASSERT(frame_count <= AUDIO_BUS_BLOCK_FRAMES);
+	buses.block_frames = frame_count;
+
+	for (uint32 i = 0; i < AUDIO_MAX_BUSES; i++) {
+		AudioBusState *bus = &buses.state[i];
+		if (bus->dirty_frames > 0) {
+			ls_memset(bus->block, 0, bus->dirty_frames * buses.channels * sizeof(float32));
+			bus->dirty_frames = 0;
+		}
+	}
+}
+
+float32 *audio_bus_get_block(AudioBus bus) {
+	if (bus >= AUDIO_MAX_BUSES || !buses.state[bus].is_active) {
+		bus = AUDIO_BUS_MASTER;
+	}
+
+	audio_bus_mark_dirty(&buses.state[bus]);
+	return buses.state[bus].block;
+}
+
+// Moves the duck gain towards depth while the trigger sounds and back to 1 once it is quiet.
+static float32 audio_bus_update_ducking(AudioBusState *bus) {
+	if (bus->duck_trigger == AUDIO_BUS_INVALID) {
+		return 1.0f;
+	}
+
+	bool is_triggered = buses.state[bus->duck_trigger].level > AUDIO_BUS_DUCK_THRESHOLD;
+	float32 target = is_triggered ? bus->duck_depth : 1.0f;
+	float32 time = is_triggered ? bus->duck_attack : bus->duck_release;
+
+	// Linear in gain, the whole range from 1 to depth takes time seconds
+	float32 step = (1.0f - bus->duck_depth);
+	if (time > 0.0f) {
+		step *= (float32)buses.block_frames / (time * (float32)buses.sample_rate);
+	}
+
+	if (bus->duck_gain > target) {
+		bus->duck_gain = bus->duck_gain - step > target ? bus->duck_gain - step : target;
+	} else if (bus->duck_gain < target) {
+		bus->duck_gain = bus->duck_gain + step < target ? bus->duck_gain + step : target;
+	}
+
+	return bus->duck_gain;
+}
+
+static void audio_bus_measure(AudioBusState *bus, uint32 sample_count) {
+	float32 peak = 0.0f;
+	for (uint32 i = 0; i < sample_count; i++) {
+		float32 sample = math_absf(bus->block[i]);
+		if (sample > peak) {
+			peak = sample;
+		}
+	}
+
+	bus->level = peak;
+}
+
+void audio_bus_end_block(float32 *output) {
+	const uint32 frame_count = buses.block_frames;
+	const uint32 sample_count = frame_count * buses.channels;
+
+	// Children always come after their parent, so walking back runs every bus before the one it mixes into.
+	// A duck trigger mixed later than the bus it ducks is a block late, which the attack hides.
+	for (int32 i = AUDIO_MAX_BUSES - 1; i >= 0; i--) {
+		AudioBusState *bus = &buses.state[i];
+		if (!bus->is_active) {
+			continue;
+		}
+
+		float32 gain = bus->gain * audio_bus_update_ducking(bus);
+
+		if (bus->dirty_frames == 0 && bus->processor_count == 0) {
+			bus->level = 0.0f;
+			bus->applied_gain = gain;
+			continue;
+		}
+
+		// Processors may write a tail into a silent block
+		audio_bus_mark_dirty(bus);
+		for (uint32 j = 0; j < bus->processor_count; j++) {
+			bus->processors[j].process(bus->block, frame_count, buses.channels, bus->processors[j].user_data);
+		}
+
+		if (bus->is_duck_trigger) {
+			audio_bus_measure(bus, sample_count);
+		}
+
+		float32 *destination = output;
+		if (i != AUDIO_BUS_MASTER) {
+			AudioBusState *parent = &buses.state[bus->parent];
+			audio_bus_mark_dirty(parent);
+			destination = parent->block;
+		}
+
+		audio_mix_samples_ramp(destination, bus->block, frame_count, buses.channels, bus->applied_gain, gain);
+		bus->applied_gain = gain;
+	}
+}
+
+// Static functions
+
+static AudioBus audio_bus_add(String name, AudioBus parent) {
+	AudioBus bus = buses.count++;
+
+	AudioBusInfo *info = &buses.info[bus];
+	ls_str_copy_to(info->name, name, sizeof(info->name));
+	info->gain = 1.0f;
+	info->processor_count = 0;
+
+	audio_server_send_command((AudioCommand){ .type = AUDIO_COMMAND_CREATE_BUS, .bus = bus, .parent = parent });
+
+	return bus;
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef AUDIO_BUS_H
+#define AUDIO_BUS_H
+
+#include "core/core.h"
+
+// Every voice plays into a bus, buses mix into their parent and the master bus into the device.
+// Gain, processors and ducking are applied once per bus on the mixed block, not per voice.
+// Buses are identified by index, the built in ones always exist.
+typedef uint32 AudioBus;
+
+#define AUDIO_BUS_MASTER 0
+#define AUDIO_BUS_MUSIC 1
+#define AUDIO_BUS_SFX 2
+#define AUDIO_BUS_UI 3
+#define AUDIO_BUS_INVALID 0xFFFFFFFF
+
+// Runs on the audio thread on a bus's interleaved block before its gain is applied, it must not block or allocate.
+typedef void (*AudioBusProcessFunction)(float32 *frames, uint32 frame_count, uint32 channels, void *user_data);
+// Called on the game thread once the mixer let go of a processor's user data.
+typedef void (*AudioBusReleaseFunction)(void *user_data);
+
+// Creates a bus mixing into parent, returns AUDIO_BUS_INVALID when every bus is taken.
+LS_EXPORT AudioBus audio_bus_create(String name, AudioBus parent);
+// Returns the bus called name, or AUDIO_BUS_INVALID.
+LS_EXPORT AudioBus audio_bus_find(String name);
+
+// Set the gain of the bus, 1 by default
+LS_EXPORT void audio_bus_set_gain(AudioBus bus, float32 gain);
+LS_EXPORT float32 audio_bus_get_gain(AudioBus bus);
+
+// Appends a processor to the bus's chain, returns false when the chain is full. release may be NULL.
+LS_EXPORT bool audio_bus_add_processor(AudioBus bus, AudioBusProcessFunction process, AudioBusReleaseFunction release, void *user_data);
+// Removes the processor, release is called with its user data once the mixer can't run it anymore.
+LS_EXPORT void audio_bus_remove_processor(AudioBus bus, AudioBusProcessFunction process, void *user_data);
+
+// Lowers the bus to depth of its gain while trigger has signal, e.g. music under dialogue.
+// attack and release are the seconds the duck takes to reach depth and to let go again.
+LS_EXPORT void audio_bus_set_ducking(AudioBus bus, AudioBus trigger, float32 depth, float32 attack, float32 release);
+LS_EXPORT void audio_bus_clear_ducking(AudioBus bus);
+
+#endif // AUDIO_BUS_H
\ No newline at end of file
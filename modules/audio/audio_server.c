@@ -1,58 +1,78 @@
 #include "audio_server.h"
 
 #include "core/core.h"
+#include "internal/atomic.h"
 #include "internal/audio_buffer.h"
+#include "internal/audio_bus.h"
 #include "internal/audio_server.h"
+#include "internal/command_queue.h"
+#include "internal/mix.h"
+#include "internal/stream_decoder.h"
+#include "internal/voice_pool.h"
 
-#include <miniaudio.h>
+#include "main/lunar_sprites.h"
 
-struct AudioProcessor {
-	AudioCallback process;
-	AudioProcessor *next;
-	AudioProcessor *prev;
-};
+#include <miniaudio.h>
 
 typedef struct {
 	struct {
 		ma_context context;
 		ma_device device;
-		ma_mutex lock;
 		bool is_ready;
+		// The device callback is running and consumes the command queue
+		bool is_running;
 		size_t pcm_buffer_size;
 		void *pcm_buffer;
+		// Callbacks whose mix took longer than the audio it produced
+		volatile uint32 overruns;
 	} Server;
 
+	// Buffers the mixer walks, playing or paused. Only touched by whichever thread applies commands.
 	struct {
-		AudioBuffer *first;
-		AudioBuffer *last;
-		uint32 default_size;
-	} Buffer;
+		AudioBuffer *playing[AUDIO_MAX_PLAYING_BUFFERS];
+		uint32 playing_count;
+	} Voices;
 
-	AudioProcessor *mixed_processor;
+	// Game thread side of the command queue
+	struct {
+		AudioCommandQueue queue;
+		// Commands that found the queue full, they go out before any newer command
+		AudioCommandArray deferred;
+		// Releases waiting for the mixer to reach them
+		PtrArray releasing;
+	} Commands;
 } Audio;
 
 static Audio AUDIO = {
-	.Buffer.default_size = 0,
-	.mixed_processor = NULL
+	.Voices.playing_count = 0,
 };
 
 static void on_log(void *p_user_data, uint32 level, String message);
 static void on_send_audio_data(ma_device *device, void *output, const void *input, uint32 frame_count);
-static void mix_audio_frames(float32 *frames_out, const float *frames_in, uint32 frame_count, AudioBuffer *buffer);
+static void mix_audio_frames(float32 *frames_out, const float32 *frames_in, uint32 frame_count, AudioBuffer *buffer);
+static void mix_device_format_voice(float32 *frames_out, uint32 frame_count, AudioBuffer *buffer);
+static void mix_voice(float32 *frames_out, uint32 frame_count, AudioBuffer *buffer);
+
+static void audio_server_apply_command(AudioCommand command);
+static void audio_server_flush_deferred();
+static void audio_server_collect_releases();
+static void audio_server_on_update(float64 delta_time);
+static void release_buffer(void *data);
 
 static void audio_server_start_device();
 #if defined(WEB_ENABLED)
 static void audio_server_event_handler(Event *event, void *user_data);
 #endif // WEB_ENABLED
 
-void audio_server_init(LSCore *p_core) {
+// Creates the context and device on the given backends, NULL picks the platform defaults.
+static bool audio_server_create_device(const ma_backend *backends, uint32 backend_count) {
 	ma_context_config ctx_config = ma_context_config_init();
 	ma_log_callback_init(on_log, NULL);
 
-	ma_result result = ma_context_init(NULL, 0, &ctx_config, &AUDIO.Server.context);
+	ma_result result = ma_context_init(backends, backend_count, &ctx_config, &AUDIO.Server.context);
 	if (result != MA_SUCCESS) {
 		ls_log(LOG_LEVEL_ERROR, "Failed to initialize audio context\n");
-		return;
+		return false;
 	}
 
 	ma_device_config config = ma_device_config_init(ma_device_type_playback);
@@ -70,9 +90,23 @@ void audio_server_init(LSCore *p_core) {
 	if (result != MA_SUCCESS) {
 		ls_log(LOG_LEVEL_ERROR, "Failed to initialize audio device\n");
 		ma_context_uninit(&AUDIO.Server.context);
+		return false;
+	}
+
+	audio_command_queue_init(&AUDIO.Commands.queue);
+	audio_bus_init(AUDIO.Server.device.playback.channels, AUDIO.Server.device.sampleRate);
+	voice_pool_init(AUDIO_VOICE_POOL_SIZE);
+
+	return true;
+}
+
+void audio_server_init(LSCore *p_core) {
+	if (!audio_server_create_device(NULL, 0)) {
 		return;
 	}
 
+	ls_register_update_callback(audio_server_on_update);
+
 // We must wait to start the device until we get user input on the web
 #if !defined(WEB_ENABLED)
 	audio_server_start_device();
@@ -81,55 +115,69 @@ void audio_server_init(LSCore *p_core) {
 #endif // !WEB_ENABLED
 }
 
+void audio_server_init_offline() {
+	ma_backend backend = ma_backend_null;
+	if (!audio_server_create_device(&backend, 1)) {
+		return;
+	}
+
+	AUDIO.Server.is_ready = true;
+}
+
 void audio_server_deinit() {
 	if (!AUDIO.Server.is_ready) {
 		ls_log(LOG_LEVEL_WARNING, "Audio Server is not initialized\n");
 		return;
 	}
 
-	ma_mutex_uninit(&AUDIO.Server.lock);
 	ma_device_uninit(&AUDIO.Server.device);
 	ma_context_uninit(&AUDIO.Server.context);
 
+	// The callback is gone, apply what it didn't get to so pending releases go through
+	AUDIO.Server.is_running = false;
+
+	AudioCommand command;
+	while (audio_command_queue_pop(&AUDIO.Commands.queue, &command)) {
+		audio_server_apply_command(command);
+	}
+	for (size_t i = 0; i < AUDIO.Commands.deferred.size; i++) {
+		audio_server_apply_command(AUDIO.Commands.deferred.data[i]);
+	}
+	audio_command_array_destroy(&AUDIO.Commands.deferred);
+
+	audio_server_collect_releases();
+	ptr_array_destroy(&AUDIO.Commands.releasing);
+
+	audio_bus_deinit();
+	voice_pool_deinit();
+	AUDIO.Voices.playing_count = 0;
+
+	stream_decoder_deinit();
+
 	AUDIO.Server.is_ready = false;
 
 	ls_log(LOG_LEVEL_INFO, "Audio Server deinitialized successfully\n");
 }
 
-void audio_server_track_buffer(AudioBuffer *p_buffer) {
-	ma_mutex_lock(&AUDIO.Server.lock);
-	{
-		if (AUDIO.Buffer.first == NULL) {
-			AUDIO.Buffer.first = p_buffer;
-		} else {
-			AUDIO.Buffer.last->next = p_buffer;
-			p_buffer->prev = AUDIO.Buffer.last;
-		}
+void audio_server_untrack_buffer(AudioBuffer *p_buffer) {
+	audio_server_send_command((AudioCommand){ .type = AUDIO_COMMAND_REMOVE_VOICE, .buffer = p_buffer });
+	audio_server_release(release_buffer, p_buffer);
+}
 
-		AUDIO.Buffer.last = p_buffer;
-	}
-	ma_mutex_unlock(&AUDIO.Server.lock);
+void audio_server_set_max_voices(uint32 max_voices) {
+	voice_pool_set_max_voices(max_voices);
 }
 
-void audio_server_untrack_buffer(AudioBuffer *p_buffer) {
-	ma_mutex_lock(&AUDIO.Server.lock);
-	{
-		if (p_buffer->prev == NULL) {
-			AUDIO.Buffer.first = p_buffer->next;
-		} else {
-			p_buffer->prev->next = p_buffer->next;
-		}
+uint32 audio_server_get_max_voices() {
+	return voice_pool_get_max_voices();
+}
 
-		if (p_buffer->next == NULL) {
-			AUDIO.Buffer.last = p_buffer->prev;
-		} else {
-			p_buffer->next->prev = p_buffer->prev;
-		}
+uint32 audio_server_get_active_voice_count() {
+	return voice_pool_get_busy_count();
+}
 
-		p_buffer->next = NULL;
-		p_buffer->prev = NULL;
-	}
-	ma_mutex_unlock(&AUDIO.Server.lock);
+uint32 audio_server_get_overrun_count() {
+	return audio_atomic_load(&AUDIO.Server.overruns);
 }
 
 // Internal functions
@@ -138,6 +186,30 @@ ma_device audio_server_get_device() {
 	return AUDIO.Server.device;
 }
 
+void audio_server_send_command(AudioCommand command) {
+	if (!AUDIO.Server.is_running) {
+		// Nothing consumes the queue while the device is stopped, so the mixer state is ours
+		audio_server_apply_command(command);
+		return;
+	}
+
+	audio_server_flush_deferred();
+	if (AUDIO.Commands.deferred.size > 0 || !audio_command_queue_push(&AUDIO.Commands.queue, command)) {
+		audio_command_array_append(&AUDIO.Commands.deferred, command);
+	}
+}
+
+void audio_server_release(AudioReleaseFunction destroy, void *data) {
+	AudioRelease *release = (AudioRelease *)ls_malloc(sizeof(AudioRelease));
+	release->is_released = 0;
+	release->destroy = destroy;
+	release->data = data;
+
+	ptr_array_append(&AUDIO.Commands.releasing, release);
+	audio_server_send_command((AudioCommand){ .type = AUDIO_COMMAND_RELEASE, .release = release });
+	audio_server_collect_releases();
+}
+
 // Static functions
 
 static void audio_server_start_device() {
@@ -157,6 +229,205 @@ static void audio_server_start_device() {
 	ls_log(LOG_LEVEL_INFO, "Audio Server period size:	%d\n", AUDIO.Server.device.playback.internalPeriodSizeInFrames * AUDIO.Server.device.playback.internalPeriods);
 
 	AUDIO.Server.is_ready = true;
+	AUDIO.Server.is_running = true;
+}
+
+static void audio_server_flush_deferred() {
+	if (audio_command_array_is_empty(&AUDIO.Commands.deferred)) {
+		return;
+	}
+
+	size_t sent = 0;
+	while (sent < AUDIO.Commands.deferred.size && audio_command_queue_push(&AUDIO.Commands.queue, AUDIO.Commands.deferred.data[sent])) {
+		sent++;
+	}
+
+	audio_command_array_remove_range(&AUDIO.Commands.deferred, 0, sent);
+}
+
+static void audio_server_collect_releases() {
+	for (size_t i = 0; i < AUDIO.Commands.releasing.size;) {
+		AudioRelease *release = AUDIO.Commands.releasing.data[i];
+		if (!audio_atomic_load(&release->is_released)) {
+			i++;
+			continue;
+		}
+
+		release->destroy(release->data);
+		ls_free(release);
+		ptr_array_swap_remove(&AUDIO.Commands.releasing, i);
+	}
+}
+
+static void audio_server_on_update(float64 delta_time) {
+	audio_server_flush_deferred();
+	audio_server_collect_releases();
+}
+
+static void release_buffer(void *data) {
+	audio_buffer_free((AudioBuffer *)data);
+}
+
+// Publishes the mixer's view of a buffer to the game thread.
+static void voice_publish_state(AudioBuffer *buffer) {
+	uint32 state = 0;
+	if (buffer->is_playing) {
+		state |= AUDIO_BUFFER_STATE_PLAYING;
+	}
+	if (buffer->is_paused) {
+		state |= AUDIO_BUFFER_STATE_PAUSED;
+	}
+
+	audio_atomic_store(&buffer->state, state);
+}
+
+static void voice_stop(AudioBuffer *buffer) {
+	buffer->is_playing = false;
+	buffer->is_paused = false;
+	buffer->frame_index = 0;
+	buffer->frames_processed = 0;
+	audio_atomic_store(&buffer->is_sub_buffer_processed[0], 1);
+	audio_atomic_store(&buffer->is_sub_buffer_processed[1], 1);
+
+	voice_publish_state(buffer);
+}
+
+// Drops the buffers that stopped from the playing list, keeping the order they started in.
+static void voice_compact_playing() {
+	uint32 kept = 0;
+	for (uint32 i = 0; i < AUDIO.Voices.playing_count; i++) {
+		AudioBuffer *buffer = AUDIO.Voices.playing[i];
+		if (!buffer->is_playing) {
+			buffer->playing_index = -1;
+			continue;
+		}
+
+		buffer->playing_index = (int32)kept;
+		AUDIO.Voices.playing[kept++] = buffer;
+	}
+
+	AUDIO.Voices.playing_count = kept;
+}
+
+// Puts the buffer in the playing list unless it already is, a full list refuses it.
+static bool voice_add_playing(AudioBuffer *buffer) {
+	if (buffer->playing_index >= 0) {
+		return true;
+	}
+
+	// Stopped buffers only leave after a mix, which never comes while the device is stopped
+	if (AUDIO.Voices.playing_count == AUDIO_MAX_PLAYING_BUFFERS) {
+		voice_compact_playing();
+	}
+
+	if (AUDIO.Voices.playing_count == AUDIO_MAX_PLAYING_BUFFERS) {
+		return false;
+	}
+
+	buffer->playing_index = (int32)AUDIO.Voices.playing_count;
+	AUDIO.Voices.playing[AUDIO.Voices.playing_count++] = buffer;
+
+	return true;
+}
+
+static void voice_remove_playing(AudioBuffer *buffer) {
+	if (buffer->playing_index < 0) {
+		return;
+	}
+
+	AudioBuffer *last = AUDIO.Voices.playing[--AUDIO.Voices.playing_count];
+	AUDIO.Voices.playing[buffer->playing_index] = last;
+	last->playing_index = buffer->playing_index;
+	buffer->playing_index = -1;
+}
+
+static void voice_start(AudioBuffer *buffer) {
+	buffer->is_playing = voice_add_playing(buffer);
+	buffer->is_paused = false;
+	buffer->frame_index = 0;
+	voice_publish_state(buffer);
+}
+
+static void voice_set_pitch(AudioBuffer *buffer, float32 pitch) {
+	uint32 output_sample_rate = (uint32)((float32)buffer->base_sample_rate_out / pitch);
+	ma_data_converter_set_rate(&buffer->converter, buffer->converter.sampleRateIn, output_sample_rate);
+	buffer->pitch = pitch;
+}
+
+static void audio_server_apply_command(AudioCommand command) {
+	AudioBuffer *buffer = command.buffer;
+
+	switch (command.type) {
+		case AUDIO_COMMAND_REMOVE_VOICE: {
+			voice_remove_playing(buffer);
+			buffer->is_playing = false;
+		} break;
+		case AUDIO_COMMAND_PLAY: {
+			voice_start(buffer);
+		} break;
+		case AUDIO_COMMAND_STOP: {
+			voice_stop(buffer);
+		} break;
+		case AUDIO_COMMAND_PAUSE: {
+			buffer->is_paused = true;
+			voice_publish_state(buffer);
+		} break;
+		case AUDIO_COMMAND_RESUME: {
+			buffer->is_paused = false;
+			voice_publish_state(buffer);
+		} break;
+		case AUDIO_COMMAND_SET_VOLUME: {
+			buffer->volume = command.value;
+		} break;
+		case AUDIO_COMMAND_SET_PAN: {
+			buffer->pan = command.value;
+		} break;
+		case AUDIO_COMMAND_SET_PITCH: {
+			voice_set_pitch(buffer, command.value);
+		} break;
+		case AUDIO_COMMAND_SET_LOOPING: {
+			buffer->is_looping = command.enabled;
+		} break;
+		case AUDIO_COMMAND_RESTART_STREAM: {
+			buffer->frame_index = 0;
+			audio_atomic_store(&buffer->stream_generation, command.generation);
+			stream_decoder_wake();
+		} break;
+		case AUDIO_COMMAND_START_VOICE: {
+			buffer->data = (uint8 *)command.voice.data;
+			buffer->frame_count = command.voice.frame_count;
+			buffer->frames_processed = 0;
+			buffer->volume = command.voice.volume;
+			buffer->pan = command.voice.pan;
+			buffer->bus = command.bus;
+
+			if (buffer->pitch != command.voice.pitch) {
+				voice_set_pitch(buffer, command.voice.pitch);
+			}
+
+			voice_start(buffer);
+			// After the state, so the game thread never pairs this generation with an older state
+			audio_atomic_store(&buffer->voice_generation, command.voice.generation);
+		} break;
+		case AUDIO_COMMAND_SET_VOICE_BUS: {
+			buffer->bus = command.bus;
+		} break;
+		case AUDIO_COMMAND_CREATE_BUS:
+		case AUDIO_COMMAND_SET_BUS_GAIN:
+		case AUDIO_COMMAND_ADD_BUS_PROCESSOR:
+		case AUDIO_COMMAND_REMOVE_BUS_PROCESSOR:
+		case AUDIO_COMMAND_SET_BUS_DUCKING: {
+			audio_bus_apply_command(command);
+		} break;
+		case AUDIO_COMMAND_RELEASE: {
+			// Every command before this one is applied, nothing queued can reach the data anymore
+			audio_atomic_store(&command.release->is_released, 1);
+		} break;
+
+		default: {
+			ls_log(LOG_LEVEL_ERROR, "Unknown audio command: %d\n", command.type);
+		} break;
+	}
 }
 
 static void on_log(void *p_user_data, uint32 level, String message) {
@@ -188,6 +459,14 @@ static uint32 read_buffer_internal(AudioBuffer *buffer, uint8 *p_output, uint32
 		return frame_count;
 	}
 
+	uint32 frame_size_bytes = ma_get_bytes_per_frame(buffer->converter.formatIn, buffer->converter.channelsIn);
+
+	// Silent until the decoder filled the sub buffers for the last restart
+	if (buffer->usage == AUDIO_BUFFER_USAGE_STREAM && audio_atomic_load(&buffer->filled_generation) != buffer->stream_generation) {
+		ls_memset(p_output, 0, frame_count * frame_size_bytes);
+		return frame_count;
+	}
+
 	uint32 sub_buffer_frame_count = (buffer->frame_count > 1) ? buffer->frame_count / 2 : buffer->frame_count;
 	uint32 current_sub_buffer_index = buffer->frame_index / sub_buffer_frame_count;
 
@@ -196,10 +475,8 @@ static uint32 read_buffer_internal(AudioBuffer *buffer, uint8 *p_output, uint32
 	}
 
 	bool is_sub_buffer_processed[2] = { 0 };
-	is_sub_buffer_processed[0] = buffer->is_sub_buffer_processed[0];
-	is_sub_buffer_processed[1] = buffer->is_sub_buffer_processed[1];
-
-	uint32 frame_size_bytes = ma_get_bytes_per_frame(buffer->converter.formatIn, buffer->converter.channelsIn);
+	is_sub_buffer_processed[0] = audio_atomic_load(&buffer->is_sub_buffer_processed[0]);
+	is_sub_buffer_processed[1] = audio_atomic_load(&buffer->is_sub_buffer_processed[1]);
 
 	uint32 frames_read = 0;
 	while (true) {
@@ -223,7 +500,7 @@ static uint32 read_buffer_internal(AudioBuffer *buffer, uint8 *p_output, uint32
 			frames_remaining_in_output = buffer->frame_count - buffer->frame_index;
 		} else {
 			uint32 first_frame_index = sub_buffer_frame_count * current_sub_buffer_index;
-			frames_remaining_in_output = sub_buffer_frame_count - (buffer->frame_count - first_frame_index);
+			frames_remaining_in_output = sub_buffer_frame_count - (buffer->frame_index - first_frame_index);
 		}
 
 		uint32 frames_to_read = total_frames_remaining;
@@ -236,18 +513,33 @@ static uint32 read_buffer_internal(AudioBuffer *buffer, uint8 *p_output, uint32
 		frames_read += frames_to_read;
 
 		if (frames_to_read == frames_remaining_in_output) {
-			buffer->is_sub_buffer_processed[current_sub_buffer_index] = true;
+			audio_atomic_store(&buffer->is_sub_buffer_processed[current_sub_buffer_index], 1);
 			is_sub_buffer_processed[current_sub_buffer_index] = true;
 
+			if (buffer->usage == AUDIO_BUFFER_USAGE_STREAM) {
+				if (audio_atomic_load(&buffer->stream_end) == current_sub_buffer_index + 1) {
+					voice_stop(buffer);
+					break;
+				}
+
+				stream_decoder_wake();
+			}
+
 			current_sub_buffer_index = (current_sub_buffer_index + 1) % 2;
 
 			if (!buffer->is_looping) {
-				audio_buffer_stop(buffer);
+				voice_stop(buffer);
 				break;
 			}
 		}
 	}
 
+	if (buffer->usage == AUDIO_BUFFER_USAGE_STREAM && buffer->is_playing) {
+		uint32 sub_buffer_index = buffer->frame_index / sub_buffer_frame_count;
+		uint32 position = audio_atomic_load(&buffer->sub_buffer_start[sub_buffer_index]) + buffer->frame_index - sub_buffer_index * sub_buffer_frame_count;
+		audio_atomic_store(&buffer->stream_position, position);
+	}
+
 	uint32 total_frames_remaining = (frame_count - frames_read);
 
 	if (total_frames_remaining > 0) {
@@ -262,7 +554,8 @@ static uint32 read_buffer_internal(AudioBuffer *buffer, uint8 *p_output, uint32
 }
 
 static uint32 read_buffer_frames_mixing(AudioBuffer *buffer, float32 *p_output, uint32 frame_count) {
-	uint8 input_buffer[4096] = { 0 };
+	// Only the frames read are converted, no need to clear it
+	uint8 input_buffer[4096];
 	uint32 input_buffer_frame_cap = sizeof(input_buffer) / ma_get_bytes_per_frame(buffer->converter.formatIn, buffer->converter.channelsIn);
 
 	uint32 total_output_frames_processed = 0;
@@ -296,108 +589,151 @@ static uint32 read_buffer_frames_mixing(AudioBuffer *buffer, float32 *p_output,
 }
 
 static void on_send_audio_data(ma_device *p_device, void *p_output, const void *p_input, uint32 frame_count) {
-	ls_memset(p_output, 0, frame_count * p_device->playback.internalChannels * ma_get_bytes_per_sample(p_device->playback.internalFormat));
+	profiler_set_thread_realtime("Audio");
+
+	LS_PROFILE_BEGIN("audio_callback");
+	uint64 start = os_get_time();
+	audio_server_mix(p_output, frame_count);
+	uint64 elapsed = os_get_time() - start;
+	LS_PROFILE_END();
+
+	// The callback has as long as the frames it produced take to play
+	if (elapsed * p_device->sampleRate > (uint64)frame_count * 1000000) {
+		audio_atomic_increment(&AUDIO.Server.overruns);
+	}
+}
+
+void audio_server_mix(void *p_output, uint32 frame_count) {
+	const uint32 channels = AUDIO.Server.device.playback.channels;
+	ls_memset(p_output, 0, frame_count * channels * ma_get_bytes_per_sample(AUDIO.Server.device.playback.format));
 
-	ma_mutex_lock(&AUDIO.Server.lock);
-	{
-		for (AudioBuffer *buffer = AUDIO.Buffer.first; buffer != NULL; buffer = buffer->next) {
+	AudioCommand command;
+	while (audio_command_queue_pop(&AUDIO.Commands.queue, &command)) {
+		audio_server_apply_command(command);
+	}
+
+	// Voices mix into their bus a block at a time, then the buses run once per block into the output
+	for (uint32 frames_mixed = 0; frames_mixed < frame_count; frames_mixed += AUDIO_BUS_BLOCK_FRAMES) {
+		uint32 block_frames = frame_count - frames_mixed;
+		if (block_frames > AUDIO_BUS_BLOCK_FRAMES) {
+			block_frames = AUDIO_BUS_BLOCK_FRAMES;
+		}
+
+		audio_bus_begin_block(block_frames);
+
+		for (uint32 i = 0; i < AUDIO.Voices.playing_count; i++) {
+			AudioBuffer *buffer = AUDIO.Voices.playing[i];
 			if (!buffer->is_playing || buffer->is_paused) {
 				continue;
 			}
 
-			uint32 frames_read = 0;
-
-			while (frame_count > frames_read) {
-				uint32 frames_to_read = (frame_count - frames_read);
-
-				while (frames_to_read > 0) {
-					float32 temp_buffer[1024] = { 0 };
-
-					uint32 frames_to_read_now = frames_to_read;
-					if (frames_to_read_now > sizeof(temp_buffer) / sizeof(temp_buffer[0]) / AUDIO_DEVICE_CHANNELS) {
-						frames_to_read_now = sizeof(temp_buffer) / sizeof(temp_buffer[0]) / AUDIO_DEVICE_CHANNELS;
-					}
-
-					uint32 frames_just_read = read_buffer_frames_mixing(buffer, temp_buffer, frames_to_read_now);
-					if (frames_just_read >= 0) {
-						float32 *frames_out = (float32 *)p_output + (frames_read * AUDIO.Server.device.playback.channels);
-						float32 *frames_in = temp_buffer;
-
-						AudioProcessor *processor = buffer->processor;
-						while (processor) {
-							processor->process(frames_in, frames_just_read);
-							processor = processor->next;
-						}
-
-						mix_audio_frames(frames_out, frames_in, frames_just_read, buffer);
-
-						frames_to_read -= frames_just_read;
-						frames_read += frames_just_read;
-					}
-
-					if (!buffer->is_playing) {
-						frames_read = frame_count;
-						break;
-					}
-
-					if (frames_just_read < frames_to_read_now) {
-						if (!buffer->is_looping) {
-							audio_buffer_stop(buffer);
-							break;
-						} else {
-							buffer->frame_index = 0;
-							continue;
-						}
-					}
-				}
+			mix_voice(audio_bus_get_block(buffer->bus), block_frames, buffer);
+		}
+
+		audio_bus_end_block((float32 *)p_output + (size_t)frames_mixed * channels);
+	}
+
+	voice_compact_playing();
+}
+
+static void mix_voice(float32 *frames_out, uint32 frame_count, AudioBuffer *buffer) {
+	if (buffer->is_device_format && buffer->pitch == 1.0f && buffer->usage == AUDIO_BUFFER_USAGE_STATIC && buffer->callback == NULL) {
+		mix_device_format_voice(frames_out, frame_count, buffer);
+		return;
+	}
+
+	uint32 frames_read = 0;
+
+	while (frame_count > frames_read) {
+		uint32 frames_to_read = (frame_count - frames_read);
+
+		while (frames_to_read > 0) {
+			float32 temp_buffer[1024];
+
+			uint32 frames_to_read_now = frames_to_read;
+			if (frames_to_read_now > sizeof(temp_buffer) / sizeof(temp_buffer[0]) / AUDIO_DEVICE_CHANNELS) {
+				frames_to_read_now = sizeof(temp_buffer) / sizeof(temp_buffer[0]) / AUDIO_DEVICE_CHANNELS;
+			}
+
+			uint32 frames_just_read = read_buffer_frames_mixing(buffer, temp_buffer, frames_to_read_now);
+			if (frames_just_read >= 0) {
+				mix_audio_frames(frames_out + (frames_read * AUDIO.Server.device.playback.channels), temp_buffer, frames_just_read, buffer);
+
+				frames_to_read -= frames_just_read;
+				frames_read += frames_just_read;
+			}
 
-				if (frames_to_read == 0) {
+			if (!buffer->is_playing) {
+				frames_read = frame_count;
+				break;
+			}
+
+			if (frames_just_read < frames_to_read_now) {
+				if (!buffer->is_looping) {
+					voice_stop(buffer);
 					break;
+				} else {
+					buffer->frame_index = 0;
+					continue;
 				}
 			}
 		}
-	}
 
-	AudioProcessor *processor = AUDIO.mixed_processor;
-	while (processor) {
-		processor->process(p_output, frame_count);
-		processor = processor->next;
+		if (frames_to_read == 0) {
+			break;
+		}
 	}
-
-	ma_mutex_unlock(&AUDIO.Server.lock);
 }
 
-static void mix_audio_frames(float32 *frames_out, const float *frames_in, uint32 frame_count, AudioBuffer *buffer) {
+static void mix_audio_frames(float32 *frames_out, const float32 *frames_in, uint32 frame_count, AudioBuffer *buffer) {
 	const float32 local_volume = buffer->volume;
 	const uint32 channels = AUDIO.Server.device.playback.channels;
 
 	if (channels != 2) { // We consider panning only for stereo
-		for (uint32 frame = 0; frame < frame_count; frame++) {
-			for (uint32 c = 0; c < channels; c++) {
-				float32 *frame_out = frames_out + (frame * channels);
-				const float32 *frame_in = frames_in + (frame * channels);
-
-				frame_out[c] += (frame_in[c] * local_volume);
-			}
-		}
-
+		const float32 gains[4] = { local_volume, local_volume, local_volume, local_volume };
+		audio_mix_samples(frames_out, frames_in, frame_count * channels, gains);
 		return;
 	}
 
 	const float32 left = buffer->pan;
 	const float32 right = 1.0f - left;
 
-	const float32 levels[2] = { local_volume * 0.5f * left * (3.0f - left * left), local_volume * 0.5f * right * (3.0f - right * right) };
+	const float32 left_level = local_volume * 0.5f * left * (3.0f - left * left);
+	const float32 right_level = local_volume * 0.5f * right * (3.0f - right * right);
+	const float32 gains[4] = { left_level, right_level, left_level, right_level };
 
-	float32 *frame_out = frames_out;
-	const float32 *frame_in = frames_in;
+	audio_mix_samples(frames_out, frames_in, frame_count * 2, gains);
+}
 
-	for (uint32 frame = 0; frame < frame_count; frame++) {
-		frame_out[0] += (frame_in[0] * levels[0]);
-		frame_out[1] += (frame_in[1] * levels[1]);
+// Mixes a static buffer straight from its data, it has to be in the device format already.
+static void mix_device_format_voice(float32 *frames_out, uint32 frame_count, AudioBuffer *buffer) {
+	const uint32 channels = AUDIO.Server.device.playback.channels;
+
+	if (buffer->frame_count == 0) {
+		voice_stop(buffer);
+		return;
+	}
+
+	uint32 frames_mixed = 0;
+	while (frames_mixed < frame_count && buffer->is_playing) {
+		uint32 frames_to_mix = buffer->frame_count - buffer->frame_index;
+		if (frames_to_mix > frame_count - frames_mixed) {
+			frames_to_mix = frame_count - frames_mixed;
+		}
 
-		frame_out += 2;
-		frame_in += 2;
+		const float32 *frames_in = (const float32 *)buffer->data + (size_t)buffer->frame_index * channels;
+		mix_audio_frames(frames_out + (size_t)frames_mixed * channels, frames_in, frames_to_mix, buffer);
+
+		buffer->frame_index += frames_to_mix;
+		buffer->frames_processed += frames_to_mix;
+		frames_mixed += frames_to_mix;
+
+		if (buffer->frame_index >= buffer->frame_count) {
+			buffer->frame_index = 0;
+			if (!buffer->is_looping) {
+				voice_stop(buffer);
+			}
+		}
 	}
 }
 
@@ -4,14 +4,31 @@
 #include "core/core.h"
 
 typedef struct AudioBuffer AudioBuffer;
-typedef struct AudioProcessor AudioProcessor;
 
 typedef void (*AudioCallback)(void *buffer_data, uint32 frames);
 
 void audio_server_init(LSCore *core);
+// Initializes the server on miniaudio's null backend without starting the device.
+// Nothing is mixed until audio_server_mix is called, used by the headless benchmarks.
+void audio_server_init_offline();
 void audio_server_deinit();
 
-void audio_server_track_buffer(AudioBuffer *buffer);
+// Removes the buffer from the mixer and frees it once the audio thread is done with it.
+// Game thread only like every call that changes a buffer.
 void audio_server_untrack_buffer(AudioBuffer *buffer);
 
+// Applies the queued commands and mixes every playing buffer into output, frame_count interleaved
+// frames in the device format.
+void audio_server_mix(void *output, uint32 frame_count);
+
+// Caps how many sounds play at once, at most AUDIO_VOICE_POOL_SIZE. Past it a new sound steals the oldest
+// voice of the lowest priority that isn't above its own, or doesn't play at all.
+LS_EXPORT void audio_server_set_max_voices(uint32 max_voices);
+LS_EXPORT uint32 audio_server_get_max_voices();
+// Sound voices playing or paused right now
+LS_EXPORT uint32 audio_server_get_active_voice_count();
+
+// Number of device callbacks that took longer to mix than the audio they produced, each one is a likely dropout.
+LS_EXPORT uint32 audio_server_get_overrun_count();
+
 #endif // AUDIO_SERVER_H
\ No newline at end of file
@@ -1,24 +1,61 @@
 #include "audio_stream.h"
 
+#include "internal/atomic.h"
 #include "internal/audio_buffer.h"
 #include "internal/audio_server.h"
+#include "internal/stream_decoder.h"
+#include "internal/voice_pool.h"
 #include "internal/wave.h"
 
+#if defined(AUDIO_SUPPORT_WAV)
+#include <dr_wav.h>
+#endif // AUDIO_SUPPORT_WAV
+
+// Frames per half of a music stream buffer, about 180ms at 44.1kHz.
+// 128KB per stereo track, the decoder refills a half while the other plays.
+#define MUSIC_SUB_BUFFER_FRAMES 8192
+
 struct AudioStream {
 	AudioBuffer *buffer;
-	AudioProcessor *processor;
 
 	uint32 sampleRate;
 	uint32 sampleSize;
 	uint32 channels;
 };
 
+// Sounds hold their PCM in the device format and play it on pooled voices, so playing never allocates
 struct Sound {
 	AudioStream stream;
 	uint32 frame_count;
+
+	uint8 *data;
+	bool owns_data;
+
+	// Applied to every voice the sound starts
+	float32 volume;
+	float32 pitch;
+	float32 pan;
+	int32 priority;
+	uint32 max_instances;
+	AudioBus bus;
+};
+
+struct Music {
+	AudioStream stream;
+	StreamSource source;
+#if defined(AUDIO_SUPPORT_WAV)
+	drwav decoder;
+#endif // AUDIO_SUPPORT_WAV
+
+	// Length in source frames
+	uint64 frame_count;
 };
 
 static Sound *sound_create_from_wave(Wave wave);
+#if defined(AUDIO_SUPPORT_WAV)
+static uint32 music_read(void *user_data, void *output, uint32 frame_count);
+static void music_seek_source(void *user_data, uint64 frame);
+#endif // AUDIO_SUPPORT_WAV
 
 Sound *sound_create(String filename) {
 	Wave wave = load_wave(filename);
@@ -32,29 +69,13 @@ Sound *sound_create(String filename) {
 
 Sound *sound_alias(Sound *alias) {
 	Sound *sound = (Sound *)ls_calloc(1, sizeof(Sound));
-	if (alias->stream.buffer->data == NULL) {
-		return sound;
-	}
-
-	ma_device device = audio_server_get_device();
-
-	AudioBuffer *buffer = audio_buffer_create(AUDIO_DEVICE_FORMAT, AUDIO_DEVICE_CHANNELS,
-			alias->stream.sampleRate, alias->frame_count, AUDIO_BUFFER_USAGE_STATIC);
-	if (buffer == NULL) {
-		ls_log(LOG_LEVEL_ERROR, "Failed to create AudioBuffer\n");
-		ls_free(sound);
+	if (sound == NULL) {
+		ls_log(LOG_LEVEL_ERROR, "Failed to allocate memory for Sound\n");
 		return NULL;
 	}
 
-	buffer->frame_count = alias->stream.buffer->frame_count;
-	buffer->volume = alias->stream.buffer->volume;
-	buffer->data = alias->stream.buffer->data;
-
-	sound->frame_count = alias->frame_count;
-	sound->stream.sampleRate = device.sampleRate;
-	sound->stream.sampleSize = 32;
-	sound->stream.channels = AUDIO_DEVICE_CHANNELS;
-	sound->stream.buffer = buffer;
+	*sound = *alias;
+	sound->owns_data = false;
 
 	return sound;
 }
@@ -64,52 +85,285 @@ void sound_destroy(Sound *sound) {
 		return;
 	}
 
-	audio_buffer_destroy(sound->stream.buffer);
+	voice_pool_release_owner(sound);
+	if (sound->owns_data) {
+		// Voices stopped above may still be mixing it until the mixer gets to the stop
+		audio_server_release(ls_free, sound->data);
+	}
+
 	ls_free(sound);
 }
 
 bool is_sound_ready(Sound *sound) {
 	return ((sound->frame_count > 0) &&
-			(sound->stream.buffer != NULL) &&
+			(sound->data != NULL) &&
 			(sound->stream.sampleRate > 0) &&
 			(sound->stream.sampleSize > 0) &&
 			(sound->stream.channels > 0));
 }
 
 bool is_sound_playing(Sound *sound) {
-	return audio_buffer_is_playing(sound->stream.buffer);
+	uint32 iterator = 0;
+	AudioBuffer *voice;
+	while ((voice = voice_pool_next(sound, &iterator)) != NULL) {
+		if (audio_buffer_is_playing(voice)) {
+			return true;
+		}
+	}
+
+	return false;
 }
 
 void sound_play(Sound *sound) {
-	audio_buffer_play(sound->stream.buffer);
+	AudioVoiceSettings settings = {
+		.data = sound->data,
+		.frame_count = sound->frame_count,
+		.volume = sound->volume,
+		.pan = sound->pan,
+		.pitch = sound->pitch,
+		.bus = sound->bus,
+		.priority = sound->priority,
+		.max_instances = sound->max_instances,
+	};
+
+	voice_pool_play(sound, &settings);
 }
 
 void sound_stop(Sound *sound) {
-	audio_buffer_stop(sound->stream.buffer);
+	uint32 iterator = 0;
+	AudioBuffer *voice;
+	while ((voice = voice_pool_next(sound, &iterator)) != NULL) {
+		audio_buffer_stop(voice);
+	}
 }
 
 void sound_pause(Sound *sound) {
-	audio_buffer_pause(sound->stream.buffer);
+	uint32 iterator = 0;
+	AudioBuffer *voice;
+	while ((voice = voice_pool_next(sound, &iterator)) != NULL) {
+		audio_buffer_pause(voice);
+	}
 }
 
 void sound_resume(Sound *sound) {
-	audio_buffer_resume(sound->stream.buffer);
+	uint32 iterator = 0;
+	AudioBuffer *voice;
+	while ((voice = voice_pool_next(sound, &iterator)) != NULL) {
+		audio_buffer_resume(voice);
+	}
 }
 
 void sound_set_volume(Sound *sound, float32 volume) {
-	audio_buffer_set_volume(sound->stream.buffer, volume);
+	sound->volume = volume;
+
+	uint32 iterator = 0;
+	AudioBuffer *voice;
+	while ((voice = voice_pool_next(sound, &iterator)) != NULL) {
+		audio_buffer_set_volume(voice, volume);
+	}
 }
 
 void sound_set_pitch(Sound *sound, float32 pitch) {
-	audio_buffer_set_pitch(sound->stream.buffer, pitch);
+	sound->pitch = pitch;
+
+	uint32 iterator = 0;
+	AudioBuffer *voice;
+	while ((voice = voice_pool_next(sound, &iterator)) != NULL) {
+		audio_buffer_set_pitch(voice, pitch);
+	}
 }
 
 void sound_set_pan(Sound *sound, float32 pan) {
-	audio_buffer_set_pan(sound->stream.buffer, pan);
+	if (pan < 0.0f) {
+		pan = 0.0f;
+	} else if (pan > 1.0f) {
+		pan = 1.0f;
+	}
+
+	sound->pan = pan;
+
+	uint32 iterator = 0;
+	AudioBuffer *voice;
+	while ((voice = voice_pool_next(sound, &iterator)) != NULL) {
+		audio_buffer_set_pan(voice, pan);
+	}
+}
+
+void sound_set_bus(Sound *sound, AudioBus bus) {
+	sound->bus = bus;
+
+	uint32 iterator = 0;
+	AudioBuffer *voice;
+	while ((voice = voice_pool_next(sound, &iterator)) != NULL) {
+		audio_buffer_set_bus(voice, bus);
+	}
+}
+
+void sound_set_priority(Sound *sound, int32 priority) {
+	sound->priority = priority;
+}
+
+void sound_set_max_instances(Sound *sound, uint32 max_instances) {
+	sound->max_instances = max_instances;
+}
+
+Music *music_create(String filename) {
+#if defined(AUDIO_SUPPORT_WAV)
+	char *file_extension = os_path_get_extension(filename);
+	bool is_wave = file_extension && (ls_str_equals(file_extension, "wav") || ls_str_equals(file_extension, "WAV"));
+	if (file_extension) {
+		ls_free(file_extension);
+	}
+
+	if (!is_wave) {
+		ls_log(LOG_LEVEL_ERROR, "Unsupported music file: %s\n", filename);
+		return NULL;
+	}
+
+	Music *music = (Music *)ls_calloc(1, sizeof(Music));
+	if (!drwav_init_file(&music->decoder, filename, NULL)) {
+		ls_log(LOG_LEVEL_ERROR, "Failed to open music: %s\n", filename);
+		ls_free(music);
+		return NULL;
+	}
+
+	// Decoded to float at the source rate, the mixer's converter takes it from there
+	AudioBuffer *buffer = audio_buffer_create(ma_format_f32, music->decoder.channels, music->decoder.sampleRate,
+			MUSIC_SUB_BUFFER_FRAMES * 2, AUDIO_BUFFER_USAGE_STREAM);
+	if (buffer == NULL) {
+		ls_log(LOG_LEVEL_ERROR, "Failed to create AudioBuffer\n");
+		drwav_uninit(&music->decoder);
+		ls_free(music);
+		return NULL;
+	}
+
+	// The stream itself wraps around its two sub buffers forever, the source decides when it ends
+	audio_buffer_set_looping(buffer, true);
+	audio_buffer_set_bus(buffer, AUDIO_BUS_MUSIC);
+
+	music->frame_count = music->decoder.totalPCMFrameCount;
+	music->stream.sampleRate = music->decoder.sampleRate;
+	music->stream.sampleSize = 32;
+	music->stream.channels = music->decoder.channels;
+	music->stream.buffer = buffer;
+
+	music->source.buffer = buffer;
+	music->source.read = music_read;
+	music->source.seek = music_seek_source;
+	music->source.user_data = music;
+	music->source.is_looping = true;
+
+	stream_decoder_init();
+	stream_decoder_add(&music->source);
+
+	return music;
+#else
+	ls_log(LOG_LEVEL_ERROR, "WAV support is not enabled\n");
+	return NULL;
+#endif // AUDIO_SUPPORT_WAV
+}
+
+void music_destroy(Music *music) {
+	if (music == NULL) {
+		return;
+	}
+
+	// The decoder lets go of the source before the decoder state and the buffer go away
+	stream_decoder_remove(&music->source);
+#if defined(AUDIO_SUPPORT_WAV)
+	drwav_uninit(&music->decoder);
+#endif // AUDIO_SUPPORT_WAV
+	audio_buffer_destroy(music->stream.buffer);
+	ls_free(music);
+}
+
+bool is_music_ready(Music *music) {
+	return ((music != NULL) &&
+			(music->frame_count > 0) &&
+			(music->stream.buffer != NULL) &&
+			(music->stream.sampleRate > 0) &&
+			(music->stream.channels > 0));
+}
+
+bool is_music_playing(Music *music) {
+	return audio_buffer_is_playing(music->stream.buffer);
+}
+
+void music_play(Music *music) {
+	music_seek(music, 0.0f);
+	audio_buffer_play(music->stream.buffer);
+}
+
+void music_stop(Music *music) {
+	audio_buffer_stop(music->stream.buffer);
+}
+
+void music_pause(Music *music) {
+	audio_buffer_pause(music->stream.buffer);
+}
+
+void music_resume(Music *music) {
+	audio_buffer_resume(music->stream.buffer);
+}
+
+void music_seek(Music *music, float32 position) {
+	uint64 frame = position > 0.0f ? (uint64)(position * music->stream.sampleRate) : 0;
+	if (frame >= music->frame_count) {
+		frame = music->frame_count > 0 ? music->frame_count - 1 : 0;
+	}
+
+	uint32 generation = stream_decoder_restart(&music->source, frame);
+	audio_server_send_command((AudioCommand){ .type = AUDIO_COMMAND_RESTART_STREAM, .buffer = music->stream.buffer, .generation = generation });
+}
+
+void music_set_looping(Music *music, bool looping) {
+	audio_atomic_store(&music->source.is_looping, looping);
+}
+
+void music_set_bus(Music *music, AudioBus bus) {
+	audio_buffer_set_bus(music->stream.buffer, bus);
+}
+
+void music_set_volume(Music *music, float32 volume) {
+	audio_buffer_set_volume(music->stream.buffer, volume);
+}
+
+void music_set_pitch(Music *music, float32 pitch) {
+	audio_buffer_set_pitch(music->stream.buffer, pitch);
+}
+
+void music_set_pan(Music *music, float32 pan) {
+	audio_buffer_set_pan(music->stream.buffer, pan);
+}
+
+float32 music_get_length(Music *music) {
+	return (float32)music->frame_count / (float32)music->stream.sampleRate;
+}
+
+float32 music_get_time_played(Music *music) {
+	if (music->frame_count == 0) {
+		return 0.0f;
+	}
+
+	// Positions past the end come from sub buffers that wrapped into the loop
+	uint64 frame = audio_atomic_load(&music->stream.buffer->stream_position) % music->frame_count;
+	return (float32)frame / (float32)music->stream.sampleRate;
 }
 
 // Static functions
 
+#if defined(AUDIO_SUPPORT_WAV)
+static uint32 music_read(void *user_data, void *output, uint32 frame_count) {
+	Music *music = (Music *)user_data;
+	return (uint32)drwav_read_pcm_frames_f32(&music->decoder, frame_count, (float32 *)output);
+}
+
+static void music_seek_source(void *user_data, uint64 frame) {
+	Music *music = (Music *)user_data;
+	drwav_seek_to_pcm_frame(&music->decoder, frame);
+}
+#endif // AUDIO_SUPPORT_WAV
+
 static Sound *sound_create_from_wave(Wave wave) {
 	Sound *sound = (Sound *)ls_calloc(1, sizeof(Sound));
 	if (sound == NULL) {
@@ -125,28 +379,37 @@ static Sound *sound_create_from_wave(Wave wave) {
 	uint32 frame_count = (uint32)ma_convert_frames(NULL, 0, AUDIO_DEVICE_FORMAT, AUDIO_DEVICE_CHANNELS,
 			device.sampleRate, NULL, frame_count_in, format_in, wave.channels, wave.sampleRate);
 
-	AudioBuffer *buffer = audio_buffer_create(AUDIO_DEVICE_FORMAT, AUDIO_DEVICE_CHANNELS, device.sampleRate, frame_count, AUDIO_BUFFER_USAGE_STATIC);
-	if (buffer == NULL) {
-		ls_log(LOG_LEVEL_ERROR, "Failed to create AudioBuffer\n");
+	uint8 *data = frame_count > 0 ? ls_calloc(frame_count, ma_get_bytes_per_frame(AUDIO_DEVICE_FORMAT, AUDIO_DEVICE_CHANNELS)) : NULL;
+	if (data == NULL) {
+		ls_log(LOG_LEVEL_ERROR, "Failed to allocate sound data\n");
 		ls_free(sound);
 		return NULL;
 	}
 
-	frame_count = (uint32)ma_convert_frames(buffer->data, frame_count, AUDIO_DEVICE_FORMAT, AUDIO_DEVICE_CHANNELS,
+	frame_count = (uint32)ma_convert_frames(data, frame_count, AUDIO_DEVICE_FORMAT, AUDIO_DEVICE_CHANNELS,
 			device.sampleRate, wave.data, frame_count_in, format_in, wave.channels, wave.sampleRate);
 
 	if (frame_count == 0) {
 		ls_log(LOG_LEVEL_ERROR, "Failed to convert frames\n");
-		audio_buffer_destroy(buffer);
+		ls_free(data);
 		ls_free(sound);
 		return NULL;
 	}
 
 	sound->frame_count = frame_count;
+	sound->data = data;
+	sound->owns_data = true;
+	sound->volume = 1.0f;
+	sound->pitch = 1.0f;
+	sound->pan = 0.5f;
+	sound->priority = 0;
+	sound->max_instances = 0;
+	sound->bus = AUDIO_BUS_SFX;
+
 	sound->stream.sampleRate = device.sampleRate;
 	sound->stream.sampleSize = 32;
 	sound->stream.channels = AUDIO_DEVICE_CHANNELS;
-	sound->stream.buffer = buffer;
+	sound->stream.buffer = NULL;
 
 	return sound;
 }
\ No newline at end of file
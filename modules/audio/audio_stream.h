@@ -3,17 +3,21 @@
 
 #include "core/core.h"
 
+#include "modules/audio/audio_bus.h"
+
 typedef struct AudioStream AudioStream;
 
-// TODO: Add support for music streaming
-// typedef struct Music Music;
+// Music is streamed from disk by a decoder thread, only two short sub buffers of it are in memory
+typedef struct Music Music;
 
-// A sound is a static audio buffer meant for short sound effects ~10 seconds or less
+// A sound is static audio data meant for short sound effects ~10 seconds or less.
+// Every play starts a new instance on a pooled voice, see audio_server_set_max_voices.
 typedef struct Sound Sound;
 
 // Loads a sound from a file
 LS_EXPORT Sound *sound_create(String filename);
-// Creates a new sound that uses the same source data as the given sound. It does not own the source data.
+// Creates a new sound that uses the same source data and settings as the given sound. It does not own the source data,
+// so it has to be destroyed before the given sound.
 LS_EXPORT Sound *sound_alias(Sound *alias);
 // Destroys the sound
 LS_EXPORT void sound_destroy(Sound *sound);
@@ -22,19 +26,60 @@ LS_EXPORT void sound_destroy(Sound *sound);
 LS_EXPORT bool is_sound_ready(Sound *sound);
 // Check if the sound is playing
 LS_EXPORT bool is_sound_playing(Sound *sound);
-// Play the sound
+// Play a new instance of the sound, earlier instances keep playing
 LS_EXPORT void sound_play(Sound *sound);
-// Stop the sound
+// Stop every instance of the sound
 LS_EXPORT void sound_stop(Sound *sound);
-// Pause the sound
+// Pause every instance of the sound
 LS_EXPORT void sound_pause(Sound *sound);
-// Resume the sound
+// Resume every instance of the sound
 LS_EXPORT void sound_resume(Sound *sound);
-// Set the volume of the sound
+// Set the volume of the sound, playing instances included
 LS_EXPORT void sound_set_volume(Sound *sound, float32 volume);
-// Set the pitch of the sound
+// Set the pitch of the sound, playing instances included
 LS_EXPORT void sound_set_pitch(Sound *sound, float32 pitch);
-// Set the pan of the sound
+// Set the pan of the sound, playing instances included
 LS_EXPORT void sound_set_pan(Sound *sound, float32 pan);
+// Set the bus the sound plays on, AUDIO_BUS_SFX by default. Playing instances move too.
+LS_EXPORT void sound_set_bus(Sound *sound, AudioBus bus);
+// Set the priority of the sound, 0 by default. With every voice busy a new instance only replaces one
+// with the same or a lower priority.
+LS_EXPORT void sound_set_priority(Sound *sound, int32 priority);
+// Limit how many instances of the sound play at once, playing past it restarts the oldest. 0 means no limit.
+LS_EXPORT void sound_set_max_instances(Sound *sound, uint32 max_instances);
+
+// Opens a music file for streaming, only WAV files are supported for now. Music loops by default.
+LS_EXPORT Music *music_create(String filename);
+// Destroys the music
+LS_EXPORT void music_destroy(Music *music);
+
+// Check if the music is ready to be played
+LS_EXPORT bool is_music_ready(Music *music);
+// Check if the music is playing
+LS_EXPORT bool is_music_playing(Music *music);
+// Play the music from the start
+LS_EXPORT void music_play(Music *music);
+// Stop the music
+LS_EXPORT void music_stop(Music *music);
+// Pause the music
+LS_EXPORT void music_pause(Music *music);
+// Resume the music
+LS_EXPORT void music_resume(Music *music);
+// Continue the music from the given position in seconds, it keeps playing or paused as it was
+LS_EXPORT void music_seek(Music *music, float32 position);
+// Set whether the music starts over when it ends
+LS_EXPORT void music_set_looping(Music *music, bool looping);
+// Set the bus the music plays on, AUDIO_BUS_MUSIC by default
+LS_EXPORT void music_set_bus(Music *music, AudioBus bus);
+// Set the volume of the music
+LS_EXPORT void music_set_volume(Music *music, float32 volume);
+// Set the pitch of the music
+LS_EXPORT void music_set_pitch(Music *music, float32 pitch);
+// Set the pan of the music
+LS_EXPORT void music_set_pan(Music *music, float32 pan);
+// Get the length of the music in seconds
+LS_EXPORT float32 music_get_length(Music *music);
+// Get the position of the music in seconds
+LS_EXPORT float32 music_get_time_played(Music *music);
 
 #endif // AUDIO_STREAM_H
\ No newline at end of file
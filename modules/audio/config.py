@@ -34,6 +34,7 @@ def configure(env):
     env_vars.Update(env)
     
     env.api_headers += [
+        "modules/audio/audio_bus.h",
         "modules/audio/audio_server.h",
         "modules/audio/audio_stream.h",
     ]
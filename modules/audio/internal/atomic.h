@@ -0,0 +1,47 @@
+#ifndef AUDIO_ATOMIC_H
+#define AUDIO_ATOMIC_H
+
+#include "core/core.h"
+
+// The few atomics the game and audio threads share state with.
+// Loads acquire and stores release, so data written before a store is visible after the matching load.
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+
+_FORCE_INLINE_ uint32 audio_atomic_load(volatile uint32 *value) {
+	return (uint32)_InterlockedCompareExchange((volatile long *)value, 0, 0);
+}
+
+_FORCE_INLINE_ void audio_atomic_store(volatile uint32 *value, uint32 new_value) {
+	_InterlockedExchange((volatile long *)value, (long)new_value);
+}
+
+_FORCE_INLINE_ uint32 audio_atomic_increment(volatile uint32 *value) {
+	return (uint32)_InterlockedIncrement((volatile long *)value);
+}
+
+// Returns the previous value
+_FORCE_INLINE_ uint32 audio_atomic_exchange(volatile uint32 *value, uint32 new_value) {
+	return (uint32)_InterlockedExchange((volatile long *)value, (long)new_value);
+}
+#else
+_FORCE_INLINE_ uint32 audio_atomic_load(volatile uint32 *value) {
+	return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+_FORCE_INLINE_ void audio_atomic_store(volatile uint32 *value, uint32 new_value) {
+	__atomic_store_n(value, new_value, __ATOMIC_RELEASE);
+}
+
+_FORCE_INLINE_ uint32 audio_atomic_increment(volatile uint32 *value) {
+	return __atomic_add_fetch(value, 1, __ATOMIC_RELAXED);
+}
+
+// Returns the previous value
+_FORCE_INLINE_ uint32 audio_atomic_exchange(volatile uint32 *value, uint32 new_value) {
+	return __atomic_exchange_n(value, new_value, __ATOMIC_ACQ_REL);
+}
+#endif // _MSC_VER
+
+#endif // AUDIO_ATOMIC_H
\ No newline at end of file
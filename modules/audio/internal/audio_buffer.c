@@ -1,4 +1,5 @@
 #include "audio_buffer.h"
+#include "atomic.h"
 #include "audio_server.h"
 
 #include "modules/audio/audio_server.h"
@@ -13,8 +14,11 @@ AudioBuffer *audio_buffer_create(ma_format format, uint32 channels, uint32 sampl
 	}
 	buffer->data = NULL;
 	if (frame_count > 0) {
-		buffer->data = ls_calloc(frame_count * channels * ma_get_bytes_per_frame(format, channels), 1);
+		buffer->data = ls_calloc(frame_count, ma_get_bytes_per_frame(format, channels));
 	}
+	buffer->owns_data = buffer->data != NULL;
+	buffer->is_device_format = format == AUDIO_DEVICE_FORMAT && channels == AUDIO_DEVICE_CHANNELS && sample_rate == device.sampleRate;
+	buffer->playing_index = -1;
 
 	ma_data_converter_config config = ma_data_converter_config_init(format, AUDIO_DEVICE_FORMAT, channels, AUDIO_DEVICE_CHANNELS, sample_rate, device.sampleRate);
 	config.allowDynamicSampleRate = true;
@@ -30,12 +34,13 @@ AudioBuffer *audio_buffer_create(ma_format format, uint32 channels, uint32 sampl
 		return NULL;
 	}
 
+	buffer->base_sample_rate_out = device.sampleRate;
 	buffer->volume = 1.0f;
 	buffer->pitch = 1.0f;
 	buffer->pan = 0.5f;
 
 	buffer->callback = NULL;
-	buffer->processor = NULL;
+	buffer->bus = AUDIO_BUS_MASTER;
 
 	buffer->is_playing = false;
 	buffer->is_looping = false;
@@ -48,7 +53,13 @@ AudioBuffer *audio_buffer_create(ma_format format, uint32 channels, uint32 sampl
 	buffer->is_sub_buffer_processed[0] = true;
 	buffer->is_sub_buffer_processed[1] = true;
 
-	audio_server_track_buffer(buffer);
+	buffer->state = 0;
+	buffer->voice_generation = 0;
+
+	buffer->stream_generation = 0;
+	buffer->filled_generation = 0;
+	buffer->stream_end = 0;
+	buffer->stream_position = 0;
 
 	return buffer;
 }
@@ -57,9 +68,13 @@ void audio_buffer_destroy(AudioBuffer *buffer) {
 	if (buffer == NULL) {
 		return;
 	}
-	ma_data_converter_uninit(&buffer->converter, NULL);
+
 	audio_server_untrack_buffer(buffer);
-	if (buffer->data) {
+}
+
+void audio_buffer_free(AudioBuffer *buffer) {
+	ma_data_converter_uninit(&buffer->converter, NULL);
+	if (buffer->owns_data) {
 		ls_free(buffer->data);
 	}
 
@@ -67,12 +82,11 @@ void audio_buffer_destroy(AudioBuffer *buffer) {
 }
 
 bool audio_buffer_is_playing(AudioBuffer *buffer) {
-	bool result = false;
-	if (buffer != NULL && !buffer->is_paused) {
-		result = buffer->is_playing;
+	if (buffer == NULL) {
+		return false;
 	}
 
-	return result;
+	return audio_atomic_load(&buffer->state) == AUDIO_BUFFER_STATE_PLAYING;
 }
 
 void audio_buffer_play(AudioBuffer *buffer) {
@@ -80,9 +94,8 @@ void audio_buffer_play(AudioBuffer *buffer) {
 		return;
 	}
 
-	buffer->is_playing = true;
-	buffer->is_paused = false;
-	buffer->frame_index = 0;
+	audio_atomic_store(&buffer->state, AUDIO_BUFFER_STATE_PLAYING);
+	audio_server_send_command((AudioCommand){ .type = AUDIO_COMMAND_PLAY, .buffer = buffer });
 }
 
 void audio_buffer_stop(AudioBuffer *buffer) {
@@ -90,12 +103,8 @@ void audio_buffer_stop(AudioBuffer *buffer) {
 		return;
 	}
 
-	buffer->is_playing = false;
-	buffer->is_paused = false;
-	buffer->frame_index = 0;
-	buffer->frames_processed = 0;
-	buffer->is_sub_buffer_processed[0] = true;
-	buffer->is_sub_buffer_processed[1] = true;
+	audio_atomic_store(&buffer->state, 0);
+	audio_server_send_command((AudioCommand){ .type = AUDIO_COMMAND_STOP, .buffer = buffer });
 }
 
 void audio_buffer_pause(AudioBuffer *buffer) {
@@ -103,7 +112,8 @@ void audio_buffer_pause(AudioBuffer *buffer) {
 		return;
 	}
 
-	buffer->is_paused = true;
+	audio_atomic_store(&buffer->state, audio_atomic_load(&buffer->state) | AUDIO_BUFFER_STATE_PAUSED);
+	audio_server_send_command((AudioCommand){ .type = AUDIO_COMMAND_PAUSE, .buffer = buffer });
 }
 
 void audio_buffer_resume(AudioBuffer *buffer) {
@@ -111,7 +121,8 @@ void audio_buffer_resume(AudioBuffer *buffer) {
 		return;
 	}
 
-	buffer->is_paused = false;
+	audio_atomic_store(&buffer->state, audio_atomic_load(&buffer->state) & ~AUDIO_BUFFER_STATE_PAUSED);
+	audio_server_send_command((AudioCommand){ .type = AUDIO_COMMAND_RESUME, .buffer = buffer });
 }
 
 void audio_buffer_set_volume(AudioBuffer *buffer, float32 volume) {
@@ -119,7 +130,7 @@ void audio_buffer_set_volume(AudioBuffer *buffer, float32 volume) {
 		return;
 	}
 
-	buffer->volume = volume;
+	audio_server_send_command((AudioCommand){ .type = AUDIO_COMMAND_SET_VOLUME, .buffer = buffer, .value = volume });
 }
 
 void audio_buffer_set_pitch(AudioBuffer *buffer, float32 pitch) {
@@ -127,10 +138,7 @@ void audio_buffer_set_pitch(AudioBuffer *buffer, float32 pitch) {
 		return;
 	}
 
-	uint32 output_sample_rate = (uint32)((float32)(buffer->converter.sampleRateOut / pitch));
-	ma_data_converter_set_rate(&buffer->converter, buffer->converter.sampleRateIn, output_sample_rate);
-
-	buffer->pitch = pitch;
+	audio_server_send_command((AudioCommand){ .type = AUDIO_COMMAND_SET_PITCH, .buffer = buffer, .value = pitch });
 }
 
 void audio_buffer_set_pan(AudioBuffer *buffer, float32 pan) {
@@ -144,39 +152,23 @@ void audio_buffer_set_pan(AudioBuffer *buffer, float32 pan) {
 		pan = 1.0f;
 	}
 
-	buffer->pan = pan;
+	audio_server_send_command((AudioCommand){ .type = AUDIO_COMMAND_SET_PAN, .buffer = buffer, .value = pan });
 }
 
-void audio_buffer_set_next(AudioBuffer *buffer, AudioBuffer *next) {
+void audio_buffer_set_looping(AudioBuffer *buffer, bool looping) {
 	if (buffer == NULL) {
 		return;
 	}
 
-	buffer->next = next;
+	audio_server_send_command((AudioCommand){ .type = AUDIO_COMMAND_SET_LOOPING, .buffer = buffer, .enabled = looping });
 }
 
-void audio_buffer_set_prev(AudioBuffer *buffer, AudioBuffer *prev) {
+void audio_buffer_set_bus(AudioBuffer *buffer, AudioBus bus) {
 	if (buffer == NULL) {
 		return;
 	}
 
-	buffer->prev = prev;
-}
-
-AudioBuffer *audio_buffer_get_next(AudioBuffer *buffer) {
-	if (buffer == NULL) {
-		return NULL;
-	}
-
-	return buffer->next;
-}
-
-AudioBuffer *audio_buffer_get_prev(AudioBuffer *buffer) {
-	if (buffer == NULL) {
-		return NULL;
-	}
-
-	return buffer->prev;
+	audio_server_send_command((AudioCommand){ .type = AUDIO_COMMAND_SET_VOICE_BUS, .buffer = buffer, .bus = bus });
 }
 
 void *audio_buffer_get_data(AudioBuffer *buffer) {
@@ -5,6 +5,7 @@
 
 #include <miniaudio.h>
 
+#include "modules/audio/audio_bus.h"
 #include "modules/audio/audio_server.h"
 
 typedef enum {
@@ -12,11 +13,20 @@ typedef enum {
 	AUDIO_BUFFER_USAGE_STREAM
 } AudioBufferUsage;
 
+// Bits of AudioBuffer.state
+#define AUDIO_BUFFER_STATE_PLAYING 0x01
+#define AUDIO_BUFFER_STATE_PAUSED 0x02
+
+// Everything but state belongs to the audio thread once the buffer is created.
+// The game thread changes a buffer through the audio_buffer_* setters, which queue commands the
+// mixer applies at the start of its next callback.
 struct AudioBuffer {
 	ma_data_converter converter;
+	// Output rate of the converter at pitch 1, pitch changes scale this rather than the current rate
+	uint32 base_sample_rate_out;
 
 	AudioCallback callback;
-	AudioProcessor *processor;
+	AudioBus bus;
 
 	float32 volume;
 	float32 pitch;
@@ -28,20 +38,46 @@ struct AudioBuffer {
 
 	AudioBufferUsage usage;
 
-	bool is_sub_buffer_processed[2];
+	// Streams hand sub buffers between the mixer and the decoder thread through these
+	volatile uint32 is_sub_buffer_processed[2];
 
 	uint32 frame_count;
 	uint32 frame_index;
 	uint32 frames_processed;
 
 	uint8 *data;
-
-	AudioBuffer *next;
-	AudioBuffer *prev;
+	// Pool voices borrow the data of the sound they play
+	bool owns_data;
+	// Data is already in the device format, channel count and sample rate. Unless the pitch changes the
+	// mixer reads it in place and skips the converter.
+	bool is_device_format;
+
+	// Position in the mixer's playing list, -1 when not in it
+	int32 playing_index;
+
+	// The playing and paused bits as the game thread sees them. Set right away by play, stop, pause and
+	// resume, and cleared by the mixer when a buffer runs out.
+	volatile uint32 state;
+	// Pool voices only, the generation of the last AUDIO_COMMAND_START_VOICE the mixer applied
+	volatile uint32 voice_generation;
+
+	// Streams only, see StreamSource.
+	// The restart the mixer applied last, it stays silent until filled_generation catches up.
+	volatile uint32 stream_generation;
+	volatile uint32 filled_generation;
+	// One past the index of the sub buffer the source ends in, 0 while it continues
+	volatile uint32 stream_end;
+	// Source frame each sub buffer starts at
+	volatile uint32 sub_buffer_start[2];
+	// Source frame the mixer is at
+	volatile uint32 stream_position;
 };
 
 AudioBuffer *audio_buffer_create(ma_format format, uint32 channels, uint32 sample_rate, uint32 frame_count, AudioBufferUsage usage);
+// The buffer is freed once the mixer has dropped it, which can be a callback later.
 void audio_buffer_destroy(AudioBuffer *buffer);
+// Frees the buffer right away, only for the audio server once the buffer is released.
+void audio_buffer_free(AudioBuffer *buffer);
 
 bool audio_buffer_is_playing(AudioBuffer *buffer);
 
@@ -52,5 +88,7 @@ void audio_buffer_resume(AudioBuffer *buffer);
 void audio_buffer_set_volume(AudioBuffer *buffer, float32 volume);
 void audio_buffer_set_pitch(AudioBuffer *buffer, float32 pitch);
 void audio_buffer_set_pan(AudioBuffer *buffer, float32 pan);
+void audio_buffer_set_looping(AudioBuffer *buffer, bool looping);
+void audio_buffer_set_bus(AudioBuffer *buffer, AudioBus bus);
 
 #endif // AUDIO_BUFFER_H
\ No newline at end of file
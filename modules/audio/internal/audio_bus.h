@@ -0,0 +1,37 @@
+#ifndef AUDIO_BUS_INTERNAL_H
+#define AUDIO_BUS_INTERNAL_H
+
+#include "core/core.h"
+
+#include "command_queue.h"
+
+#include "modules/audio/audio_bus.h"
+
+#ifndef AUDIO_MAX_BUSES
+#define AUDIO_MAX_BUSES 16
+#endif // AUDIO_MAX_BUSES
+
+#ifndef AUDIO_BUS_MAX_PROCESSORS
+#define AUDIO_BUS_MAX_PROCESSORS 8
+#endif // AUDIO_BUS_MAX_PROCESSORS
+
+// Frames mixed per bus block, a device period is mixed in as many blocks as it takes
+#define AUDIO_BUS_BLOCK_FRAMES 512
+
+// Creates the built in buses, called by the audio server with the device.
+void audio_bus_init(uint32 channels, uint32 sample_rate);
+// Releases every processor left, the mixer has to be stopped.
+void audio_bus_deinit();
+
+// Audio thread side, driven by the mixer
+
+void audio_bus_apply_command(AudioCommand command);
+
+// Clears the blocks for the next frame_count frames, at most AUDIO_BUS_BLOCK_FRAMES.
+void audio_bus_begin_block(uint32 frame_count);
+// The block voices on bus mix into. Invalid buses fall back to master.
+float32 *audio_bus_get_block(AudioBus bus);
+// Runs every bus into its parent and writes the master block to output.
+void audio_bus_end_block(float32 *output);
+
+#endif // AUDIO_BUS_INTERNAL_H
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef AUDIO_SERVER_INTERNAL_H
 #define AUDIO_SERVER_INTERNAL_H
 
+#include "command_queue.h"
+
 #include <miniaudio.h>
 
 // TODO: make these a scons flags
@@ -16,6 +18,18 @@
 #define AUDIO_DEVICE_SAMPLE_RATE 0 // 0 means use the default sample rate
 #endif // AUDIO_DEVICE_SAMPLE_RATE
 
+// Buffers the mixer can hold playing at once, the voice pool plus every music stream
+#ifndef AUDIO_MAX_PLAYING_BUFFERS
+#define AUDIO_MAX_PLAYING_BUFFERS 512
+#endif // AUDIO_MAX_PLAYING_BUFFERS
+
 ma_device audio_server_get_device();
 
+// Queues a command for the mixer, game thread only.
+// Commands that don't fit in the queue are held back and sent in order once the mixer catches up.
+void audio_server_send_command(AudioCommand command);
+// Calls destroy with data once the mixer applied every command sent before, game thread only.
+// Direct when the device isn't running, otherwise from a later update.
+void audio_server_release(AudioReleaseFunction destroy, void *data);
+
 #endif // AUDIO_SERVER_INTERNAL_H
\ No newline at end of file
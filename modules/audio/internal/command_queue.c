@@ -0,0 +1,37 @@
+#include "command_queue.h"
+
+#include "atomic.h"
+
+#define AUDIO_COMMAND_QUEUE_MASK (AUDIO_COMMAND_QUEUE_SIZE - 1)
+
+void audio_command_queue_init(AudioCommandQueue *queue) {
+	queue->head = 0;
+	queue->tail = 0;
+}
+
+bool audio_command_queue_push(AudioCommandQueue *queue, AudioCommand command) {
+	// Only this thread writes head, so it can be read plainly
+	uint32 head = queue->head;
+	if (head - audio_atomic_load(&queue->tail) == AUDIO_COMMAND_QUEUE_SIZE) {
+		return false;
+	}
+
+	queue->commands[head & AUDIO_COMMAND_QUEUE_MASK] = command;
+	// Publishes the command, the consumer can't see the new head before the slot is written
+	audio_atomic_store(&queue->head, head + 1);
+
+	return true;
+}
+
+bool audio_command_queue_pop(AudioCommandQueue *queue, AudioCommand *command) {
+	uint32 tail = queue->tail;
+	if (tail == audio_atomic_load(&queue->head)) {
+		return false;
+	}
+
+	*command = queue->commands[tail & AUDIO_COMMAND_QUEUE_MASK];
+	// Hands the slot back to the producer only after it was read
+	audio_atomic_store(&queue->tail, tail + 1);
+
+	return true;
+}
\ No newline at end of file
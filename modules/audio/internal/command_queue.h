@@ -0,0 +1,105 @@
+#ifndef AUDIO_COMMAND_QUEUE_H
+#define AUDIO_COMMAND_QUEUE_H
+
+#include "core/core.h"
+
+#include "modules/audio/audio_bus.h"
+#include "modules/audio/audio_server.h"
+
+// Must be a power of two
+#ifndef AUDIO_COMMAND_QUEUE_SIZE
+#define AUDIO_COMMAND_QUEUE_SIZE 1024
+#endif // AUDIO_COMMAND_QUEUE_SIZE
+
+typedef void (*AudioReleaseFunction)(void *data);
+
+// Frees data once the mixer applied every command queued before the release.
+typedef struct {
+	// Set by the audio thread when it reaches the release
+	volatile uint32 is_released;
+	AudioReleaseFunction destroy;
+	void *data;
+} AudioRelease;
+
+typedef enum {
+	// Drops the buffer from the playing list for good, it is about to be freed
+	AUDIO_COMMAND_REMOVE_VOICE,
+	AUDIO_COMMAND_PLAY,
+	AUDIO_COMMAND_STOP,
+	AUDIO_COMMAND_PAUSE,
+	AUDIO_COMMAND_RESUME,
+	AUDIO_COMMAND_SET_VOLUME,
+	AUDIO_COMMAND_SET_PAN,
+	AUDIO_COMMAND_SET_PITCH,
+	AUDIO_COMMAND_SET_LOOPING,
+	// Rewinds a stream buffer to its first sub buffer and waits for the decoder to fill it for generation
+	AUDIO_COMMAND_RESTART_STREAM,
+	// Restarts a pool voice on borrowed PCM data with fresh settings, on the given bus
+	AUDIO_COMMAND_START_VOICE,
+	AUDIO_COMMAND_SET_VOICE_BUS,
+	AUDIO_COMMAND_RELEASE,
+
+	// Bus commands, applied by the bus graph
+	AUDIO_COMMAND_CREATE_BUS,
+	AUDIO_COMMAND_SET_BUS_GAIN,
+	AUDIO_COMMAND_ADD_BUS_PROCESSOR,
+	AUDIO_COMMAND_REMOVE_BUS_PROCESSOR,
+	AUDIO_COMMAND_SET_BUS_DUCKING,
+} AudioCommandType;
+
+typedef struct {
+	AudioCommandType type;
+	AudioBuffer *buffer;
+	AudioBus bus;
+	union {
+		float32 value;
+		bool enabled;
+		uint32 generation;
+		AudioRelease *release;
+		AudioBus parent;
+		struct {
+			const uint8 *data;
+			uint32 frame_count;
+			float32 volume;
+			float32 pan;
+			float32 pitch;
+			uint32 generation;
+		} voice;
+		struct {
+			AudioBusProcessFunction process;
+			void *user_data;
+		} processor;
+		struct {
+			AudioBus trigger;
+			float32 depth;
+			float32 attack;
+			float32 release;
+		} ducking;
+	};
+} AudioCommand;
+
+LS_ARRAY_DEFINE(AudioCommandArray, audio_command_array, AudioCommand)
+
+// Lock-free ring with exactly one producer thread and one consumer thread.
+// Head and tail run freely and wrap on overflow, they sit on separate cache lines so the two threads
+// don't invalidate each other's line on every command.
+typedef struct {
+	// Next slot to write, only written by the producer
+	volatile uint32 head;
+	uint8 head_padding[64 - sizeof(uint32)];
+
+	// Next slot to read, only written by the consumer
+	volatile uint32 tail;
+	uint8 tail_padding[64 - sizeof(uint32)];
+
+	AudioCommand commands[AUDIO_COMMAND_QUEUE_SIZE];
+} AudioCommandQueue;
+
+void audio_command_queue_init(AudioCommandQueue *queue);
+
+// Producer side. Returns false without blocking when the queue is full.
+bool audio_command_queue_push(AudioCommandQueue *queue, AudioCommand command);
+// Consumer side. Returns false when the queue is empty.
+bool audio_command_queue_pop(AudioCommandQueue *queue, AudioCommand *command);
+
+#endif // AUDIO_COMMAND_QUEUE_H
\ No newline at end of file
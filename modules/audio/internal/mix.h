@@ -0,0 +1,49 @@
+#ifndef AUDIO_MIX_H
+#define AUDIO_MIX_H
+
+#include "core/core.h"
+#include "core/math/simd.h"
+
+// out += in * gains, gains repeats every four samples. The tail starts on a multiple of four so the
+// pattern stays in step with the vector loop.
+_FORCE_INLINE_ void audio_mix_samples(float32 *out, const float32 *in, uint32 sample_count, const float32 gains[4]) {
+	uint32 i = 0;
+
+#if defined(SIMD_ENABLED)
+	const f32x4 gain = f32x4_load(gains);
+	for (; i + 8 <= sample_count; i += 8) {
+		f32x4 out0 = f32x4_madd(f32x4_load(in + i), gain, f32x4_load(out + i));
+		f32x4 out1 = f32x4_madd(f32x4_load(in + i + 4), gain, f32x4_load(out + i + 4));
+		f32x4_store(out + i, out0);
+		f32x4_store(out + i + 4, out1);
+	}
+
+	for (; i + 4 <= sample_count; i += 4) {
+		f32x4_store(out + i, f32x4_madd(f32x4_load(in + i), gain, f32x4_load(out + i)));
+	}
+#endif // SIMD_ENABLED
+
+	for (; i < sample_count; i++) {
+		out[i] += in[i] * gains[i & 3];
+	}
+}
+
+// out += in * gain, the gain moving linearly from from to to over the frames so changes don't click.
+_FORCE_INLINE_ void audio_mix_samples_ramp(float32 *out, const float32 *in, uint32 frame_count, uint32 channels, float32 from, float32 to) {
+	if (from == to) {
+		const float32 gains[4] = { to, to, to, to };
+		audio_mix_samples(out, in, frame_count * channels, gains);
+		return;
+	}
+
+	const float32 step = (to - from) / (float32)frame_count;
+	float32 gain = from;
+	for (uint32 frame = 0; frame < frame_count; frame++) {
+		gain += step;
+		for (uint32 c = 0; c < channels; c++) {
+			out[frame * channels + c] += in[frame * channels + c] * gain;
+		}
+	}
+}
+
+#endif // AUDIO_MIX_H
\ No newline at end of file
@@ -0,0 +1,220 @@
+#include "stream_decoder.h"
+
+#include "atomic.h"
+#include "core/os/thread.h"
+
+static struct {
+	LSThread *thread;
+
+	// Guards the source list and the game thread fields of each source. Only held to read them,
+	// never while reading from disk. The mixer never takes it.
+	LSMutex *lock;
+	StreamSource *sources;
+	// Source being decoded outside the lock, removing it waits on idle until the decoder is done with it
+	StreamSource *busy;
+	LSCond *idle;
+
+	// The mixer posts wake at most once per pass, wake_pending is set until the decoder picks it up
+	LSSemaphore *wake;
+	volatile uint32 wake_pending;
+	volatile uint32 stopping;
+} decoder = { 0 };
+
+static void stream_decoder_fill(StreamSource *source, uint32 index) {
+	AudioBuffer *buffer = source->buffer;
+
+	uint32 sub_buffer_frame_count = buffer->frame_count / 2;
+	uint32 frame_size = ma_get_bytes_per_frame(buffer->converter.formatIn, buffer->converter.channelsIn);
+	uint8 *output = buffer->data + index * sub_buffer_frame_count * frame_size;
+
+	audio_atomic_store(&buffer->sub_buffer_start[index], (uint32)source->cursor);
+
+	uint32 filled = 0;
+	bool wrapped = false;
+	while (filled < sub_buffer_frame_count) {
+		uint32 read = source->read(source->user_data, output + filled * frame_size, sub_buffer_frame_count - filled);
+		filled += read;
+		source->cursor += read;
+		if (read > 0) {
+			wrapped = false;
+		}
+
+		if (filled == sub_buffer_frame_count) {
+			break;
+		}
+
+		// Continue from the start within the same sub buffer so the loop point is seamless.
+		// Nothing read right after wrapping means the source is empty.
+		if (audio_atomic_load(&source->is_looping) && !wrapped) {
+			source->seek(source->user_data, 0);
+			source->cursor = 0;
+			wrapped = true;
+			continue;
+		}
+
+		ls_memset(output + filled * frame_size, 0, (sub_buffer_frame_count - filled) * frame_size);
+		source->is_finished = true;
+		audio_atomic_store(&buffer->stream_end, index + 1);
+		break;
+	}
+
+	// Hands the sub buffer to the mixer
+	audio_atomic_store(&buffer->is_sub_buffer_processed[index], 0);
+	source->next_sub_buffer = index ^ 1;
+}
+
+// restart_generation and seek_frame were read from the source under the lock
+static void stream_decoder_service(StreamSource *source, uint32 restart_generation, uint64 seek_frame) {
+	AudioBuffer *buffer = source->buffer;
+
+	// A restart only counts once the mixer applied it, before that it may still read the old data
+	uint32 generation = audio_atomic_load(&buffer->stream_generation);
+	if (generation != restart_generation) {
+		return;
+	}
+
+	if (source->decoded_generation != generation) {
+		source->decoded_generation = generation;
+		source->cursor = seek_frame;
+		source->seek(source->user_data, source->cursor);
+		source->is_finished = false;
+		audio_atomic_store(&buffer->stream_end, 0);
+
+		stream_decoder_fill(source, 0);
+		if (!source->is_finished) {
+			stream_decoder_fill(source, 1);
+		}
+		source->next_sub_buffer = source->is_finished ? 1 : 0;
+
+		// The mixer starts reading from the first sub buffer
+		audio_atomic_store(&buffer->filled_generation, generation);
+		return;
+	}
+
+	while (!source->is_finished && audio_atomic_load(&buffer->is_sub_buffer_processed[source->next_sub_buffer])) {
+		stream_decoder_fill(source, source->next_sub_buffer);
+	}
+}
+
+static void stream_decoder_thread(void *data) {
+	profiler_set_thread_name("Audio Decoder");
+
+	while (true) {
+		os_semaphore_wait(decoder.wake);
+		// Cleared before the pass, a wake during it posts again and gets another pass
+		audio_atomic_store(&decoder.wake_pending, 0);
+
+		if (audio_atomic_load(&decoder.stopping)) {
+			break;
+		}
+
+		LS_PROFILE_BEGIN("audio_decode");
+		os_mutex_lock(decoder.lock);
+		for (StreamSource *source = decoder.sources; source != NULL; source = source->next) {
+			uint32 generation = source->generation;
+			uint64 seek_frame = source->seek_frame;
+			decoder.busy = source;
+			os_mutex_unlock(decoder.lock);
+
+			stream_decoder_service(source, generation, seek_frame);
+
+			// A source removed meanwhile is waiting for busy to clear, its next is still in the list
+			os_mutex_lock(decoder.lock);
+			decoder.busy = NULL;
+			os_cond_broadcast(decoder.idle);
+		}
+		os_mutex_unlock(decoder.lock);
+		LS_PROFILE_END();
+	}
+}
+
+void stream_decoder_init() {
+	if (decoder.thread) {
+		return;
+	}
+
+	decoder.lock = os_mutex_create();
+	decoder.idle = os_cond_create();
+	decoder.wake = os_semaphore_create();
+	decoder.sources = NULL;
+	decoder.busy = NULL;
+	decoder.wake_pending = 0;
+	decoder.stopping = 0;
+
+	decoder.thread = os_thread_create(stream_decoder_thread, NULL);
+}
+
+void stream_decoder_deinit() {
+	if (!decoder.thread) {
+		return;
+	}
+
+	audio_atomic_store(&decoder.stopping, 1);
+	os_semaphore_post(decoder.wake);
+
+	os_thread_join(decoder.thread);
+	os_thread_destroy(decoder.thread);
+
+	os_semaphore_destroy(decoder.wake);
+	os_cond_destroy(decoder.idle);
+	os_mutex_destroy(decoder.lock);
+
+	decoder.thread = NULL;
+	decoder.sources = NULL;
+}
+
+void stream_decoder_add(StreamSource *source) {
+	LS_ASSERT(decoder.thread);
+
+	source->generation = 0;
+	source->decoded_generation = 0;
+	source->next_sub_buffer = 0;
+	source->cursor = 0;
+	source->is_finished = true;
+
+	os_mutex_lock(decoder.lock);
+	source->next = decoder.sources;
+	decoder.sources = source;
+	os_mutex_unlock(decoder.lock);
+}
+
+void stream_decoder_remove(StreamSource *source) {
+	if (!decoder.thread) {
+		return;
+	}
+
+	os_mutex_lock(decoder.lock);
+	for (StreamSource **link = &decoder.sources; *link != NULL; link = &(*link)->next) {
+		if (*link == source) {
+			*link = source->next;
+			break;
+		}
+	}
+
+	while (decoder.busy == source) {
+		os_cond_wait(decoder.idle, decoder.lock);
+	}
+	os_mutex_unlock(decoder.lock);
+
+	source->next = NULL;
+}
+
+uint32 stream_decoder_restart(StreamSource *source, uint64 frame) {
+	os_mutex_lock(decoder.lock);
+	source->seek_frame = frame;
+	uint32 generation = ++source->generation;
+	os_mutex_unlock(decoder.lock);
+
+	return generation;
+}
+
+void stream_decoder_wake() {
+	if (!decoder.thread) {
+		return;
+	}
+
+	// Called from the mixer, so no lock. Only the first wake of a pass posts, the count stays small.
+	if (!audio_atomic_exchange(&decoder.wake_pending, 1)) {
+		os_semaphore_post(decoder.wake);
+	}
+}
\ No newline at end of file
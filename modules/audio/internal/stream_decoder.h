@@ -0,0 +1,51 @@
+#ifndef AUDIO_STREAM_DECODER_H
+#define AUDIO_STREAM_DECODER_H
+
+#include "core/core.h"
+
+#include "audio_buffer.h"
+
+// Reads up to frame_count frames in the buffer's format into output, returns fewer at the end of the source.
+typedef uint32 (*StreamReadFunction)(void *user_data, void *output, uint32 frame_count);
+// Moves the source to the given frame.
+typedef void (*StreamSeekFunction)(void *user_data, uint64 frame);
+
+// A source the decoder thread keeps an AUDIO_BUFFER_USAGE_STREAM buffer filled from.
+// The decoder refills a sub buffer whenever the mixer marks it processed. Restarting from another frame
+// bumps the generation, the mixer stays silent until the decoder filled both sub buffers for it.
+typedef struct StreamSource {
+	AudioBuffer *buffer;
+	StreamReadFunction read;
+	StreamSeekFunction seek;
+	void *user_data;
+
+	// Game thread, read by the decoder under its lock
+	uint32 generation;
+	uint64 seek_frame;
+	volatile uint32 is_looping;
+
+	// Decoder thread only
+	uint32 decoded_generation;
+	uint32 next_sub_buffer;
+	uint64 cursor;
+	bool is_finished;
+
+	struct StreamSource *next;
+} StreamSource;
+
+// Starts the decoder thread if it isn't running yet.
+void stream_decoder_init();
+// Stops the decoder thread, sources should be removed before.
+void stream_decoder_deinit();
+
+void stream_decoder_add(StreamSource *source);
+// Once this returns the decoder no longer touches the source.
+void stream_decoder_remove(StreamSource *source);
+
+// Asks for the stream to continue from frame, returns the generation to send with AUDIO_COMMAND_RESTART_STREAM.
+uint32 stream_decoder_restart(StreamSource *source, uint64 frame);
+
+// Wakes the decoder to check its sources, called by the mixer when it needs data. Never blocks.
+void stream_decoder_wake();
+
+#endif // AUDIO_STREAM_DECODER_H
\ No newline at end of file
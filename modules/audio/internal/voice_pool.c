@@ -0,0 +1,189 @@
+#include "voice_pool.h"
+
+#include "atomic.h"
+#include "audio_server.h"
+
+typedef struct {
+	AudioBuffer *buffer;
+
+	// Whoever started the voice last, kept after it finishes until it is started again or released
+	const void *owner;
+	int32 priority;
+	// Start order, lower is older
+	uint64 started;
+	// Bumped by every start, the mixer reports back which one it applied
+	uint32 generation;
+} AudioVoice;
+
+static struct {
+	AudioVoice *voices;
+	uint32 capacity;
+	uint32 max_voices;
+	uint64 serial;
+} pool = { 0 };
+
+// Busy from the moment a start is queued. Until the mixer applied it, the state it publishes belongs to the
+// previous start and may say the voice stopped. After that the voice is busy while it plays or is paused.
+_FORCE_INLINE_ bool voice_is_busy(const AudioVoice *voice) {
+	if (audio_atomic_load(&voice->buffer->voice_generation) != voice->generation) {
+		return true;
+	}
+
+	return (audio_atomic_load(&voice->buffer->state) & AUDIO_BUFFER_STATE_PLAYING) != 0;
+}
+
+void voice_pool_init(uint32 capacity) {
+	ma_device device = audio_server_get_device();
+
+	pool.voices = (AudioVoice *)ls_calloc(capacity, sizeof(AudioVoice));
+	pool.capacity = 0;
+	pool.serial = 0;
+
+	// Voices start empty, they borrow the PCM of whatever they play
+	for (uint32 i = 0; i < capacity; i++) {
+		AudioBuffer *buffer = audio_buffer_create(AUDIO_DEVICE_FORMAT, AUDIO_DEVICE_CHANNELS, device.sampleRate, 0, AUDIO_BUFFER_USAGE_STATIC);
+		if (buffer == NULL) {
+			ls_log(LOG_LEVEL_ERROR, "Failed to create voice %u of %u\n", i, capacity);
+			break;
+		}
+
+		pool.voices[i].buffer = buffer;
+		pool.capacity++;
+	}
+
+	pool.max_voices = pool.capacity;
+}
+
+void voice_pool_deinit() {
+	// Only called once the mixer is gone, so nothing holds on to the buffers anymore
+	for (uint32 i = 0; i < pool.capacity; i++) {
+		audio_buffer_free(pool.voices[i].buffer);
+	}
+
+	if (pool.voices) {
+		ls_free(pool.voices);
+	}
+
+	pool.voices = NULL;
+	pool.capacity = 0;
+	pool.max_voices = 0;
+}
+
+void voice_pool_set_max_voices(uint32 max_voices) {
+	if (max_voices > pool.capacity) {
+		ls_log(LOG_LEVEL_WARNING, "Max voices %u is more than the pool holds, using %u\n", max_voices, pool.capacity);
+		max_voices = pool.capacity;
+	}
+
+	pool.max_voices = max_voices;
+}
+
+uint32 voice_pool_get_max_voices() {
+	return pool.max_voices;
+}
+
+uint32 voice_pool_get_busy_count() {
+	uint32 busy = 0;
+	for (uint32 i = 0; i < pool.capacity; i++) {
+		if (voice_is_busy(&pool.voices[i])) {
+			busy++;
+		}
+	}
+
+	return busy;
+}
+
+AudioBuffer *voice_pool_play(const void *owner, const AudioVoiceSettings *settings) {
+	if (settings->data == NULL || settings->frame_count == 0) {
+		return NULL;
+	}
+
+	uint32 busy = 0;
+	uint32 instances = 0;
+	AudioVoice *free_voice = NULL;
+	AudioVoice *oldest_instance = NULL;
+	AudioVoice *victim = NULL;
+
+	for (uint32 i = 0; i < pool.capacity; i++) {
+		AudioVoice *voice = &pool.voices[i];
+		if (!voice_is_busy(voice)) {
+			if (free_voice == NULL) {
+				free_voice = voice;
+			}
+
+			continue;
+		}
+
+		busy++;
+
+		if (voice->owner == owner) {
+			instances++;
+			if (oldest_instance == NULL || voice->started < oldest_instance->started) {
+				oldest_instance = voice;
+			}
+		}
+
+		if (voice->priority > settings->priority) {
+			continue;
+		}
+
+		if (victim == NULL || voice->priority < victim->priority ||
+				(voice->priority == victim->priority && voice->started < victim->started)) {
+			victim = voice;
+		}
+	}
+
+	AudioVoice *voice = NULL;
+	if (settings->max_instances > 0 && instances >= settings->max_instances) {
+		// Restarting the oldest instance keeps the sound from stacking up without going quiet
+		voice = oldest_instance;
+	} else if (free_voice != NULL && busy < pool.max_voices) {
+		voice = free_voice;
+	} else {
+		voice = victim;
+	}
+
+	if (voice == NULL) {
+		return NULL;
+	}
+
+	voice->owner = owner;
+	voice->priority = settings->priority;
+	voice->started = ++pool.serial;
+	voice->generation++;
+
+	AudioCommand command = { .type = AUDIO_COMMAND_START_VOICE, .buffer = voice->buffer, .bus = settings->bus };
+	command.voice.data = settings->data;
+	command.voice.frame_count = settings->frame_count;
+	command.voice.volume = settings->volume;
+	command.voice.pan = settings->pan;
+	command.voice.pitch = settings->pitch;
+	command.voice.generation = voice->generation;
+	audio_server_send_command(command);
+
+	return voice->buffer;
+}
+
+AudioBuffer *voice_pool_next(const void *owner, uint32 *iterator) {
+	while (*iterator < pool.capacity) {
+		AudioVoice *voice = &pool.voices[(*iterator)++];
+		if (voice->owner == owner && voice_is_busy(voice)) {
+			return voice->buffer;
+		}
+	}
+
+	return NULL;
+}
+
+void voice_pool_release_owner(const void *owner) {
+	for (uint32 i = 0; i < pool.capacity; i++) {
+		AudioVoice *voice = &pool.voices[i];
+		if (voice->owner != owner) {
+			continue;
+		}
+
+		// Stopped even when it looks idle, a start that is still queued would read the owner's data after it is gone
+		audio_buffer_stop(voice->buffer);
+		voice->owner = NULL;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#ifndef AUDIO_VOICE_POOL_H
+#define AUDIO_VOICE_POOL_H
+
+#include "core/core.h"
+
+#include "audio_buffer.h"
+
+#ifndef AUDIO_VOICE_POOL_SIZE
+#define AUDIO_VOICE_POOL_SIZE 256
+#endif // AUDIO_VOICE_POOL_SIZE
+
+// What a voice plays, the data is borrowed and has to be in the device format.
+typedef struct {
+	const uint8 *data;
+	uint32 frame_count;
+
+	float32 volume;
+	float32 pan;
+	float32 pitch;
+	AudioBus bus;
+
+	// Voices only steal from voices with the same or a lower priority
+	int32 priority;
+	// Instances of one owner allowed at once, 0 for no limit. The oldest instance is restarted past it.
+	uint32 max_instances;
+} AudioVoiceSettings;
+
+// A fixed set of voices created up front, so playing a sound never allocates.
+// Game thread only, the voices themselves are plain buffers driven through the command queue.
+void voice_pool_init(uint32 capacity);
+void voice_pool_deinit();
+
+// Caps how many voices play at once, at most the pool capacity.
+void voice_pool_set_max_voices(uint32 max_voices);
+uint32 voice_pool_get_max_voices();
+// Voices the game thread last saw playing, paused ones included.
+uint32 voice_pool_get_busy_count();
+
+// Starts the settings on a free voice, or steals the oldest lowest priority voice when max voices play.
+// Returns NULL when every playing voice is more important.
+AudioBuffer *voice_pool_play(const void *owner, const AudioVoiceSettings *settings);
+// Iterates the playing voices of owner, iterator starts at 0. Returns NULL past the last one.
+AudioBuffer *voice_pool_next(const void *owner, uint32 *iterator);
+// Stops every voice of owner and forgets it, the owner's data can be released afterwards.
+void voice_pool_release_owner(const void *owner);
+
+#endif // AUDIO_VOICE_POOL_H
\ No newline at end of file
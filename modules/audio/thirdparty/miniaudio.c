@@ -1,6 +1,7 @@
 #include "core/core.h"
 
 #define MA_MALLOC ls_malloc
+#define MA_REALLOC ls_realloc
 #define MA_FREE ls_free
 
 #define MA_NO_WAV
@@ -41,6 +41,7 @@ def configure(env):
         'core/math/matrix.h',
         'core/types/slice.h',
         'core/types/hashtable.h',
+        'core/types/spatial_index.h',
         'core/flags.h',
         'core/window.h',
         'core/input/keycodes.h',
@@ -50,6 +51,7 @@ def configure(env):
         'core/os/os.h',
         'core/os/thread.h',
         'core/config.h',
+        'core/profiler.h',
         'core/core.h',
         
         'renderer/window.h',
@@ -58,8 +60,10 @@ def configure(env):
         'renderer/buffers.h',
         'renderer/vertex_array.h',
         'renderer/texture.h',
+        'renderer/texture_atlas.h',
         'renderer/camera.h',
         'renderer/sprite.h',
+        'renderer/sprite_batch.h',
         'renderer/batch_renderer.h',
     
         'main/application.h',
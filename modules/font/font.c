@@ -3,6 +3,7 @@
 #include "core/debug.h"
 #include "core/events/events.h"
 #include "core/memory.h"
+#include "core/types/array.h"
 #include "core/types/color.h"
 
 #include "renderer/batch_renderer.h"
@@ -38,9 +39,8 @@ typedef struct {
 	const Renderer *renderer;
 	Color font_color;
 
-	Slice32 *indices;
-	BatchVertex *batch_vertices;
-	size_t batch_vertices_size;
+	// Text is drawn as a plain triangle list, indices are always 0..n-1
+	U32Array indices;
 
 	Vector2u viewport_size;
 
@@ -59,13 +59,12 @@ void font_renderer_init(const Renderer *renderer) {
 	font_renderer->callback = NULL;
 	font_renderer->user_data = NULL;
 
-	font_renderer->indices = slice32_create(128);
-	font_renderer->batch_vertices = ls_malloc(128 * sizeof(BatchVertex));
-	font_renderer->batch_vertices_size = 128;
+	u32_array_init(&font_renderer->indices, 128);
 	font_renderer->renderer = renderer;
 }
 
 void font_renderer_deinit() {
+	u32_array_destroy(&font_renderer->indices);
 	ls_free(font_renderer);
 	RFont_close();
 }
@@ -81,7 +80,10 @@ Vector2u font_draw_text(const Font *font, uint32 font_size, Color font_color, St
 
 	font_renderer->font_color = font_color;
 
+	LS_PROFILE_BEGIN("font_draw_text");
 	RFont_area size = RFont_draw_text(font->font, text, position.x, position.y, font_size);
+	LS_PROFILE_END();
+
 	return vec2u(size.w, size.h);
 }
 
@@ -100,24 +102,27 @@ void font_renderer_render_text(Texture *atlas, float32 *vertices, float32 *tcoor
 		return;
 	}
 
-	slice32_clear(font_renderer->indices);
-	if (font_renderer->batch_vertices_size < nverts) {
-		font_renderer->batch_vertices = ls_realloc(font_renderer->batch_vertices, nverts * sizeof(BatchVertex));
-		font_renderer->batch_vertices_size = nverts;
+	// Only extend the identity index list when a longer run of text shows up
+	size_t nindices = u32_array_get_size(&font_renderer->indices);
+	if (nindices < nverts) {
+		u32_array_resize(&font_renderer->indices, nverts);
+		for (size_t i = nindices; i < nverts; i++) {
+			font_renderer->indices.data[i] = (uint32)i;
+		}
 	}
 
+	// batch_renderer_draw copies the vertices, so they only need to live for this frame
+	BatchVertex *batch_vertices = ls_frame_alloc(nverts * sizeof(BatchVertex));
 	for (size_t i = 0; i < nverts; i++) {
-		BatchVertex *vertex = &font_renderer->batch_vertices[i];
+		BatchVertex *vertex = &batch_vertices[i];
 		vertex->pos = vec3(vertices[i * 3], vertices[i * 3 + 1], vertices[i * 3 + 2]);
 		vertex->tex_coords = vec2(tcoords[i * 2], tcoords[i * 2 + 1]);
 		vertex->color = font_renderer->font_color;
 		vertex->element_size = vec2(0.0f, 0.0f);
 		vertex->radius = 0.0f;
-
-		slice32_append(font_renderer->indices, SLICE_VAL32(u32, (uint32)i));
 	}
 
-	batch_renderer_draw(atlas, font_renderer->batch_vertices, slice32_get_data(font_renderer->indices), nverts, nverts);
+	batch_renderer_draw(atlas, batch_vertices, font_renderer->indices.data, nverts, nverts);
 }
 
 _FORCE_INLINE_ Texture *font_renderer_create_atlas(uint32 atlas_width, uint32 atlas_height) {
@@ -137,7 +142,8 @@ _FORCE_INLINE_ void font_renderer_bitmap_to_atlas(Texture *atlas, uint8 *bitmap,
 
 	// WebGL does not support rgba swizzling, so we need to uncompressed the bitmap data.
 
-	uint8 *uncompressed_bitmap = ls_malloc(width * height * 4 * sizeof(uint8));
+	// Uploaded immediately, frame scratch is enough
+	uint8 *uncompressed_bitmap = ls_frame_alloc(width * height * 4 * sizeof(uint8));
 	for (size_t i = 0; i < width * height; i++) {
 		uncompressed_bitmap[i * 4] = 255;
 		uncompressed_bitmap[i * 4 + 1] = 255;
@@ -146,8 +152,6 @@ _FORCE_INLINE_ void font_renderer_bitmap_to_atlas(Texture *atlas, uint8 *bitmap,
 	}
 
 	texture_add_sub_texture(atlas, TEXTURE_FORMAT_RGBA, uncompressed_bitmap, x, y, width, height);
-
-	ls_free(uncompressed_bitmap);
 }
 
 _FORCE_INLINE_ void font_renderer_free_atlas(Texture *atlas) {
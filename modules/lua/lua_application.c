@@ -74,7 +74,7 @@ static void lua_app_deinit(void *user_data) {
 		}
 	}
 	lua_pop(L, 1);
-	lua_close(L);
+	ls_lua_close_state(L);
 }
 
 static bool lua_app_should_stop(void *user_data) {
@@ -111,14 +111,14 @@ void lua_project_init(LSCore *core, Renderer *renderer) {
 	bool success = ls_lua_dofile(settings_state, PROJECT_FILE_NAME);
 	if (!success) {
 		ls_log(LOG_LEVEL_ERROR, "Error loading lua project config\n");
-		lua_close(settings_state);
+		ls_lua_close_state(settings_state);
 		return;
 	}
 
 	int32 type = lua_getglobal(settings_state, "source_files");
 	if (type != LUA_TTABLE) {
 		ls_log(LOG_LEVEL_ERROR, "No source_files table found in project settings file\n");
-		lua_close(settings_state);
+		ls_lua_close_state(settings_state);
 		return;
 	}
 
@@ -136,10 +136,10 @@ void lua_project_init(LSCore *core, Renderer *renderer) {
 		}
 	}
 
-	lua_close(settings_state);
+	ls_lua_close_state(settings_state);
 	if (!success) {
 		ls_log(LOG_LEVEL_ERROR, "Error loading lua project\n");
-		lua_close(application_state);
+		ls_lua_close_state(application_state);
 		return;
 	}
 
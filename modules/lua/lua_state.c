@@ -12,15 +12,125 @@ int32 ls_lua_error_handler(lua_State *L) {
 	return 1;
 }
 
+// Small blocks are served from per state pools in 16 byte size classes. Userdata, short strings,
+// closures and table nodes all land here, everything larger goes to the heap.
+#define LUA_POOL_GRANULARITY 16
+#define LUA_POOL_CLASSES 8
+#define LUA_POOL_BLOCK_ELEMENTS 256
+
+typedef struct {
+	LSPool *pools[LUA_POOL_CLASSES];
+} LuaAllocator;
+
+// Returns LUA_POOL_CLASSES for sizes that go to the heap.
+_FORCE_INLINE_ size_t lua_size_class(size_t size) {
+	if (size > LUA_POOL_GRANULARITY * LUA_POOL_CLASSES) {
+		return LUA_POOL_CLASSES;
+	}
+
+	return (size - 1) / LUA_POOL_GRANULARITY;
+}
+
+static void *lua_allocator_alloc(LuaAllocator *allocator, size_t size_class, size_t size) {
+	if (size_class == LUA_POOL_CLASSES) {
+		return ls_malloc(size);
+	}
+
+	if (!allocator->pools[size_class]) {
+		allocator->pools[size_class] = ls_pool_create((size_class + 1) * LUA_POOL_GRANULARITY, LUA_POOL_BLOCK_ELEMENTS);
+	}
+
+	return ls_pool_alloc(allocator->pools[size_class]);
+}
+
+static void lua_allocator_free(LuaAllocator *allocator, size_t size_class, void *ptr) {
+	if (size_class == LUA_POOL_CLASSES) {
+		ls_free(ptr);
+		return;
+	}
+
+	ls_pool_free(allocator->pools[size_class], ptr);
+}
+
+static void *ls_lua_alloc(void *user_data, void *ptr, size_t osize, size_t nsize) {
+	LuaAllocator *allocator = user_data;
+
+	// When ptr is NULL osize holds the type of the new object, not a size
+	size_t old_class = ptr ? lua_size_class(osize) : LUA_POOL_CLASSES;
+
+	if (nsize == 0) {
+		if (ptr) {
+			lua_allocator_free(allocator, old_class, ptr);
+		}
+		return NULL;
+	}
+
+	size_t new_class = lua_size_class(nsize);
+	if (!ptr) {
+		return lua_allocator_alloc(allocator, new_class, nsize);
+	}
+
+	if (old_class == new_class) {
+		return new_class == LUA_POOL_CLASSES ? ls_realloc(ptr, nsize) : ptr;
+	}
+
+	// Lua keeps the old block when growing fails, so it must stay untouched
+	void *new_ptr = lua_allocator_alloc(allocator, new_class, nsize);
+	if (!new_ptr) {
+		return NULL;
+	}
+
+	ls_memcpy(new_ptr, ptr, osize < nsize ? osize : nsize);
+	lua_allocator_free(allocator, old_class, ptr);
+
+	return new_ptr;
+}
+
+static int32 ls_lua_panic(lua_State *L) {
+	const char *msg = lua_tostring(L, -1);
+	ls_log_fatal("Unprotected error in call to Lua API: %s\n", msg ? msg : "error object is not a string");
+
+	return 0;
+}
+
+static lua_State *ls_lua_new_state() {
+	LuaAllocator *allocator = ls_calloc(1, sizeof(LuaAllocator));
+
+	lua_State *L = lua_newstate(ls_lua_alloc, allocator);
+	if (!L) {
+		ls_free(allocator);
+		ls_log_fatal("Failed to create Lua state\n");
+		return NULL;
+	}
+
+	lua_atpanic(L, ls_lua_panic);
+
+	return L;
+}
+
+void ls_lua_close_state(lua_State *L) {
+	void *user_data = NULL;
+	lua_getallocf(L, &user_data);
+	lua_close(L);
+
+	LuaAllocator *allocator = user_data;
+	for (size_t i = 0; i < LUA_POOL_CLASSES; i++) {
+		if (allocator->pools[i]) {
+			ls_pool_destroy(allocator->pools[i]);
+		}
+	}
+	ls_free(allocator);
+}
+
 lua_State *ls_lua_new_settings_state() {
-	lua_State *settings_state = luaL_newstate();
+	lua_State *settings_state = ls_lua_new_state();
 	luaL_openlibs(settings_state);
 
 	return settings_state;
 }
 
 lua_State *ls_lua_new_application_state(LSCore *core, Renderer *renderer) {
-	lua_State *application_state = luaL_newstate();
+	lua_State *application_state = ls_lua_new_state();
 	luaL_openlibs(application_state);
 
 	lua_register_types(core, application_state);
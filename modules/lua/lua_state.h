@@ -9,6 +9,8 @@
 
 LS_EXPORT lua_State *ls_lua_new_settings_state();
 LS_EXPORT lua_State *ls_lua_new_application_state(LSCore *core, Renderer *renderer);
+// Closes a state created by ls_lua_new_*_state and frees its allocator.
+LS_EXPORT void ls_lua_close_state(lua_State *L);
 
 LS_EXPORT bool ls_lua_dostring(lua_State *L, String string);
 LS_EXPORT bool ls_lua_dofile(lua_State *L, String filename);
@@ -1,5 +1,6 @@
 #include "lua_camera.h"
 
+#include "lua_keys.h"
 #include "lua_matrix.h"
 #include "lua_vector.h"
 
@@ -7,7 +8,12 @@
 #include <lua.h>
 #include <lualib.h>
 
-static Hashtable *methods = NULL;
+static struct {
+	LSAtom position;
+	LSAtom rotation;
+	LSAtom view_matrix;
+	LSAtom projection_matrix;
+} atoms;
 
 static int lua_camera_gc(lua_State *L) {
 	Camera *camera = lua_check_camera(L, 1);
@@ -18,23 +24,23 @@ static int lua_camera_gc(lua_State *L) {
 
 static int lua_camera_index(lua_State *L) {
 	Camera *camera = lua_check_camera(L, 1);
-	String key = luaL_checkstring(L, 2);
-
-	if (hashtable_contains(methods, HASH_KEY(str, key))) {
-		lua_pushcfunction(L, hashtable_get(methods, HASH_KEY(str, key)).ptr);
+	lua_CFunction method = NULL;
+	LSAtom key = lua_check_key(L, 2, &method);
+	if (method) {
+		lua_pushcfunction(L, method);
 		return 1;
 	}
 
-	if (ls_str_equals(key, "position")) {
+	if (key == atoms.position) {
 		lua_push_vector3(L, camera_get_position(camera));
 		return 1;
-	} else if (ls_str_equals(key, "rotation")) {
+	} else if (key == atoms.rotation) {
 		lua_push_vector3(L, camera_get_rotation(camera));
 		return 1;
-	} else if (ls_str_equals(key, "view_matrix")) {
+	} else if (key == atoms.view_matrix) {
 		lua_push_matrix4(L, camera_get_view_matrix(camera));
 		return 1;
-	} else if (ls_str_equals(key, "projection_matrix")) {
+	} else if (key == atoms.projection_matrix) {
 		lua_push_matrix4(L, camera_get_projection_matrix(camera));
 		return 1;
 	}
@@ -44,12 +50,12 @@ static int lua_camera_index(lua_State *L) {
 
 static int lua_camera_newindex(lua_State *L) {
 	Camera *camera = lua_check_camera(L, 1);
-	String key = luaL_checkstring(L, 2);
+	LSAtom key = lua_check_key(L, 2, NULL);
 
-	if (ls_str_equals(key, "position")) {
+	if (key == atoms.position) {
 		Vector3 position = lua_check_vector3(L, 3);
 		camera_set_position(camera, position);
-	} else if (ls_str_equals(key, "rotation")) {
+	} else if (key == atoms.rotation) {
 		Vector3 rotation = lua_check_vector3(L, 3);
 		camera_set_rotation(camera, rotation);
 	}
@@ -103,17 +109,19 @@ static const luaL_Reg camera_meta_methods[] = {
 };
 
 void lua_register_camera(lua_State *L) {
-	if (methods == NULL) {
-		methods = hashtable_create(HASHTABLE_KEY_STRING, 6, false);
-
-		hashtable_set(methods, HASH_KEY(str, "move"), HASH_VAL(ptr, lua_camera_move));
-		hashtable_set(methods, HASH_KEY(str, "rotate"), HASH_VAL(ptr, lua_camera_rotate));
-		hashtable_set(methods, HASH_KEY(str, "set_active"), HASH_VAL(ptr, lua_camera_set_active));
-		hashtable_set(methods, HASH_KEY(str, "set_projection"), HASH_VAL(ptr, lua_camera_set_projection));
-	}
-
 	luaL_newmetatable(L, "Camera");
-	luaL_setfuncs(L, camera_meta_methods, 0);
+
+	lua_new_key_table(L);
+	lua_key_table_add_method(L, "move", lua_camera_move);
+	lua_key_table_add_method(L, "rotate", lua_camera_rotate);
+	lua_key_table_add_method(L, "set_active", lua_camera_set_active);
+	lua_key_table_add_method(L, "set_projection", lua_camera_set_projection);
+	atoms.position = lua_key_table_add_atom(L, "position");
+	atoms.rotation = lua_key_table_add_atom(L, "rotation");
+	atoms.view_matrix = lua_key_table_add_atom(L, "view_matrix");
+	atoms.projection_matrix = lua_key_table_add_atom(L, "projection_matrix");
+
+	luaL_setfuncs(L, camera_meta_methods, 1);
 	lua_pop(L, 1);
 }
 
@@ -1,4 +1,5 @@
 #include "lua_color.h"
+#include "lua_keys.h"
 #include "core/memory.h"
 #include "core/types/string.h"
 #include "lua.h"
@@ -8,6 +9,13 @@
 #include <lua.h>
 #include <lualib.h>
 
+static struct {
+	LSAtom r;
+	LSAtom g;
+	LSAtom b;
+	LSAtom a;
+} atoms;
+
 static int lua_new_color(lua_State *L) {
 	int32 argc = lua_gettop(L);
 	switch (argc) {
@@ -53,42 +61,42 @@ static int lua_color_tostring(lua_State *L) {
 
 static int lua_color_index(lua_State *L) {
 	Color c = lua_check_color(L, 1);
-	const char *key = luaL_checkstring(L, 2);
-	if (ls_str_equals(key, "r")) {
+	LSAtom key = lua_check_key(L, 2, NULL);
+	if (key == atoms.r) {
 		lua_pushnumber(L, c.r);
 		return 1;
-	} else if (ls_str_equals(key, "g")) {
+	} else if (key == atoms.g) {
 		lua_pushnumber(L, c.g);
 		return 1;
-	} else if (ls_str_equals(key, "b")) {
+	} else if (key == atoms.b) {
 		lua_pushnumber(L, c.b);
 		return 1;
-	} else if (ls_str_equals(key, "a")) {
+	} else if (key == atoms.a) {
 		lua_pushnumber(L, c.a);
 		return 1;
 	}
 
-	return luaL_error(L, "invalid index '%s' for color", key);
+	return luaL_error(L, "invalid index '%s' for color", lua_tostring(L, 2));
 }
 
 static int lua_color_newindex(lua_State *L) {
 	Color *c = lua_check_color_ptr(L, 1);
-	const char *key = luaL_checkstring(L, 2);
-	if (ls_str_equals(key, "r")) {
+	LSAtom key = lua_check_key(L, 2, NULL);
+	if (key == atoms.r) {
 		c->r = luaL_checknumber(L, 3);
 		return 0;
-	} else if (ls_str_equals(key, "g")) {
+	} else if (key == atoms.g) {
 		c->g = luaL_checknumber(L, 3);
 		return 0;
-	} else if (ls_str_equals(key, "b")) {
+	} else if (key == atoms.b) {
 		c->b = luaL_checknumber(L, 3);
 		return 0;
-	} else if (ls_str_equals(key, "a")) {
+	} else if (key == atoms.a) {
 		c->a = luaL_checknumber(L, 3);
 		return 0;
 	}
 
-	return luaL_error(L, "invalid index '%s' for color", key);
+	return luaL_error(L, "invalid index '%s' for color", lua_tostring(L, 2));
 }
 
 static int lua_color_add(lua_State *L) {
@@ -140,7 +148,14 @@ static const luaL_Reg color_meta_methods[] = {
 
 void lua_register_color(lua_State *L) {
 	luaL_newmetatable(L, "MT_COLOR");
-	luaL_setfuncs(L, color_meta_methods, 0);
+
+	lua_new_key_table(L);
+	atoms.r = lua_key_table_add_atom(L, "r");
+	atoms.g = lua_key_table_add_atom(L, "g");
+	atoms.b = lua_key_table_add_atom(L, "b");
+	atoms.a = lua_key_table_add_atom(L, "a");
+
+	luaL_setfuncs(L, color_meta_methods, 1);
 	lua_pop(L, 1);
 
 	lua_register(L, "color", lua_new_color);
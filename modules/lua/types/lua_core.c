@@ -3,6 +3,8 @@
 #include "core/input/keycodes.h"
 #include "lua_event_manager.h"
 #include "lua_input_manager.h"
+#include "lua_spatial_index.h"
+#include "lua_vector.h"
 
 #include <lauxlib.h>
 #include <lua.h>
@@ -24,6 +26,56 @@ static int32 lua_mouse_button_to_string(lua_State *L) {
 	return 1;
 }
 
+static int32 lua_new_spatial_grid(lua_State *L) {
+	float32 cell_size = luaL_checknumber(L, 1);
+	luaL_argcheck(L, cell_size > 0.0f, 1, "cell size must be positive");
+
+	lua_push_spatial_index(L, spatial_index_create_grid(cell_size));
+	return 1;
+}
+
+static int32 lua_new_spatial_quadtree(lua_State *L) {
+	Vector2 min = lua_check_vector2(L, 1);
+	Vector2 max = lua_check_vector2(L, 2);
+	uint32 max_depth = luaL_optinteger(L, 3, 8);
+	luaL_argcheck(L, max.x > min.x && max.y > min.y, 2, "max must be greater than min");
+
+	lua_push_spatial_index(L, spatial_index_create_quadtree(min, max, max_depth));
+	return 1;
+}
+
+// Zone names have to outlive the profiler ring, interned strings stay valid until shutdown.
+_FORCE_INLINE_ const char *lua_check_zone_name(lua_State *L, int32 index) {
+	const char *name = luaL_checkstring(L, index);
+	return profiler_is_enabled() ? ls_str_intern(name) : name;
+}
+
+static int32 lua_profile_begin(lua_State *L) {
+	profiler_begin_zone(lua_check_zone_name(L, 1));
+	return 0;
+}
+
+static int32 lua_profile_end(lua_State *L) {
+	profiler_end_zone();
+	return 0;
+}
+
+// CORE.profile(name, function, ...) calls function in a zone and returns its results.
+static int32 lua_profile(lua_State *L) {
+	const char *name = lua_check_zone_name(L, 1);
+	luaL_checktype(L, 2, LUA_TFUNCTION);
+
+	profiler_begin_zone(name);
+	int32 status = lua_pcall(L, lua_gettop(L) - 2, LUA_MULTRET, 0);
+	profiler_end_zone();
+
+	if (status != LUA_OK) {
+		return lua_error(L);
+	}
+
+	return lua_gettop(L) - 1;
+}
+
 extern void lua_core_init_constants(lua_State *L, int32 table_index);
 
 static void lua_core_set_fields(LSCore *core, lua_State *L, int32 table_index) {
@@ -38,6 +90,16 @@ static void lua_core_set_methods(lua_State *L, int32 table_index) {
 	lua_setfield(L, table_index, "keycode_to_string");
 	lua_pushcfunction(L, lua_mouse_button_to_string);
 	lua_setfield(L, table_index, "mouse_button_to_string");
+	lua_pushcfunction(L, lua_new_spatial_grid);
+	lua_setfield(L, table_index, "new_spatial_grid");
+	lua_pushcfunction(L, lua_new_spatial_quadtree);
+	lua_setfield(L, table_index, "new_spatial_quadtree");
+	lua_pushcfunction(L, lua_profile_begin);
+	lua_setfield(L, table_index, "profile_begin");
+	lua_pushcfunction(L, lua_profile_end);
+	lua_setfield(L, table_index, "profile_end");
+	lua_pushcfunction(L, lua_profile);
+	lua_setfield(L, table_index, "profile");
 }
 
 void lua_register_core(LSCore *core, lua_State *L) {
@@ -0,0 +1,49 @@
+#include "lua_keys.h"
+
+#include <lauxlib.h>
+#include <lua.h>
+
+void lua_new_key_table(lua_State *L) {
+	lua_newtable(L);
+}
+
+void lua_key_table_set(lua_State *L, String name, uint32 id) {
+	LS_ASSERT(id != 0);
+
+	lua_pushinteger(L, id);
+	lua_setfield(L, -2, name);
+}
+
+LSAtom lua_key_table_add_atom(lua_State *L, String name) {
+	LSAtom atom = ls_atom_intern(name);
+	lua_key_table_set(L, name, atom);
+
+	return atom;
+}
+
+void lua_key_table_add_method(lua_State *L, String name, lua_CFunction method) {
+	lua_pushcfunction(L, method);
+	lua_setfield(L, -2, name);
+}
+
+uint32 lua_check_key(lua_State *L, int index, lua_CFunction *method) {
+	luaL_checkstring(L, index);
+
+	lua_pushvalue(L, index);
+	lua_rawget(L, lua_upvalueindex(1));
+
+	uint32 id = 0;
+	lua_CFunction found = NULL;
+	if (lua_iscfunction(L, -1)) {
+		found = lua_tocfunction(L, -1);
+	} else {
+		id = (uint32)lua_tointeger(L, -1);
+	}
+	lua_pop(L, 1);
+
+	if (method) {
+		*method = found;
+	}
+
+	return id;
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#ifndef LUA_KEYS_H
+#define LUA_KEYS_H
+
+#include "core/core.h"
+
+#include "lua_state.h"
+
+#include <lua.h>
+
+// Key tables map the field and method names of a userdata type to what __index and __newindex dispatch on.
+// They live in the Lua state as the first upvalue of the metamethods, so nothing is cached across states.
+// Lua strings are interned and carry their hash, looking a key up never hashes the string again.
+
+// Pushes a new, empty key table.
+void lua_new_key_table(lua_State *L);
+// Maps name to id in the key table on top of the stack. Ids are never 0.
+void lua_key_table_set(lua_State *L, String name, uint32 id);
+// Interns name and maps it to its atom in the key table on top of the stack. Returns the atom.
+// Types register again for every state, so atoms they keep stay in step with the current intern table.
+LSAtom lua_key_table_add_atom(lua_State *L, String name);
+// Maps name to method in the key table on top of the stack.
+void lua_key_table_add_method(lua_State *L, String name, lua_CFunction method);
+
+// Looks the string at index up in the key table of the running metamethod.
+// Returns its id, 0 for unknown keys and methods. method is set for method names when not NULL.
+uint32 lua_check_key(lua_State *L, int index, lua_CFunction *method);
+
+#endif // LUA_KEYS_H
\ No newline at end of file
@@ -1,9 +1,13 @@
 #include "lua_matrix.h"
 
+#include "lua_keys.h"
+
 #include <lauxlib.h>
 #include <lua.h>
 #include <lualib.h>
 
+#include <stddef.h>
+
 static int lua_new_matrix4(lua_State *L) {
 	int argc = lua_gettop(L);
 	switch (argc) {
@@ -60,59 +64,14 @@ static int lua_matrix4_index(lua_State *L) {
 		return 1;
 	}
 
-	const char *key = luaL_checkstring(L, 2);
-
-	if (ls_str_equals(key, "x0")) {
-		lua_pushnumber(L, m.x0);
-		return 1;
-	} else if (ls_str_equals(key, "x1")) {
-		lua_pushnumber(L, m.x1);
-		return 1;
-	} else if (ls_str_equals(key, "x2")) {
-		lua_pushnumber(L, m.x2);
-		return 1;
-	} else if (ls_str_equals(key, "x3")) {
-		lua_pushnumber(L, m.x3);
-		return 1;
-	} else if (ls_str_equals(key, "y0")) {
-		lua_pushnumber(L, m.y0);
-		return 1;
-	} else if (ls_str_equals(key, "y1")) {
-		lua_pushnumber(L, m.y1);
-		return 1;
-	} else if (ls_str_equals(key, "y2")) {
-		lua_pushnumber(L, m.y2);
-		return 1;
-	} else if (ls_str_equals(key, "y3")) {
-		lua_pushnumber(L, m.y3);
-		return 1;
-	} else if (ls_str_equals(key, "z0")) {
-		lua_pushnumber(L, m.z0);
-		return 1;
-	} else if (ls_str_equals(key, "z1")) {
-		lua_pushnumber(L, m.z1);
-		return 1;
-	} else if (ls_str_equals(key, "z2")) {
-		lua_pushnumber(L, m.z2);
-		return 1;
-	} else if (ls_str_equals(key, "z3")) {
-		lua_pushnumber(L, m.z3);
-		return 1;
-	} else if (ls_str_equals(key, "w0")) {
-		lua_pushnumber(L, m.w0);
-		return 1;
-	} else if (ls_str_equals(key, "w1")) {
-		lua_pushnumber(L, m.w1);
-		return 1;
-	} else if (ls_str_equals(key, "w2")) {
-		lua_pushnumber(L, m.w2);
-		return 1;
-	} else if (ls_str_equals(key, "w3")) {
-		lua_pushnumber(L, m.w3);
+	// Named fields map to their index in Matrix4.mat plus one
+	uint32 field = lua_check_key(L, 2, NULL);
+	if (field) {
+		lua_pushnumber(L, m.mat[field - 1]);
 		return 1;
 	}
 
-	return luaL_error(L, "invalid index '%s' for matrix4", key);
+	return luaL_error(L, "invalid index '%s' for matrix4", lua_tostring(L, 2));
 }
 
 static int lua_matrix4_newindex(lua_State *L) {
@@ -126,59 +85,14 @@ static int lua_matrix4_newindex(lua_State *L) {
 		return 0;
 	}
 
-	const char *key = luaL_checkstring(L, 2);
-
-	if (ls_str_equals(key, "x0")) {
-		m->x0 = luaL_checknumber(L, 3);
-		return 0;
-	} else if (ls_str_equals(key, "x1")) {
-		m->x1 = luaL_checknumber(L, 3);
-		return 0;
-	} else if (ls_str_equals(key, "x2")) {
-		m->x2 = luaL_checknumber(L, 3);
-		return 0;
-	} else if (ls_str_equals(key, "x3")) {
-		m->x3 = luaL_checknumber(L, 3);
-		return 0;
-	} else if (ls_str_equals(key, "y0")) {
-		m->y0 = luaL_checknumber(L, 3);
-		return 0;
-	} else if (ls_str_equals(key, "y1")) {
-		m->y1 = luaL_checknumber(L, 3);
-		return 0;
-	} else if (ls_str_equals(key, "y2")) {
-		m->y2 = luaL_checknumber(L, 3);
-		return 0;
-	} else if (ls_str_equals(key, "y3")) {
-		m->y3 = luaL_checknumber(L, 3);
-		return 0;
-	} else if (ls_str_equals(key, "z0")) {
-		m->z0 = luaL_checknumber(L, 3);
-		return 0;
-	} else if (ls_str_equals(key, "z1")) {
-		m->z1 = luaL_checknumber(L, 3);
-		return 0;
-	} else if (ls_str_equals(key, "z2")) {
-		m->z2 = luaL_checknumber(L, 3);
-		return 0;
-	} else if (ls_str_equals(key, "z3")) {
-		m->z3 = luaL_checknumber(L, 3);
-		return 0;
-	} else if (ls_str_equals(key, "w0")) {
-		m->w0 = luaL_checknumber(L, 3);
-		return 0;
-	} else if (ls_str_equals(key, "w1")) {
-		m->w1 = luaL_checknumber(L, 3);
-		return 0;
-	} else if (ls_str_equals(key, "w2")) {
-		m->w2 = luaL_checknumber(L, 3);
-		return 0;
-	} else if (ls_str_equals(key, "w3")) {
-		m->w3 = luaL_checknumber(L, 3);
+	// Named fields map to their index in Matrix4.mat plus one
+	uint32 field = lua_check_key(L, 2, NULL);
+	if (field) {
+		m->mat[field - 1] = luaL_checknumber(L, 3);
 		return 0;
 	}
 
-	return luaL_error(L, "invalid index '%s' for matrix4", key);
+	return luaL_error(L, "invalid index '%s' for matrix4", lua_tostring(L, 2));
 }
 
 static int lua_matrix4_multiply(lua_State *L) {
@@ -229,8 +143,37 @@ static const luaL_Reg matrix4_meta_methods[] = {
 };
 
 void lua_register_matrix4(lua_State *L) {
+	static const struct {
+		String name;
+		size_t offset;
+	} field_offsets[] = {
+		{ "x0", offsetof(Matrix4, x0) },
+		{ "x1", offsetof(Matrix4, x1) },
+		{ "x2", offsetof(Matrix4, x2) },
+		{ "x3", offsetof(Matrix4, x3) },
+		{ "y0", offsetof(Matrix4, y0) },
+		{ "y1", offsetof(Matrix4, y1) },
+		{ "y2", offsetof(Matrix4, y2) },
+		{ "y3", offsetof(Matrix4, y3) },
+		{ "z0", offsetof(Matrix4, z0) },
+		{ "z1", offsetof(Matrix4, z1) },
+		{ "z2", offsetof(Matrix4, z2) },
+		{ "z3", offsetof(Matrix4, z3) },
+		{ "w0", offsetof(Matrix4, w0) },
+		{ "w1", offsetof(Matrix4, w1) },
+		{ "w2", offsetof(Matrix4, w2) },
+		{ "w3", offsetof(Matrix4, w3) },
+	};
+
 	luaL_newmetatable(L, "Matrix4");
-	luaL_setfuncs(L, matrix4_meta_methods, 0);
+
+	lua_new_key_table(L);
+	for (size_t i = 0; i < sizeof(field_offsets) / sizeof(field_offsets[0]); i++) {
+		uint32 index = field_offsets[i].offset / sizeof(float32);
+		lua_key_table_set(L, field_offsets[i].name, index + 1);
+	}
+
+	luaL_setfuncs(L, matrix4_meta_methods, 1);
 	lua_pop(L, 1);
 
 	lua_register(L, "mat4", lua_new_matrix4);
@@ -5,6 +5,8 @@
 #include "lua_vector.h"
 #include "lua_window.h"
 
+#include "renderer/batch_renderer.h"
+
 #include <lauxlib.h>
 #include <lua.h>
 #include <lualib.h>
@@ -67,7 +69,8 @@ static int lua_renderer_new_sprite(lua_State *L) {
 	Vector2 scale = lua_check_vector2(L, 4);
 	float32 rotation = luaL_checknumber(L, 5);
 
-	Sprite *sprite = renderer_create_sprite(renderer, path, position, scale, rotation);
+	// Decodes in the background so scripts can create sprites without stalling the frame
+	Sprite *sprite = renderer_create_sprite_async(renderer, path, position, scale, rotation);
 
 	lua_push_sprite(L, sprite);
 
@@ -88,6 +91,20 @@ static int lua_renderer_new_camera(lua_State *L) {
 	return 1;
 }
 
+static int lua_renderer_new_orthographic_camera(lua_State *L) {
+	lua_check_renderer(L, 1);
+	float32 width = luaL_checknumber(L, 2);
+	float32 height = luaL_checknumber(L, 3);
+	float32 near = luaL_checknumber(L, 4);
+	float32 far = luaL_checknumber(L, 5);
+
+	Camera *camera = camera_create_orthographic(width, height, near, far);
+
+	lua_push_camera(L, camera);
+
+	return 1;
+}
+
 static int lua_renderer_set_clear_color(lua_State *L) {
 	Renderer *renderer = lua_check_renderer(L, 1);
 
@@ -127,6 +144,22 @@ static int lua_renderer_get_viewport_size(lua_State *L) {
 	return 1;
 }
 
+// Returns the world rect seen by the active camera, or nil when nothing is culled.
+static int lua_renderer_get_visible_rect(lua_State *L) {
+	lua_check_renderer(L, 1);
+
+	Vector2 min, max;
+	if (!batch_renderer_get_visible_rect(&min, &max)) {
+		lua_pushnil(L);
+		return 1;
+	}
+
+	lua_push_vector2(L, min);
+	lua_push_vector2(L, max);
+
+	return 2;
+}
+
 static const luaL_Reg renderer_meta_methods[] = {
 	{ NULL, NULL }
 };
@@ -149,11 +182,17 @@ static void lua_renderer_set_methods(lua_State *L, int32 table_index) {
 	lua_pushcfunction(L, lua_renderer_new_camera);
 	lua_setfield(L, table_index, "new_camera");
 
+	lua_pushcfunction(L, lua_renderer_new_orthographic_camera);
+	lua_setfield(L, table_index, "new_orthographic_camera");
+
 	lua_pushcfunction(L, lua_renderer_get_backend);
 	lua_setfield(L, table_index, "get_backend");
 
 	lua_pushcfunction(L, lua_renderer_get_viewport_size);
 	lua_setfield(L, table_index, "get_viewport_size");
+
+	lua_pushcfunction(L, lua_renderer_get_visible_rect);
+	lua_setfield(L, table_index, "get_visible_rect");
 }
 
 void lua_register_renderer(lua_State *L) {
@@ -0,0 +1,211 @@
+#include "lua_spatial_index.h"
+
+#include "lua_keys.h"
+#include "lua_vector.h"
+
+#include <lauxlib.h>
+#include <lua.h>
+#include <lualib.h>
+
+typedef struct {
+	SpatialIndex *index;
+	// Registry reference to a table of inserted values keyed by handle
+	int values;
+} LuaSpatialIndex;
+
+typedef struct {
+	lua_State *L;
+	int values;
+	int result;
+	lua_Integer n;
+} LuaSpatialQuery;
+
+static LSAtom atom_count = LS_ATOM_NONE;
+
+static LuaSpatialIndex *lua_check_spatial_index_udata(lua_State *L, int index) {
+	return (LuaSpatialIndex *)luaL_checkudata(L, index, "MT_SPATIAL_INDEX");
+}
+
+static uint32 lua_check_spatial_handle(lua_State *L, LuaSpatialIndex *udata, int index) {
+	uint32 handle = luaL_checkinteger(L, index);
+	luaL_argcheck(L, spatial_index_contains(udata->index, handle), index, "invalid spatial index handle");
+
+	return handle;
+}
+
+static int lua_spatial_index_gc(lua_State *L) {
+	LuaSpatialIndex *udata = lua_check_spatial_index_udata(L, 1);
+	spatial_index_destroy(udata->index);
+	luaL_unref(L, LUA_REGISTRYINDEX, udata->values);
+
+	return 0;
+}
+
+static int lua_spatial_index_index(lua_State *L) {
+	LuaSpatialIndex *udata = lua_check_spatial_index_udata(L, 1);
+	lua_CFunction method = NULL;
+	LSAtom key = lua_check_key(L, 2, &method);
+	if (method) {
+		lua_pushcfunction(L, method);
+		return 1;
+	}
+
+	if (key == atom_count) {
+		lua_pushinteger(L, spatial_index_get_count(udata->index));
+		return 1;
+	}
+
+	return 0;
+}
+
+static int lua_spatial_index_insert(lua_State *L) {
+	LuaSpatialIndex *udata = lua_check_spatial_index_udata(L, 1);
+	Vector2 min = lua_check_vector2(L, 2);
+	Vector2 max = lua_check_vector2(L, 3);
+	luaL_checkany(L, 4);
+
+	uint32 handle = spatial_index_insert(udata->index, min, max, NULL);
+
+	lua_rawgeti(L, LUA_REGISTRYINDEX, udata->values);
+	lua_pushvalue(L, 4);
+	lua_rawseti(L, -2, handle);
+	lua_pop(L, 1);
+
+	lua_pushinteger(L, handle);
+
+	return 1;
+}
+
+static int lua_spatial_index_update(lua_State *L) {
+	LuaSpatialIndex *udata = lua_check_spatial_index_udata(L, 1);
+	uint32 handle = lua_check_spatial_handle(L, udata, 2);
+	Vector2 min = lua_check_vector2(L, 3);
+	Vector2 max = lua_check_vector2(L, 4);
+
+	spatial_index_update(udata->index, handle, min, max);
+
+	return 0;
+}
+
+static int lua_spatial_index_remove(lua_State *L) {
+	LuaSpatialIndex *udata = lua_check_spatial_index_udata(L, 1);
+	uint32 handle = lua_check_spatial_handle(L, udata, 2);
+
+	spatial_index_remove(udata->index, handle);
+
+	lua_rawgeti(L, LUA_REGISTRYINDEX, udata->values);
+	lua_pushnil(L);
+	lua_rawseti(L, -2, handle);
+	lua_pop(L, 1);
+
+	return 0;
+}
+
+static int lua_spatial_index_clear(lua_State *L) {
+	LuaSpatialIndex *udata = lua_check_spatial_index_udata(L, 1);
+
+	spatial_index_clear(udata->index);
+
+	lua_newtable(L);
+	lua_rawseti(L, LUA_REGISTRYINDEX, udata->values);
+
+	return 0;
+}
+
+static bool lua_spatial_index_collect(uint32 handle, void *data, void *user_data) {
+	LuaSpatialQuery *query = user_data;
+
+	lua_rawgeti(query->L, query->values, handle);
+	lua_rawseti(query->L, query->result, ++query->n);
+
+	return true;
+}
+
+// Pushes an array of the values overlapping min to max.
+static void lua_spatial_index_push_query(lua_State *L, LuaSpatialIndex *udata, Vector2 min, Vector2 max) {
+	lua_rawgeti(L, LUA_REGISTRYINDEX, udata->values);
+	lua_newtable(L);
+
+	LuaSpatialQuery query = {
+		.L = L,
+		.values = lua_gettop(L) - 1,
+		.result = lua_gettop(L),
+		.n = 0,
+	};
+	spatial_index_query_rect(udata->index, min, max, lua_spatial_index_collect, &query);
+
+	lua_remove(L, query.values);
+}
+
+static int lua_spatial_index_query_rect(lua_State *L) {
+	LuaSpatialIndex *udata = lua_check_spatial_index_udata(L, 1);
+	Vector2 min = lua_check_vector2(L, 2);
+	Vector2 max = lua_check_vector2(L, 3);
+
+	lua_spatial_index_push_query(L, udata, min, max);
+
+	return 1;
+}
+
+static int lua_spatial_index_query_point(lua_State *L) {
+	LuaSpatialIndex *udata = lua_check_spatial_index_udata(L, 1);
+	Vector2 point = lua_check_vector2(L, 2);
+
+	lua_spatial_index_push_query(L, udata, point, point);
+
+	return 1;
+}
+
+static const luaL_Reg spatial_index_meta_methods[] = {
+	{ "__index", lua_spatial_index_index },
+	{ "__gc", lua_spatial_index_gc },
+	{ NULL, NULL }
+};
+
+void lua_register_spatial_index(lua_State *L) {
+	luaL_newmetatable(L, "MT_SPATIAL_INDEX");
+
+	lua_new_key_table(L);
+	lua_key_table_add_method(L, "insert", lua_spatial_index_insert);
+	lua_key_table_add_method(L, "update", lua_spatial_index_update);
+	lua_key_table_add_method(L, "remove", lua_spatial_index_remove);
+	lua_key_table_add_method(L, "clear", lua_spatial_index_clear);
+	lua_key_table_add_method(L, "query_rect", lua_spatial_index_query_rect);
+	lua_key_table_add_method(L, "query_point", lua_spatial_index_query_point);
+	atom_count = lua_key_table_add_atom(L, "count");
+
+	luaL_setfuncs(L, spatial_index_meta_methods, 1);
+	lua_pop(L, 1);
+}
+
+void lua_push_spatial_index(lua_State *L, SpatialIndex *index) {
+	LuaSpatialIndex *udata = (LuaSpatialIndex *)lua_newuserdata(L, sizeof(LuaSpatialIndex));
+	udata->index = index;
+
+	lua_newtable(L);
+	udata->values = luaL_ref(L, LUA_REGISTRYINDEX);
+
+	luaL_getmetatable(L, "MT_SPATIAL_INDEX");
+	lua_setmetatable(L, -2);
+}
+
+bool lua_is_spatial_index(lua_State *L, int index) {
+	if (!lua_isuserdata(L, index)) {
+		return 0;
+	}
+
+	if (lua_getmetatable(L, index)) {
+		lua_getfield(L, LUA_REGISTRYINDEX, "MT_SPATIAL_INDEX");
+		if (lua_rawequal(L, -1, -2)) {
+			lua_pop(L, 2);
+			return 1;
+		}
+		lua_pop(L, 2);
+	}
+
+	return 0;
+}
+
+SpatialIndex *lua_check_spatial_index(lua_State *L, int index) {
+	return lua_check_spatial_index_udata(L, index)->index;
+}
\ No newline at end of file
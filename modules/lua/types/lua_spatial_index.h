@@ -0,0 +1,15 @@
+#ifndef LUA_SPATIAL_INDEX_H
+#define LUA_SPATIAL_INDEX_H
+
+#include "core/core.h"
+
+#include "lua_state.h"
+
+void lua_register_spatial_index(lua_State *L);
+
+// Pushes a new Lua owned spatial index. Lua values are stored per handle and returned by queries.
+LS_EXPORT void lua_push_spatial_index(lua_State *L, SpatialIndex *index);
+LS_EXPORT bool lua_is_spatial_index(lua_State *L, int index);
+LS_EXPORT SpatialIndex *lua_check_spatial_index(lua_State *L, int index);
+
+#endif // LUA_SPATIAL_INDEX_H
\ No newline at end of file
@@ -1,12 +1,19 @@
 #include "lua_sprite.h"
 
+#include "lua_keys.h"
 #include "lua_vector.h"
 
 #include <lauxlib.h>
 #include <lua.h>
 #include <lualib.h>
 
-static Hashtable *methods = NULL;
+static struct {
+	LSAtom position;
+	LSAtom rotation;
+	LSAtom scale;
+	LSAtom loaded;
+	LSAtom world_space;
+} atoms;
 
 static int lua_sprite_gc(lua_State *L) {
 	Sprite *sprite = lua_check_sprite(L, 1);
@@ -17,22 +24,28 @@ static int lua_sprite_gc(lua_State *L) {
 
 static int lua_sprite_index(lua_State *L) {
 	Sprite *sprite = lua_check_sprite(L, 1);
-	String key = luaL_checkstring(L, 2);
-
-	if (hashtable_contains(methods, HASH_KEY(str, key))) {
-		lua_pushcfunction(L, hashtable_get(methods, HASH_KEY(str, key)).ptr);
+	lua_CFunction method = NULL;
+	LSAtom key = lua_check_key(L, 2, &method);
+	if (method) {
+		lua_pushcfunction(L, method);
 		return 1;
 	}
 
-	if (ls_str_equals(key, "position")) {
+	if (key == atoms.position) {
 		lua_push_vector2(L, sprite_get_position(sprite));
 		return 1;
-	} else if (ls_str_equals(key, "rotation")) {
+	} else if (key == atoms.rotation) {
 		lua_pushnumber(L, sprite_get_rotation(sprite));
 		return 1;
-	} else if (ls_str_equals(key, "scale")) {
+	} else if (key == atoms.scale) {
 		lua_push_vector2(L, sprite_get_scale(sprite));
 		return 1;
+	} else if (key == atoms.loaded) {
+		lua_pushboolean(L, sprite_is_loaded(sprite));
+		return 1;
+	} else if (key == atoms.world_space) {
+		lua_pushboolean(L, sprite_is_world_space(sprite));
+		return 1;
 	}
 
 	return 0;
@@ -40,17 +53,19 @@ static int lua_sprite_index(lua_State *L) {
 
 static int lua_sprite_newindex(lua_State *L) {
 	Sprite *sprite = lua_check_sprite(L, 1);
-	String key = luaL_checkstring(L, 2);
+	LSAtom key = lua_check_key(L, 2, NULL);
 
-	if (ls_str_equals(key, "position")) {
+	if (key == atoms.position) {
 		Vector2 position = lua_check_vector2(L, 3);
 		sprite_set_position(sprite, position);
-	} else if (ls_str_equals(key, "rotation")) {
+	} else if (key == atoms.rotation) {
 		float32 rotation = luaL_checknumber(L, 3);
 		sprite_set_rotation(sprite, rotation);
-	} else if (ls_str_equals(key, "scale")) {
+	} else if (key == atoms.scale) {
 		Vector2 scale = lua_check_vector2(L, 3);
 		sprite_set_scale(sprite, scale);
+	} else if (key == atoms.world_space) {
+		sprite_set_world_space(sprite, lua_toboolean(L, 3));
 	}
 
 	return 0;
@@ -64,6 +79,18 @@ static int lua_sprite_draw(lua_State *L) {
 	return 0;
 }
 
+static int lua_sprite_get_bounds(lua_State *L) {
+	Sprite *sprite = lua_check_sprite(L, 1);
+
+	Vector2 min, max;
+	sprite_get_bounds(sprite, &min, &max);
+
+	lua_push_vector2(L, min);
+	lua_push_vector2(L, max);
+
+	return 2;
+}
+
 static const luaL_Reg sprite_meta_methods[] = {
 	{ "__index", lua_sprite_index },
 	{ "__newindex", lua_sprite_newindex },
@@ -72,14 +99,18 @@ static const luaL_Reg sprite_meta_methods[] = {
 };
 
 void lua_register_sprite(lua_State *L) {
-	if (methods == NULL) {
-		methods = hashtable_create(HASHTABLE_KEY_STRING, 1, false);
+	luaL_newmetatable(L, "MT_SPRITE");
 
-		hashtable_set(methods, HASH_KEY(str, "draw"), HASH_VAL(ptr, lua_sprite_draw));
-	}
+	lua_new_key_table(L);
+	lua_key_table_add_method(L, "draw", lua_sprite_draw);
+	lua_key_table_add_method(L, "get_bounds", lua_sprite_get_bounds);
+	atoms.position = lua_key_table_add_atom(L, "position");
+	atoms.rotation = lua_key_table_add_atom(L, "rotation");
+	atoms.scale = lua_key_table_add_atom(L, "scale");
+	atoms.loaded = lua_key_table_add_atom(L, "loaded");
+	atoms.world_space = lua_key_table_add_atom(L, "world_space");
 
-	luaL_newmetatable(L, "MT_SPRITE");
-	luaL_setfuncs(L, sprite_meta_methods, 0);
+	luaL_setfuncs(L, sprite_meta_methods, 1);
 	lua_pop(L, 1);
 }
 
@@ -8,6 +8,7 @@
 #include "lua_input_manager.h"
 #include "lua_matrix.h"
 #include "lua_renderer.h"
+#include "lua_spatial_index.h"
 #include "lua_sprite.h"
 #include "lua_state.h"
 #include "lua_vector.h"
@@ -1,9 +1,27 @@
 #include "lua_vector.h"
 
+#include "lua_keys.h"
+
 #include <lauxlib.h>
 #include <lua.h>
 #include <lualib.h>
 
+static struct {
+	LSAtom x;
+	LSAtom y;
+	LSAtom z;
+} atoms;
+
+// Pushes the key table the vector metamethods take as their upvalue
+static void lua_vector_new_key_table(lua_State *L, uint32 components) {
+	lua_new_key_table(L);
+	atoms.x = lua_key_table_add_atom(L, "x");
+	atoms.y = lua_key_table_add_atom(L, "y");
+	if (components > 2) {
+		atoms.z = lua_key_table_add_atom(L, "z");
+	}
+}
+
 static int lua_vector2_eq(lua_State *L) {
 	Vector2 *v1 = luaL_checkudata(L, 1, "MT_VECTOR2");
 	Vector2 *v2 = luaL_checkudata(L, 2, "MT_VECTOR2");
@@ -55,10 +73,10 @@ static int lua_vector2_tostring(lua_State *L) {
 
 static int lua_vecto2_index(lua_State *L) {
 	Vector2 *v = luaL_checkudata(L, 1, "MT_VECTOR2");
-	const char *key = luaL_checkstring(L, 2);
-	if (ls_str_equals(key, "x") == 0) {
+	LSAtom key = lua_check_key(L, 2, NULL);
+	if (key == atoms.x) {
 		lua_pushnumber(L, v->x);
-	} else if (ls_str_equals(key, "y") == 0) {
+	} else if (key == atoms.y) {
 		lua_pushnumber(L, v->y);
 	} else {
 		lua_pushnil(L);
@@ -68,10 +86,10 @@ static int lua_vecto2_index(lua_State *L) {
 
 static int lua_vector2_newindex(lua_State *L) {
 	Vector2 *v = luaL_checkudata(L, 1, "MT_VECTOR2");
-	const char *key = luaL_checkstring(L, 2);
-	if (ls_str_equals(key, "x") == 0) {
+	LSAtom key = lua_check_key(L, 2, NULL);
+	if (key == atoms.x) {
 		v->x = luaL_checknumber(L, 3);
-	} else if (ls_str_equals(key, "y") == 0) {
+	} else if (key == atoms.y) {
 		v->y = luaL_checknumber(L, 3);
 	}
 	return 0;
@@ -100,7 +118,8 @@ static int lua_new_vector2(lua_State *L) {
 void lua_register_vector2(lua_State *L) {
 	luaL_newmetatable(L, "MT_VECTOR2");
 
-	luaL_setfuncs(L, vector2_meta_methods, 0);
+	lua_vector_new_key_table(L, 2);
+	luaL_setfuncs(L, vector2_meta_methods, 1);
 	lua_pop(L, 1);
 
 	lua_pushcfunction(L, lua_new_vector2);
@@ -189,10 +208,10 @@ static int lua_vector2i_tostring(lua_State *L) {
 
 static int lua_vecto2i_index(lua_State *L) {
 	Vector2i *v = luaL_checkudata(L, 1, "MT_VECTOR2I");
-	const char *key = luaL_checkstring(L, 2);
-	if (ls_str_equals(key, "x") == 0) {
+	LSAtom key = lua_check_key(L, 2, NULL);
+	if (key == atoms.x) {
 		lua_pushinteger(L, v->x);
-	} else if (ls_str_equals(key, "y") == 0) {
+	} else if (key == atoms.y) {
 		lua_pushinteger(L, v->y);
 	} else {
 		lua_pushnil(L);
@@ -202,10 +221,10 @@ static int lua_vecto2i_index(lua_State *L) {
 
 static int lua_vector2i_newindex(lua_State *L) {
 	Vector2i *v = luaL_checkudata(L, 1, "MT_VECTOR2I");
-	const char *key = luaL_checkstring(L, 2);
-	if (ls_str_equals(key, "x") == 0) {
+	LSAtom key = lua_check_key(L, 2, NULL);
+	if (key == atoms.x) {
 		v->x = luaL_checkinteger(L, 3);
-	} else if (ls_str_equals(key, "y") == 0) {
+	} else if (key == atoms.y) {
 		v->y = luaL_checkinteger(L, 3);
 	}
 	return 0;
@@ -234,7 +253,8 @@ static int lua_new_vector2i(lua_State *L) {
 void lua_register_vector2i(lua_State *L) {
 	luaL_newmetatable(L, "MT_VECTOR2I");
 
-	luaL_setfuncs(L, vector2i_meta_methods, 0);
+	lua_vector_new_key_table(L, 2);
+	luaL_setfuncs(L, vector2i_meta_methods, 1);
 	lua_pop(L, 1);
 
 	lua_pushcfunction(L, lua_new_vector2i);
@@ -323,10 +343,10 @@ static int lua_vector2u_tostring(lua_State *L) {
 
 static int lua_vecto2u_index(lua_State *L) {
 	Vector2u *v = luaL_checkudata(L, 1, "MT_VECTOR2U");
-	const char *key = luaL_checkstring(L, 2);
-	if (ls_str_equals(key, "x") == 0) {
+	LSAtom key = lua_check_key(L, 2, NULL);
+	if (key == atoms.x) {
 		lua_pushinteger(L, v->x);
-	} else if (ls_str_equals(key, "y") == 0) {
+	} else if (key == atoms.y) {
 		lua_pushinteger(L, v->y);
 	} else {
 		lua_pushnil(L);
@@ -336,10 +356,10 @@ static int lua_vecto2u_index(lua_State *L) {
 
 static int lua_vector2u_newindex(lua_State *L) {
 	Vector2u *v = luaL_checkudata(L, 1, "MT_VECTOR2U");
-	const char *key = luaL_checkstring(L, 2);
-	if (ls_str_equals(key, "x") == 0) {
+	LSAtom key = lua_check_key(L, 2, NULL);
+	if (key == atoms.x) {
 		v->x = luaL_checkinteger(L, 3);
-	} else if (ls_str_equals(key, "y") == 0) {
+	} else if (key == atoms.y) {
 		v->y = luaL_checkinteger(L, 3);
 	}
 	return 0;
@@ -368,7 +388,8 @@ static int lua_new_vector2u(lua_State *L) {
 void lua_register_vector2u(lua_State *L) {
 	luaL_newmetatable(L, "MT_VECTOR2U");
 
-	luaL_setfuncs(L, vector2u_meta_methods, 0);
+	lua_vector_new_key_table(L, 2);
+	luaL_setfuncs(L, vector2u_meta_methods, 1);
 	lua_pop(L, 1);
 
 	lua_pushcfunction(L, lua_new_vector2u);
@@ -457,12 +478,12 @@ static int lua_vector3_tostring(lua_State *L) {
 
 static int lua_vecto3_index(lua_State *L) {
 	Vector3 *v = luaL_checkudata(L, 1, "MT_VECTOR3");
-	const char *key = luaL_checkstring(L, 2);
-	if (ls_str_equals(key, "x") == 0) {
+	LSAtom key = lua_check_key(L, 2, NULL);
+	if (key == atoms.x) {
 		lua_pushnumber(L, v->x);
-	} else if (ls_str_equals(key, "y") == 0) {
+	} else if (key == atoms.y) {
 		lua_pushnumber(L, v->y);
-	} else if (ls_str_equals(key, "z") == 0) {
+	} else if (key == atoms.z) {
 		lua_pushnumber(L, v->z);
 	} else {
 		lua_pushnil(L);
@@ -472,12 +493,12 @@ static int lua_vecto3_index(lua_State *L) {
 
 static int lua_vector3_newindex(lua_State *L) {
 	Vector3 *v = luaL_checkudata(L, 1, "MT_VECTOR3");
-	const char *key = luaL_checkstring(L, 2);
-	if (ls_str_equals(key, "x") == 0) {
+	LSAtom key = lua_check_key(L, 2, NULL);
+	if (key == atoms.x) {
 		v->x = luaL_checknumber(L, 3);
-	} else if (ls_str_equals(key, "y") == 0) {
+	} else if (key == atoms.y) {
 		v->y = luaL_checknumber(L, 3);
-	} else if (ls_str_equals(key, "z") == 0) {
+	} else if (key == atoms.z) {
 		v->z = luaL_checknumber(L, 3);
 	}
 	return 0;
@@ -507,7 +528,8 @@ static int lua_new_vector3(lua_State *L) {
 void lua_register_vector3(lua_State *L) {
 	luaL_newmetatable(L, "MT_VECTOR3");
 
-	luaL_setfuncs(L, vector3_meta_methods, 0);
+	lua_vector_new_key_table(L, 3);
+	luaL_setfuncs(L, vector3_meta_methods, 1);
 	lua_pop(L, 1);
 
 	lua_pushcfunction(L, lua_new_vector3);
@@ -596,12 +618,12 @@ static int lua_vector3i_tostring(lua_State *L) {
 
 static int lua_vecto3i_index(lua_State *L) {
 	Vector3i *v = luaL_checkudata(L, 1, "MT_VECTOR3I");
-	const char *key = luaL_checkstring(L, 2);
-	if (ls_str_equals(key, "x") == 0) {
+	LSAtom key = lua_check_key(L, 2, NULL);
+	if (key == atoms.x) {
 		lua_pushinteger(L, v->x);
-	} else if (ls_str_equals(key, "y") == 0) {
+	} else if (key == atoms.y) {
 		lua_pushinteger(L, v->y);
-	} else if (ls_str_equals(key, "z") == 0) {
+	} else if (key == atoms.z) {
 		lua_pushinteger(L, v->z);
 	} else {
 		lua_pushnil(L);
@@ -611,12 +633,12 @@ static int lua_vecto3i_index(lua_State *L) {
 
 static int lua_vector3i_newindex(lua_State *L) {
 	Vector3i *v = luaL_checkudata(L, 1, "MT_VECTOR3I");
-	const char *key = luaL_checkstring(L, 2);
-	if (ls_str_equals(key, "x") == 0) {
+	LSAtom key = lua_check_key(L, 2, NULL);
+	if (key == atoms.x) {
 		v->x = luaL_checkinteger(L, 3);
-	} else if (ls_str_equals(key, "y") == 0) {
+	} else if (key == atoms.y) {
 		v->y = luaL_checkinteger(L, 3);
-	} else if (ls_str_equals(key, "z") == 0) {
+	} else if (key == atoms.z) {
 		v->z = luaL_checkinteger(L, 3);
 	}
 	return 0;
@@ -646,7 +668,8 @@ static int lua_new_vector3i(lua_State *L) {
 void lua_register_vector3i(lua_State *L) {
 	luaL_newmetatable(L, "MT_VECTOR3I");
 
-	luaL_setfuncs(L, vector3i_meta_methods, 0);
+	lua_vector_new_key_table(L, 3);
+	luaL_setfuncs(L, vector3i_meta_methods, 1);
 	lua_pop(L, 1);
 
 	lua_pushcfunction(L, lua_new_vector3i);
@@ -735,12 +758,12 @@ static int lua_vector3u_tostring(lua_State *L) {
 
 static int lua_vecto3u_index(lua_State *L) {
 	Vector3u *v = luaL_checkudata(L, 1, "MT_VECTOR3U");
-	const char *key = luaL_checkstring(L, 2);
-	if (ls_str_equals(key, "x") == 0) {
+	LSAtom key = lua_check_key(L, 2, NULL);
+	if (key == atoms.x) {
 		lua_pushinteger(L, v->x);
-	} else if (ls_str_equals(key, "y") == 0) {
+	} else if (key == atoms.y) {
 		lua_pushinteger(L, v->y);
-	} else if (ls_str_equals(key, "z") == 0) {
+	} else if (key == atoms.z) {
 		lua_pushinteger(L, v->z);
 	} else {
 		lua_pushnil(L);
@@ -750,12 +773,12 @@ static int lua_vecto3u_index(lua_State *L) {
 
 static int lua_vector3u_newindex(lua_State *L) {
 	Vector3u *v = luaL_checkudata(L, 1, "MT_VECTOR3U");
-	const char *key = luaL_checkstring(L, 2);
-	if (ls_str_equals(key, "x") == 0) {
+	LSAtom key = lua_check_key(L, 2, NULL);
+	if (key == atoms.x) {
 		v->x = luaL_checkinteger(L, 3);
-	} else if (ls_str_equals(key, "y") == 0) {
+	} else if (key == atoms.y) {
 		v->y = luaL_checkinteger(L, 3);
-	} else if (ls_str_equals(key, "z") == 0) {
+	} else if (key == atoms.z) {
 		v->z = luaL_checkinteger(L, 3);
 	}
 	return 0;
@@ -785,7 +808,8 @@ static int lua_new_vector3u(lua_State *L) {
 void lua_register_vector3u(lua_State *L) {
 	luaL_newmetatable(L, "MT_VECTOR3U");
 
-	luaL_setfuncs(L, vector3u_meta_methods, 0);
+	lua_vector_new_key_table(L, 3);
+	luaL_setfuncs(L, vector3u_meta_methods, 1);
 	lua_pop(L, 1);
 
 	lua_pushcfunction(L, lua_new_vector3u);
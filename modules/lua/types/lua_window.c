@@ -1,5 +1,6 @@
 #include "lua_window.h"
 
+#include "lua_keys.h"
 #include "lua_renderer.h"
 #include "lua_vector.h"
 
@@ -7,8 +8,6 @@
 #include <lua.h>
 #include <lualib.h>
 
-static Hashtable *methods = NULL;
-
 static int lua_window_poll(lua_State *L) {
 	LSWindow *window = lua_check_window(L, 1);
 
@@ -103,10 +102,10 @@ static int lua_window_is_fullscreen(lua_State *L) {
 }
 
 static int lua_window_index(lua_State *L) {
-	String key = luaL_checkstring(L, 2);
-
-	if (hashtable_contains(methods, HASH_KEY(str, key))) {
-		lua_pushcfunction(L, hashtable_get(methods, HASH_KEY(str, key)).ptr);
+	lua_CFunction method = NULL;
+	lua_check_key(L, 2, &method);
+	if (method) {
+		lua_pushcfunction(L, method);
 		return 1;
 	}
 
@@ -133,29 +132,29 @@ static const luaL_Reg const_window_meta_methods[] = {
 };
 
 void lua_register_window(lua_State *L) {
-	if (methods == NULL) {
-		methods = hashtable_create(HASHTABLE_KEY_STRING, 11, false);
-
-		hashtable_set(methods, HASH_KEY(str, "poll"), HASH_VAL(ptr, lua_window_poll));
-		hashtable_set(methods, HASH_KEY(str, "set_title"), HASH_VAL(ptr, lua_window_set_title));
-		hashtable_set(methods, HASH_KEY(str, "set_size"), HASH_VAL(ptr, lua_window_set_size));
-		hashtable_set(methods, HASH_KEY(str, "get_size"), HASH_VAL(ptr, lua_window_get_size));
-		hashtable_set(methods, HASH_KEY(str, "make_current"), HASH_VAL(ptr, lua_window_make_current));
-		hashtable_set(methods, HASH_KEY(str, "swap_buffers"), HASH_VAL(ptr, lua_window_swap_buffers));
-		hashtable_set(methods, HASH_KEY(str, "set_fullscreen"), HASH_VAL(ptr, lua_window_set_fullscreen));
-		hashtable_set(methods, HASH_KEY(str, "show"), HASH_VAL(ptr, lua_window_show));
-		hashtable_set(methods, HASH_KEY(str, "hide"), HASH_VAL(ptr, lua_window_hide));
-		hashtable_set(methods, HASH_KEY(str, "is_visible"), HASH_VAL(ptr, lua_window_is_visible));
-		hashtable_set(methods, HASH_KEY(str, "is_fullscreen"), HASH_VAL(ptr, lua_window_is_fullscreen));
-	}
-
+	lua_new_key_table(L);
+	lua_key_table_add_method(L, "poll", lua_window_poll);
+	lua_key_table_add_method(L, "set_title", lua_window_set_title);
+	lua_key_table_add_method(L, "set_size", lua_window_set_size);
+	lua_key_table_add_method(L, "get_size", lua_window_get_size);
+	lua_key_table_add_method(L, "make_current", lua_window_make_current);
+	lua_key_table_add_method(L, "swap_buffers", lua_window_swap_buffers);
+	lua_key_table_add_method(L, "set_fullscreen", lua_window_set_fullscreen);
+	lua_key_table_add_method(L, "show", lua_window_show);
+	lua_key_table_add_method(L, "hide", lua_window_hide);
+	lua_key_table_add_method(L, "is_visible", lua_window_is_visible);
+	lua_key_table_add_method(L, "is_fullscreen", lua_window_is_fullscreen);
+
+	// Both metatables share the key table
 	luaL_newmetatable(L, "MT_WINDOW");
-	luaL_setfuncs(L, window_meta_methods, 0);
+	lua_pushvalue(L, -2);
+	luaL_setfuncs(L, window_meta_methods, 1);
 	lua_pop(L, 1);
 
 	luaL_newmetatable(L, "MT_CONST_WINDOW");
-	luaL_setfuncs(L, const_window_meta_methods, 0);
-	lua_pop(L, 1);
+	lua_pushvalue(L, -2);
+	luaL_setfuncs(L, const_window_meta_methods, 1);
+	lua_pop(L, 2);
 }
 
 void lua_push_window(lua_State *L, LSWindow *window) {
@@ -5,6 +5,7 @@
 #include "theme.h"
 
 typedef struct UIElement UIElement;
+LS_ARRAY_DEFINE(UIElementArray, ui_element_array, UIElement *)
 
 void ui_draw_element(UIElement *element);
 void ui_element_handle_event(UIElement *element, Event *event);
@@ -39,6 +39,8 @@ void ui_element_destroy(UIElement *element) {
 			ls_log_fatal("Unknown element type: %d\n", element->type);
 			break;
 	}
+
+	ls_free(element);
 }
 
 void ui_element_set_layout(UIElement *element, UILayout layout) {
@@ -30,8 +30,9 @@ UIElement *ui_label_create(const Font *font, String text, UITextWrapMode wrap_mo
 
 	element->label.wrap_mode = wrap_mode;
 
-	element->label.render_lines = slice_create(16, true);
+	element->label.render_lines = slice_create(16, false);
 	element->label.render_lines_width = slice32_create(16);
+	element->label.line_arena = ls_arena_create(256);
 
 	element->label.theme->font = font;
 	element->label.padding = 10;
@@ -47,6 +48,8 @@ UIElement *ui_label_create(const Font *font, String text, UITextWrapMode wrap_mo
 void ui_label_destroy(UILabel *label) {
 	ls_free(label->text);
 	slice_destroy(label->render_lines);
+	slice32_destroy(label->render_lines_width);
+	ls_arena_destroy(label->line_arena);
 }
 
 void ui_label_set_theme(UIElement *element, const UIElementTheme *theme) {
@@ -129,9 +132,7 @@ static Vector2u ui_label_split_lines(UIElement *label_elm, Vector2u max_size) {
 						Vector2u line_size = font_get_text_size(theme->font, theme->font_size, l_text);
 						l_text[text_len - i] = ' ';
 						if (line_size.x < max_size.x) {
-							char *new_line = ls_malloc((text_len - i) + 1);
-							ls_str_copy_to(new_line, l_text, (text_len - i) + 1);
-							new_line[text_len - i] = '\0';
+							char *new_line = ls_arena_str_copy(label_elm->label.line_arena, l_text, text_len - i);
 							slice_append(label_elm->label.render_lines, SLICE_VAL(ptr, new_line));
 							slice32_append(label_elm->label.render_lines_width, SLICE_VAL32(u32, line_size.x));
 							l_text += (text_len - i) + 1;
@@ -153,8 +154,7 @@ static Vector2u ui_label_split_lines(UIElement *label_elm, Vector2u max_size) {
 					Vector2u line_size = font_get_text_size(theme->font, theme->font_size, l_text);
 					l_text[text_len - i] = old_c;
 					if (line_size.x < max_size.x) {
-						char *new_line = ls_malloc((text_len - i) + 1);
-						ls_str_copy_to(new_line, l_text, (text_len - i) + 1);
+						char *new_line = ls_arena_str_copy(label_elm->label.line_arena, l_text, text_len - i);
 						slice_append(label_elm->label.render_lines, SLICE_VAL(ptr, new_line));
 						slice32_append(label_elm->label.render_lines_width, SLICE_VAL32(u32, line_size.x));
 						l_text += (text_len - i);
@@ -178,7 +178,7 @@ static Vector2u ui_label_split_lines(UIElement *label_elm, Vector2u max_size) {
 		}
 
 		if (failed || text_size.x < max_size.x) {
-			char *new_line = ls_str_copy(l_text);
+			char *new_line = ls_arena_str_copy(label_elm->label.line_arena, l_text, ls_str_length(l_text));
 			slice_append(label_elm->label.render_lines, SLICE_VAL(ptr, new_line));
 			slice32_append(label_elm->label.render_lines_width, SLICE_VAL32(u32, text_size.x));
 			used_y += text_size.y;
@@ -229,6 +229,7 @@ void ui_label_calculate_size(UIElement *label_elm, Vector2u outer_bounds, Vector
 
 	slice_clear(label_elm->label.render_lines);
 	slice32_clear(label_elm->label.render_lines_width);
+	ls_arena_reset(label_elm->label.line_arena);
 
 	Vector2u text_size = font_get_text_size(theme->font, theme->font_size, label_elm->label.text);
 	if (text_size.x > max_size.x && label_elm->label.wrap_mode != UI_TEXT_WRAP_NONE) {
@@ -237,8 +238,7 @@ void ui_label_calculate_size(UIElement *label_elm, Vector2u outer_bounds, Vector
 		label_elm->size = vec2u_add(text_size, vec2u(label_elm->label.padding, label_elm->label.padding));
 	} else {
 		// Text fits on one line
-		char *new_line = ls_str_copy(label_elm->label.text);
-		LS_ASSERT(new_line);
+		char *new_line = ls_arena_str_copy(label_elm->label.line_arena, label_elm->label.text, ls_str_length(label_elm->label.text));
 		slice_append(label_elm->label.render_lines, SLICE_VAL(ptr, new_line));
 		slice32_append(label_elm->label.render_lines_width, SLICE_VAL32(u32, text_size.x));
 		label_elm->size = vec2u_add(text_size, vec2u(label_elm->label.padding, label_elm->label.padding));
@@ -10,8 +10,10 @@ typedef struct {
 	char *text;
 	uint32 padding;
 
+	// Lines point into line_arena, which is reset whenever the lines are split again
 	Slice *render_lines;
 	Slice32 *render_lines_width;
+	LSArena *line_arena;
 	UITextWrapMode wrap_mode;
 
 	Vector2u prev_inner_bounds;
@@ -8,7 +8,7 @@
 
 typedef struct {
 	uint32 spacing;
-	Slice *children;
+	UIElementArray children;
 	UIAllignment alignment;
 } UIVerticalContainer;
 
@@ -2,6 +2,7 @@
 
 #include "core/debug.h"
 #include "core/types/slice.h"
+#include "core/types/spatial_index.h"
 #include "elements/elements.h"
 
 #include "renderer/batch_renderer.h"
@@ -11,11 +12,32 @@
 
 #include "main/lunar_sprites.h"
 
+// Cell size of the hit testing grid in pixels
+#define UI_HIT_GRID_CELL_SIZE 64.0f
+
+typedef struct {
+	UIElement *element;
+	// Handle in the hit testing index
+	uint32 handle;
+	// Insertion order, earlier elements get events first
+	uint64 order;
+} UIRootElement;
+
 typedef struct {
 	const Renderer *renderer;
 	const LSWindow *window;
 
+	// UIRootElement, freed by ui_remove_element and ui_deinit
 	Slice *elements;
+	uint64 next_order;
+	// Set when a root is removed, event handlers may remove roots while hits are dispatched
+	bool roots_removed;
+
+	// Root element bounds from the last layout, mouse events only visit elements under the cursor
+	SpatialIndex *hit_index;
+	UIRootElement **hits;
+	size_t nhits;
+	size_t hits_capacity;
 
 	Slice32 *indices;
 	BatchVertex *batch_vertices;
@@ -31,24 +53,70 @@ static void ui_on_update(float64 delta_time) {
 	Vector2u inner_bounds = vec2u(0, 0);
 	Vector2u outer_bounds = renderer_get_viewport_size(ui_renderer.renderer);
 	for (size_t i = 0; i < n_elements; i++) {
-		UIElement *element = slice_get(ui_renderer.elements, i).ptr;
+		UIRootElement *root = slice_get(ui_renderer.elements, i).ptr;
+		UIElement *element = root->element;
 		// Root elements bounds are the window size.
 
 		// Updated element size and position
-		ui_element_calculate_position(element, outer_bounds, inner_bounds);
-		ui_draw_element(element);
+		LS_PROFILE_SCOPE("ui_layout") {
+			ui_element_calculate_position(element, outer_bounds, inner_bounds);
+			spatial_index_update(ui_renderer.hit_index, root->handle, element->position,
+					vec2(element->position.x + element->size.x, element->position.y + element->size.y));
+		}
+
+		LS_PROFILE_SCOPE("ui_draw") {
+			ui_draw_element(element);
+		}
+	}
+}
+
+static bool ui_collect_hit(uint32 handle, void *data, void *user_data) {
+	if (ui_renderer.nhits == ui_renderer.hits_capacity) {
+		ui_renderer.hits_capacity *= 2;
+		ui_renderer.hits = ls_realloc(ui_renderer.hits, ui_renderer.hits_capacity * sizeof(UIRootElement *));
+	}
+
+	ui_renderer.hits[ui_renderer.nhits++] = data;
+	return true;
+}
+
+static bool ui_has_root(const UIRootElement *root) {
+	size_t n_elements = slice_get_size(ui_renderer.elements);
+	for (size_t i = 0; i < n_elements; i++) {
+		if (slice_get(ui_renderer.elements, i).ptr == root) {
+			return true;
+		}
 	}
+
+	return false;
 }
 
 static void ui_mouse_event_handler(Event *event) {
 	Vector2u mouse_pos = event->mouse.position;
-	for (size_t i = 0; i < slice_get_size(ui_renderer.elements); i++) {
-		UIElement *element = slice_get(ui_renderer.elements, i).ptr;
-		if (mouse_pos.x >= element->position.x && mouse_pos.x <= element->position.x + element->size.x &&
-				mouse_pos.y >= element->position.y && mouse_pos.y <= element->position.y + element->size.y) {
-			ui_element_handle_event(element, event);
+
+	ui_renderer.nhits = 0;
+	spatial_index_query_point(ui_renderer.hit_index, vec2((float32)mouse_pos.x, (float32)mouse_pos.y), ui_collect_hit, NULL);
+
+	// Only a handful of elements overlap the cursor, restore insertion order with an insertion sort
+	for (size_t i = 1; i < ui_renderer.nhits; i++) {
+		UIRootElement *root = ui_renderer.hits[i];
+		size_t j = i;
+		for (; j > 0 && ui_renderer.hits[j - 1]->order > root->order; j--) {
+			ui_renderer.hits[j] = ui_renderer.hits[j - 1];
+		}
+		ui_renderer.hits[j] = root;
+	}
+
+	// A handler can remove roots, the remaining hits are only used once they are known to be alive
+	ui_renderer.roots_removed = false;
+	for (size_t i = 0; i < ui_renderer.nhits; i++) {
+		UIRootElement *root = ui_renderer.hits[i];
+		if (ui_renderer.roots_removed && !ui_has_root(root)) {
+			continue;
 		}
 
+		ui_element_handle_event(root->element, event);
+
 		if (event->handled) {
 			break;
 		}
@@ -73,6 +141,11 @@ void ui_init(Renderer *renderer, LSCore *core, const LSWindow *window) {
 	ui_renderer.renderer = renderer;
 	ui_renderer.window = window;
 	ui_renderer.elements = slice_create(16, false);
+	ui_renderer.next_order = 0;
+	ui_renderer.hit_index = spatial_index_create_grid(UI_HIT_GRID_CELL_SIZE);
+	ui_renderer.hits_capacity = 16;
+	ui_renderer.hits = ls_malloc(ui_renderer.hits_capacity * sizeof(UIRootElement *));
+	ui_renderer.nhits = 0;
 	ui_renderer.indices = slice32_create(128);
 	ui_renderer.batch_vertices = ls_malloc(128 * sizeof(BatchVertex));
 	ui_renderer.batch_vertices_size = 128;
@@ -84,24 +157,37 @@ void ui_init(Renderer *renderer, LSCore *core, const LSWindow *window) {
 
 void ui_deinit() {
 	for (size_t i = 0; i < slice_get_size(ui_renderer.elements); i++) {
-		UIElement *element = slice_get(ui_renderer.elements, i).ptr;
-		ui_element_destroy(element);
+		UIRootElement *root = slice_get(ui_renderer.elements, i).ptr;
+		ui_element_destroy(root->element);
+		ls_free(root);
 	}
 
 	slice_destroy(ui_renderer.elements);
+	spatial_index_destroy(ui_renderer.hit_index);
+	ls_free(ui_renderer.hits);
 }
 
 void ui_add_element(UIElement *element) {
-	slice_append(ui_renderer.elements, SLICE_VAL(ptr, (void *)element));
+	UIRootElement *root = ls_malloc(sizeof(UIRootElement));
+	root->element = element;
+	root->order = ui_renderer.next_order++;
+	root->handle = spatial_index_insert(ui_renderer.hit_index, element->position,
+			vec2(element->position.x + element->size.x, element->position.y + element->size.y), root);
+
+	slice_append(ui_renderer.elements, SLICE_VAL(ptr, root));
 }
 
 void ui_remove_element(const UIElement *element) {
 	size_t n_elements = slice_get_size(ui_renderer.elements);
 	for (size_t i = 0; i < n_elements; i++) {
-		UIElement *elm = slice_get(ui_renderer.elements, i).ptr;
-		if (elm == element) {
+		UIRootElement *root = slice_get(ui_renderer.elements, i).ptr;
+		if (root->element == element) {
+			UIElement *elm = root->element;
+			spatial_index_remove(ui_renderer.hit_index, root->handle);
 			slice_remove(ui_renderer.elements, i);
+			ls_free(root);
 			ui_element_destroy(elm);
+			ui_renderer.roots_removed = true;
 			break;
 		}
 	}
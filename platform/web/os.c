@@ -136,11 +136,15 @@ char *platform_path_get_extension(String path) {
 }
 
 char *platform_path_to_absolute(String path) {
-	char *absolute_path = realpath(path, NULL);
-	if (!absolute_path) {
+	char *resolved_path = realpath(path, NULL);
+	if (!resolved_path) {
 		return NULL;
 	}
 
+	// Callers release the result with ls_free, which may not be the C heap
+	char *absolute_path = ls_str_copy(resolved_path);
+	free(resolved_path);
+
 	return absolute_path;
 }
 
@@ -242,7 +246,15 @@ void platform_set_working_directory(String path) {
 }
 
 char *platform_get_working_directory() {
-	return getcwd(NULL, 0);
+	char *cwd = getcwd(NULL, 0);
+	if (!cwd) {
+		return NULL;
+	}
+
+	char *working_directory = ls_str_copy(cwd);
+	free(cwd);
+
+	return working_directory;
 }
 
 void *platform_open_library(String path) {
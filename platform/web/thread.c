@@ -2,7 +2,9 @@
 
 #include "core/core.h"
 
+#include <errno.h>
 #include <pthread.h>
+#include <semaphore.h>
 
 typedef struct LSMutex {
 	pthread_mutex_t mutex;
@@ -34,20 +36,97 @@ void os_mutex_unlock(LSMutex *mutex) {
 	pthread_mutex_unlock(&mutex->mutex);
 }
 
+typedef struct LSCond {
+	pthread_cond_t cond;
+} LSCond;
+
+LSCond *os_cond_create() {
+	LSCond *cond = ls_malloc(sizeof(LSCond));
+	pthread_cond_init(&cond->cond, NULL);
+
+	return cond;
+}
+
+void os_cond_destroy(LSCond *cond) {
+	LS_ASSERT(cond);
+
+	pthread_cond_destroy(&cond->cond);
+	ls_free(cond);
+}
+
+void os_cond_wait(LSCond *cond, LSMutex *mutex) {
+	LS_ASSERT(cond);
+	LS_ASSERT(mutex);
+
+	pthread_cond_wait(&cond->cond, &mutex->mutex);
+}
+
+void os_cond_signal(LSCond *cond) {
+	LS_ASSERT(cond);
+
+	pthread_cond_signal(&cond->cond);
+}
+
+void os_cond_broadcast(LSCond *cond) {
+	LS_ASSERT(cond);
+
+	pthread_cond_broadcast(&cond->cond);
+}
+
+typedef struct LSSemaphore {
+	sem_t semaphore;
+} LSSemaphore;
+
+LSSemaphore *os_semaphore_create() {
+	LSSemaphore *semaphore = ls_malloc(sizeof(LSSemaphore));
+	sem_init(&semaphore->semaphore, 0, 0);
+
+	return semaphore;
+}
+
+void os_semaphore_destroy(LSSemaphore *semaphore) {
+	LS_ASSERT(semaphore);
+
+	sem_destroy(&semaphore->semaphore);
+	ls_free(semaphore);
+}
+
+void os_semaphore_wait(LSSemaphore *semaphore) {
+	LS_ASSERT(semaphore);
+
+	// Interrupted by a signal, not posted
+	while (sem_wait(&semaphore->semaphore) != 0 && errno == EINTR) {
+	}
+}
+
+void os_semaphore_post(LSSemaphore *semaphore) {
+	LS_ASSERT(semaphore);
+
+	sem_post(&semaphore->semaphore);
+}
+
+typedef struct ThreadData {
+	LSThreadFunction function;
+	void *data;
+} ThreadData;
+
 typedef struct LSThread {
 	pthread_t thread;
+	ThreadData thread_data;
 } LSThread;
 
 void *thread_function(void *data) {
-	LSThreadFunction function = (LSThreadFunction)data;
-	function(NULL);
+	ThreadData *thread_data = (ThreadData *)data;
+	thread_data->function(thread_data->data);
 
 	return NULL;
 }
 
 LSThread *os_thread_create(LSThreadFunction function, void *data) {
 	LSThread *thread = ls_malloc(sizeof(LSThread));
-	pthread_create(&thread->thread, NULL, thread_function, function);
+	thread->thread_data.function = function;
+	thread->thread_data.data = data;
+	pthread_create(&thread->thread, NULL, thread_function, &thread->thread_data);
 
 	return thread;
 }
@@ -34,6 +34,73 @@ void os_mutex_unlock(LSMutex *mutex) {
 	LeaveCriticalSection(&mutex->mutex);
 }
 
+typedef struct LSCond {
+	CONDITION_VARIABLE cond;
+} LSCond;
+
+LSCond *os_cond_create() {
+	LSCond *cond = ls_malloc(sizeof(LSCond));
+	InitializeConditionVariable(&cond->cond);
+
+	return cond;
+}
+
+void os_cond_destroy(LSCond *cond) {
+	LS_ASSERT(cond);
+
+	// Windows condition variables hold no resources
+	ls_free(cond);
+}
+
+void os_cond_wait(LSCond *cond, LSMutex *mutex) {
+	LS_ASSERT(cond);
+	LS_ASSERT(mutex);
+
+	SleepConditionVariableCS(&cond->cond, &mutex->mutex, INFINITE);
+}
+
+void os_cond_signal(LSCond *cond) {
+	LS_ASSERT(cond);
+
+	WakeConditionVariable(&cond->cond);
+}
+
+void os_cond_broadcast(LSCond *cond) {
+	LS_ASSERT(cond);
+
+	WakeAllConditionVariable(&cond->cond);
+}
+
+typedef struct LSSemaphore {
+	HANDLE semaphore;
+} LSSemaphore;
+
+LSSemaphore *os_semaphore_create() {
+	LSSemaphore *semaphore = ls_malloc(sizeof(LSSemaphore));
+	semaphore->semaphore = CreateSemaphore(NULL, 0, LONG_MAX, NULL);
+
+	return semaphore;
+}
+
+void os_semaphore_destroy(LSSemaphore *semaphore) {
+	LS_ASSERT(semaphore);
+
+	CloseHandle(semaphore->semaphore);
+	ls_free(semaphore);
+}
+
+void os_semaphore_wait(LSSemaphore *semaphore) {
+	LS_ASSERT(semaphore);
+
+	WaitForSingleObject(semaphore->semaphore, INFINITE);
+}
+
+void os_semaphore_post(LSSemaphore *semaphore) {
+	LS_ASSERT(semaphore);
+
+	ReleaseSemaphore(semaphore->semaphore, 1, NULL);
+}
+
 typedef struct ThreadData {
 	LSThreadFunction function;
 	void *data;
@@ -1,5 +1,6 @@
 #include "batch_renderer.h"
 #include "buffers.h"
+#include "camera.h"
 #include "core/memory.h"
 #include "renderer/shader.h"
 #include "shader.h"
@@ -22,62 +23,173 @@ static const BufferElement BATCH_TEXID_VBO_LAYOUT[] = {
 static const int32 BATCH_TEXT_IDS[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
 
 extern const char *const BATCH_SHADER_SOURCE;
+extern const char *const BATCH_ARRAY_SHADER_SOURCE;
 
-#define VBO_MAX_ELEMENTS 1024
-#define IBO_MAX_ELEMENTS 1024
+// Texture array pages are sized to hold about this many bytes, small sprites get many layers, big ones few.
+// Textures bigger than a page are drawn on their own from BATCH_ARRAY_TEXTURE_SLOT instead.
+#define BATCH_ARRAY_PAGE_BYTES (16 * 1024 * 1024)
+#define BATCH_ARRAY_MAX_LAYERS 256
+#define BATCH_ARRAY_TEXTURE_SLOT 1
 
+// A batch is a range of the frame storage drawn with one set of up to 16 textures,
+// or with a single texture array in BATCH_TEXTURE_MODE_ARRAY. Textures that don't fit an array page
+// get a batch of their own with just that texture in BATCH_TEXTURE_MODE_ARRAY.
 typedef struct {
 	const Texture *textures[16];
+	const TextureArray *array;
+	// Index into the frame's view projections
+	uint32 view;
 
-	BatchVertex vertices[VBO_MAX_ELEMENTS];
-	float32 tex_ids[VBO_MAX_ELEMENTS];
-	uint32 indices[IBO_MAX_ELEMENTS];
-
-	size_t nverts;
-	size_t nindices;
+	uint32 first_index;
+	uint32 nindices;
 	uint8 ntextures;
 } Batch;
 
 typedef struct {
 	const Renderer *renderer;
 
+	BatchTextureMode texture_mode;
+
 	Shader *shader;
+	int32 u_textures;
+	int32 u_texture_array;
+	int32 u_texture;
+	int32 u_use_texture;
+	int32 u_resolution;
+	int32 u_view_projection;
+
+	// Texture array pages textures are copied into in BATCH_TEXTURE_MODE_ARRAY
+	TextureArray **arrays;
+	uint32 narrays;
 
 	VertexArray *vao;
 	VertexBuffer *vbo;
 	VertexBuffer *texid_vbo;
 	IndexBuffer *ibo;
 
-	Batch batches[64];
+	// Frame arena shared by every batch, all batches are uploaded in one go on flush.
+	// Storage only ever grows, so after a few frames it settles at what the scene needs and never flushes early.
+	BatchVertex *vertices;
+	float32 *tex_ids;
+	uint32 vertex_capacity;
+	uint32 nverts;
+
+	// Indices are stored already offset by the frame vertex base, GLES 3.0 has no base vertex draws.
+	uint32 *indices;
+	uint32 index_capacity;
+	uint32 nindices;
+
+	Batch *batches;
+	uint32 batch_capacity;
 	uint32 nbatches;
+
+	// View projections used this frame, view 0 is the identity used in screen space
+	Matrix4 *views;
+	uint32 view_capacity;
+	uint32 nviews;
+	uint32 current_view;
+	BatchSpace space;
+	// Camera and version the current space was set up with
+	const Camera *space_camera;
+	uint32 space_camera_version;
+
+	// World rect of the active camera in world space, nothing is culled without it
+	bool cull;
+	Vector2 cull_min;
+	Vector2 cull_max;
+	uint32 nculled;
+
+	BatchRendererStats stats;
 } BatchRenderer;
 
 static BatchRenderer *batch_renderer;
 
+static FlagValue *batch_capacity_flag;
+static FlagValue *vertex_capacity_flag;
+static FlagValue *index_capacity_flag;
+static FlagValue *texture_mode_flag;
+
 static void batch_renderer_flush();
 
-static void draw_batch(Batch *batch);
+static Batch *batch_renderer_current_batch();
+static Batch *batch_renderer_new_batch();
+static void batch_renderer_reserve(uint32 nverts, uint32 nindices);
+static Batch *batch_renderer_add_texture(Batch *batch, const Texture *texture, float32 *tex_id);
+static Batch *batch_renderer_add_array_texture(Batch *batch, const Texture *texture, float32 *tex_id);
+
+_FORCE_INLINE_ uint32 grow_capacity(uint32 capacity, int64 required) {
+	if (capacity == 0) {
+		capacity = 1;
+	}
+
+	while ((int64)capacity < required) {
+		capacity *= 2;
+	}
+
+	return capacity;
+}
+
+void batch_renderer_register_flags(FlagManager *flag_manager) {
+	batch_capacity_flag = flag_manager_register(flag_manager, "batch-capacity", FLAG_TYPE_INT, FLAG_VAL(i32, 64),
+			"Number of batches the batch renderer reserves per frame. Grows on demand.");
+	vertex_capacity_flag = flag_manager_register(flag_manager, "batch-vertex-capacity", FLAG_TYPE_INT, FLAG_VAL(i32, 64 * 1024),
+			"Number of vertices the batch renderer reserves per frame. Grows on demand.");
+	index_capacity_flag = flag_manager_register(flag_manager, "batch-index-capacity", FLAG_TYPE_INT, FLAG_VAL(i32, 96 * 1024),
+			"Number of indices the batch renderer reserves per frame. Grows on demand.");
+	texture_mode_flag = flag_manager_register(flag_manager, "batch-texture-mode", FLAG_TYPE_STRING, FLAG_VAL(str, "SLOTS"),
+			"How the batch renderer binds textures. Valid values are SLOTS (16 texture units) and ARRAY (same sized textures share a texture array).");
+}
 
 void batch_renderer_init(const Renderer *renderer) {
-	batch_renderer = ls_malloc(sizeof(BatchRenderer));
+	batch_renderer = ls_calloc(1, sizeof(BatchRenderer));
 
 	batch_renderer->renderer = renderer;
 
+	batch_renderer->batch_capacity = grow_capacity(1, batch_capacity_flag->i32);
+	batch_renderer->vertex_capacity = grow_capacity(4, vertex_capacity_flag->i32);
+	batch_renderer->index_capacity = grow_capacity(6, index_capacity_flag->i32);
+
+	batch_renderer->batches = ls_malloc(batch_renderer->batch_capacity * sizeof(Batch));
+	batch_renderer->vertices = ls_malloc(batch_renderer->vertex_capacity * sizeof(BatchVertex));
+	batch_renderer->tex_ids = ls_malloc(batch_renderer->vertex_capacity * sizeof(float32));
+	batch_renderer->indices = ls_malloc(batch_renderer->index_capacity * sizeof(uint32));
+
 	batch_renderer->vao = renderer_create_vertex_array(renderer);
 
-	batch_renderer->vbo = renderer_create_vertex_buffer(renderer, NULL, VBO_MAX_ELEMENTS * sizeof(BatchVertex), BUFFER_USAGE_DYNAMIC);
+	// The streamed buffers hold two full frames before they wrap and get orphaned, they grow with the arena.
+	batch_renderer->vbo = renderer_create_vertex_buffer(renderer, NULL, 2 * batch_renderer->vertex_capacity * sizeof(BatchVertex), BUFFER_USAGE_STREAM);
 	BufferLayout *vbo_layout = buffer_layout_create(BATCH_VBO_LAYOUT, BATCH_VBO_LAYOUT_COUNT);
 	vertex_buffer_set_layout(batch_renderer->vbo, vbo_layout);
 
-	batch_renderer->texid_vbo = renderer_create_vertex_buffer(renderer, NULL, VBO_MAX_ELEMENTS * sizeof(float32), BUFFER_USAGE_DYNAMIC);
+	batch_renderer->texid_vbo = renderer_create_vertex_buffer(renderer, NULL, 2 * batch_renderer->vertex_capacity * sizeof(float32), BUFFER_USAGE_STREAM);
 	BufferLayout *texid_vbo_layout = buffer_layout_create(BATCH_TEXID_VBO_LAYOUT, BATCH_TEXID_VBO_LAYOUT_COUNT);
 	vertex_buffer_set_layout(batch_renderer->texid_vbo, texid_vbo_layout);
 
-	batch_renderer->ibo = renderer_create_index_buffer(renderer, NULL, IBO_MAX_ELEMENTS * sizeof(uint32), BUFFER_USAGE_DYNAMIC);
+	batch_renderer->ibo = renderer_create_index_buffer(renderer, NULL, 2 * batch_renderer->index_capacity * sizeof(uint32), BUFFER_USAGE_STREAM);
+
+	ls_str_to_upper(texture_mode_flag->str);
+	if (ls_str_equals(texture_mode_flag->str, "ARRAY")) {
+		batch_renderer->texture_mode = BATCH_TEXTURE_MODE_ARRAY;
+	} else {
+		if (!ls_str_equals(texture_mode_flag->str, "SLOTS")) {
+			ls_log(LOG_LEVEL_WARNING, "Unknown batch texture mode %s, using SLOTS\n", texture_mode_flag->str);
+		}
+		batch_renderer->texture_mode = BATCH_TEXTURE_MODE_SLOTS;
+	}
+
+	String shader_source = batch_renderer->texture_mode == BATCH_TEXTURE_MODE_ARRAY ? BATCH_ARRAY_SHADER_SOURCE : BATCH_SHADER_SOURCE;
+	batch_renderer->shader = renderer_create_shader(renderer, shader_source, ls_str_length(shader_source));
+	batch_renderer->u_textures = shader_get_uniform_location(batch_renderer->shader, "u_textures");
+	batch_renderer->u_texture_array = shader_get_uniform_location(batch_renderer->shader, "u_texture_array");
+	batch_renderer->u_texture = shader_get_uniform_location(batch_renderer->shader, "u_texture");
+	batch_renderer->u_use_texture = shader_get_uniform_location(batch_renderer->shader, "u_use_texture");
+	batch_renderer->u_resolution = shader_get_uniform_location(batch_renderer->shader, "u_resolution");
+	batch_renderer->u_view_projection = shader_get_uniform_location(batch_renderer->shader, "u_view_projection");
 
-	batch_renderer->shader = renderer_create_shader(renderer, BATCH_SHADER_SOURCE, ls_str_length(BATCH_SHADER_SOURCE));
+	batch_renderer->view_capacity = 4;
+	batch_renderer->views = ls_malloc(batch_renderer->view_capacity * sizeof(Matrix4));
 
-	batch_renderer->nbatches = 0;
+	batch_renderer_begin_frame();
 }
 
 void batch_renderer_deinit() {
@@ -88,117 +200,399 @@ void batch_renderer_deinit() {
 
 	shader_destroy(batch_renderer->shader);
 
+	for (uint32 i = 0; i < batch_renderer->narrays; i++) {
+		texture_array_destroy(batch_renderer->arrays[i]);
+	}
+	ls_free(batch_renderer->arrays);
+
+	ls_free(batch_renderer->batches);
+	ls_free(batch_renderer->vertices);
+	ls_free(batch_renderer->tex_ids);
+	ls_free(batch_renderer->indices);
+	ls_free(batch_renderer->views);
+
 	ls_free(batch_renderer);
 }
 
 void batch_renderer_begin_frame() {
+	batch_renderer->nverts = 0;
+	batch_renderer->nindices = 0;
 	batch_renderer->nbatches = 0;
+
+	batch_renderer->views[0] = MAT4_IDENTITY;
+	batch_renderer->nviews = 1;
+	batch_renderer->current_view = 0;
+	batch_renderer->space = BATCH_SPACE_SCREEN;
+	batch_renderer->space_camera = NULL;
+	batch_renderer->cull = false;
+	batch_renderer->nculled = 0;
+}
+
+void batch_renderer_set_space(BatchSpace space) {
+	// World sprites set the space on every draw, nothing changes unless the camera did
+	const Camera *camera = space == BATCH_SPACE_WORLD ? get_current_camera() : NULL;
+	uint32 version = camera ? camera_get_version(camera) : 0;
+	if (space == batch_renderer->space && camera == batch_renderer->space_camera && version == batch_renderer->space_camera_version) {
+		return;
+	}
+
+	batch_renderer->space = space;
+	batch_renderer->space_camera = camera;
+	batch_renderer->space_camera_version = version;
+	batch_renderer->current_view = 0;
+	batch_renderer->cull = false;
+
+	if (!camera) {
+		return;
+	}
+
+	// Switching back and forth with the same camera keeps using one view so batches can continue
+	Matrix4 view_projection = camera_get_view_projection(camera);
+	uint32 last = batch_renderer->nviews - 1;
+	if (last > 0 && mat4_equals(batch_renderer->views[last], view_projection)) {
+		batch_renderer->current_view = last;
+	} else {
+		if (batch_renderer->nviews == batch_renderer->view_capacity) {
+			batch_renderer->view_capacity *= 2;
+			batch_renderer->views = ls_realloc(batch_renderer->views, batch_renderer->view_capacity * sizeof(Matrix4));
+		}
+
+		batch_renderer->current_view = batch_renderer->nviews;
+		batch_renderer->views[batch_renderer->nviews++] = view_projection;
+	}
+
+	batch_renderer->cull = camera_get_world_bounds(camera, &batch_renderer->cull_min, &batch_renderer->cull_max);
+}
+
+BatchSpace batch_renderer_get_space() {
+	return batch_renderer->space;
+}
+
+bool batch_renderer_get_visible_rect(Vector2 *min, Vector2 *max) {
+	if (!batch_renderer->cull) {
+		return false;
+	}
+
+	*min = batch_renderer->cull_min;
+	*max = batch_renderer->cull_max;
+	return true;
+}
+
+bool batch_renderer_is_visible(Vector2 min, Vector2 max) {
+	if (!batch_renderer->cull) {
+		return true;
+	}
+
+	if (max.x < batch_renderer->cull_min.x || min.x > batch_renderer->cull_max.x ||
+			max.y < batch_renderer->cull_min.y || min.y > batch_renderer->cull_max.y) {
+		batch_renderer->nculled++;
+		return false;
+	}
+
+	return true;
 }
 
 void batch_renderer_end_frame() {
+	LS_PROFILE_BEGIN("batch_renderer_end_frame");
+
 	batch_renderer_flush();
+
+	// Everything drawn this frame has been copied into the batch buffers
+	ls_frame_reset();
+	ls_memory_end_frame();
+
+	LS_PROFILE_END();
 }
 
-void batch_renderer_draw(const Texture *texture, const BatchVertex *vertices, const uint32 *indices, size_t nverts, size_t nindices) {
-	if (batch_renderer->nbatches == 0) {
-		batch_renderer->batches[0].nverts = 0;
-		batch_renderer->batches[0].nindices = 0;
+BatchRendererStats batch_renderer_get_stats() {
+	BatchRendererStats stats = batch_renderer->stats;
+	stats.vertex_capacity = batch_renderer->vertex_capacity;
+	stats.index_capacity = batch_renderer->index_capacity;
+	stats.batch_capacity = batch_renderer->batch_capacity;
+	stats.texture_arrays = batch_renderer->narrays;
+	return stats;
+}
 
-		batch_renderer->nbatches++;
-	}
+void batch_renderer_draw(const Texture *texture, const BatchVertex *vertices, const uint32 *indices, size_t nverts, size_t nindices) {
+	batch_renderer_reserve(nverts, nindices);
 
-	Batch *current_batch = &batch_renderer->batches[batch_renderer->nbatches - 1];
+	Batch *current_batch = batch_renderer_current_batch();
 
-	if (current_batch->nverts + nverts > VBO_MAX_ELEMENTS || current_batch->nindices + nindices > IBO_MAX_ELEMENTS) {
-		if (batch_renderer->nbatches == 64) {
-			ls_log(LOG_LEVEL_WARNING, "Batch renderer reached maximum number of batches\n");
-			batch_renderer_flush();
+	float32 tex_id = -1;
+	if (texture) {
+		if (batch_renderer->texture_mode == BATCH_TEXTURE_MODE_ARRAY) {
+			current_batch = batch_renderer_add_array_texture(current_batch, texture, &tex_id);
+		} else {
+			current_batch = batch_renderer_add_texture(current_batch, texture, &tex_id);
 		}
+	}
 
-		current_batch = &batch_renderer->batches[batch_renderer->nbatches];
-		current_batch->nverts = 0;
-		current_batch->nindices = 0;
+	uint32 base_vertex = batch_renderer->nverts;
+	ls_memcpy(&batch_renderer->vertices[base_vertex], vertices, nverts * sizeof(BatchVertex));
 
-		batch_renderer->nbatches++;
+	for (size_t i = 0; i < nverts; i++) {
+		batch_renderer->tex_ids[base_vertex + i] = tex_id;
 	}
 
+	uint32 *dst_indices = &batch_renderer->indices[batch_renderer->nindices];
+	for (size_t i = 0; i < nindices; i++) {
+		dst_indices[i] = indices[i] + base_vertex;
+	}
+
+	batch_renderer->nverts += nverts;
+	batch_renderer->nindices += nindices;
+	current_batch->nindices += nindices;
+}
+
+BatchVertex *batch_renderer_draw_quads(const Texture *texture, uint32 nquads) {
+	batch_renderer_reserve(nquads * 4, nquads * 6);
+
+	Batch *current_batch = batch_renderer_current_batch();
+
 	float32 tex_id = -1;
 	if (texture) {
-		for (uint8 i = 0; i < current_batch->ntextures; i++) {
-			if (current_batch->textures[i] == texture) {
-				tex_id = i;
-				break;
-			}
+		if (batch_renderer->texture_mode == BATCH_TEXTURE_MODE_ARRAY) {
+			current_batch = batch_renderer_add_array_texture(current_batch, texture, &tex_id);
+		} else {
+			current_batch = batch_renderer_add_texture(current_batch, texture, &tex_id);
 		}
+	}
 
-		if (tex_id == -1) {
-			if (current_batch->ntextures < 16) {
-				tex_id = (float32)current_batch->ntextures;
-				current_batch->textures[current_batch->ntextures++] = texture;
-			} else {
-				if (batch_renderer->nbatches == 64) {
-					ls_log(LOG_LEVEL_WARNING, "Batch renderer reached maximum number of batches\n");
-					batch_renderer_flush();
-				}
-
-				current_batch = &batch_renderer->batches[batch_renderer->nbatches];
-				current_batch->nverts = 0;
-				current_batch->nindices = 0;
-				current_batch->ntextures = 1;
-				current_batch->textures[0] = texture;
-			}
+	uint32 base_vertex = batch_renderer->nverts;
+	float32 *dst_tex_ids = &batch_renderer->tex_ids[base_vertex];
+	for (uint32 i = 0; i < nquads * 4; i++) {
+		dst_tex_ids[i] = tex_id;
+	}
+
+	uint32 *dst_indices = &batch_renderer->indices[batch_renderer->nindices];
+	for (uint32 i = 0; i < nquads; i++) {
+		uint32 v = base_vertex + i * 4;
+		dst_indices[0] = v;
+		dst_indices[1] = v + 1;
+		dst_indices[2] = v + 2;
+		dst_indices[3] = v + 2;
+		dst_indices[4] = v + 3;
+		dst_indices[5] = v;
+		dst_indices += 6;
+	}
+
+	batch_renderer->nverts += nquads * 4;
+	batch_renderer->nindices += nquads * 6;
+	current_batch->nindices += nquads * 6;
+
+	return &batch_renderer->vertices[base_vertex];
+}
+
+// Returns the batch draws go into, a new one is started when the view changed
+static Batch *batch_renderer_current_batch() {
+	if (batch_renderer->nbatches > 0) {
+		Batch *batch = &batch_renderer->batches[batch_renderer->nbatches - 1];
+		if (batch->view == batch_renderer->current_view) {
+			return batch;
 		}
 	}
 
-	ls_memcpy(&current_batch->vertices[current_batch->nverts], vertices, nverts * sizeof(BatchVertex));
+	return batch_renderer_new_batch();
+}
 
-	for (size_t i = 0; i < nverts; i++) {
-		current_batch->tex_ids[current_batch->nverts + i] = tex_id;
+static Batch *batch_renderer_new_batch() {
+	if (batch_renderer->nbatches == batch_renderer->batch_capacity) {
+		batch_renderer->batch_capacity *= 2;
+		batch_renderer->batches = ls_realloc(batch_renderer->batches, batch_renderer->batch_capacity * sizeof(Batch));
+		batch_renderer->stats.batch_grows++;
 	}
 
-	for (size_t i = 0; i < nindices; i++) {
-		current_batch->indices[current_batch->nindices + i] = indices[i] + current_batch->nverts;
+	Batch *batch = &batch_renderer->batches[batch_renderer->nbatches++];
+	batch->first_index = batch_renderer->nindices;
+	batch->nindices = 0;
+	batch->ntextures = 0;
+	batch->array = NULL;
+	batch->view = batch_renderer->current_view;
+
+	return batch;
+}
+
+static Batch *batch_renderer_add_texture(Batch *batch, const Texture *texture, float32 *tex_id) {
+	for (uint8 i = 0; i < batch->ntextures; i++) {
+		if (batch->textures[i] == texture) {
+			*tex_id = i;
+			return batch;
+		}
 	}
 
-	current_batch->nverts += nverts;
-	current_batch->nindices += nindices;
+	if (batch->ntextures == 16) {
+		batch = batch_renderer_new_batch();
+	}
+
+	*tex_id = (float32)batch->ntextures;
+	batch->textures[batch->ntextures++] = texture;
+
+	return batch;
 }
 
-static void batch_renderer_flush() {
-	for (uint32 i = 0; i < batch_renderer->nbatches; i++) {
-		draw_batch(&batch_renderer->batches[i]);
+// Layers of a page for textures of this size, 0 when the size has no place in a page.
+_FORCE_INLINE_ uint32 batch_array_page_layers(uint32 width, uint32 height) {
+	uint64 layer_bytes = (uint64)width * height * 4;
+	if (layer_bytes == 0 || layer_bytes > BATCH_ARRAY_PAGE_BYTES) {
+		return 0;
 	}
 
-	batch_renderer->nbatches = 0;
+	uint64 layers = BATCH_ARRAY_PAGE_BYTES / layer_bytes;
+	return layers > BATCH_ARRAY_MAX_LAYERS ? BATCH_ARRAY_MAX_LAYERS : (uint32)layers;
+}
+
+static Batch *batch_renderer_add_single_texture(Batch *batch, const Texture *texture, float32 *tex_id) {
+	if (batch->array || (batch->ntextures > 0 && batch->textures[0] != texture)) {
+		batch = batch_renderer_new_batch();
+	}
+
+	batch->textures[0] = texture;
+	batch->ntextures = 1;
+	*tex_id = 0;
+
+	return batch;
+}
+
+static Batch *batch_renderer_add_array_texture(Batch *batch, const Texture *texture, float32 *tex_id) {
+	uint32 layer = 0;
+	TextureArray *array = texture_get_array(texture, &layer);
+
+	if (!array) {
+		uint32 width = texture_get_width(texture);
+		uint32 height = texture_get_height(texture);
+		uint32 layers = batch_array_page_layers(width, height);
+		if (layers == 0) {
+			return batch_renderer_add_single_texture(batch, texture, tex_id);
+		}
+
+		// Adding a texture to a page copies its pixels into a free layer on the GPU, the texture itself stays as is.
+		Texture *placed = (Texture *)texture;
+
+		for (uint32 i = 0; i < batch_renderer->narrays && !array; i++) {
+			int32 added = texture_array_add_texture(batch_renderer->arrays[i], placed);
+			if (added >= 0) {
+				array = batch_renderer->arrays[i];
+				layer = added;
+			}
+		}
+
+		if (!array) {
+			array = texture_array_create(width, height, layers);
+			batch_renderer->arrays = ls_realloc(batch_renderer->arrays, (batch_renderer->narrays + 1) * sizeof(TextureArray *));
+			batch_renderer->arrays[batch_renderer->narrays++] = array;
+
+			layer = texture_array_add_texture(array, placed);
+		}
+	}
+
+	if ((batch->array && batch->array != array) || batch->ntextures > 0) {
+		batch = batch_renderer_new_batch();
+	}
+
+	batch->array = array;
+	*tex_id = (float32)layer;
+
+	return batch;
+}
+
+static void batch_renderer_reserve(uint32 nverts, uint32 nindices) {
+	uint32 required_verts = batch_renderer->nverts + nverts;
+	if (required_verts > batch_renderer->vertex_capacity) {
+		batch_renderer->vertex_capacity = grow_capacity(batch_renderer->vertex_capacity, required_verts);
+		batch_renderer->vertices = ls_realloc(batch_renderer->vertices, batch_renderer->vertex_capacity * sizeof(BatchVertex));
+		batch_renderer->tex_ids = ls_realloc(batch_renderer->tex_ids, batch_renderer->vertex_capacity * sizeof(float32));
+		batch_renderer->stats.vertex_grows++;
+	}
+
+	uint32 required_indices = batch_renderer->nindices + nindices;
+	if (required_indices > batch_renderer->index_capacity) {
+		batch_renderer->index_capacity = grow_capacity(batch_renderer->index_capacity, required_indices);
+		batch_renderer->indices = ls_realloc(batch_renderer->indices, batch_renderer->index_capacity * sizeof(uint32));
+		batch_renderer->stats.index_grows++;
+	}
 }
 
-static void draw_batch(Batch *batch) {
+static void batch_renderer_flush() {
+	batch_renderer->stats.nverts = batch_renderer->nverts;
+	batch_renderer->stats.nindices = batch_renderer->nindices;
+	batch_renderer->stats.nbatches = batch_renderer->nbatches;
+	batch_renderer->stats.nculled = batch_renderer->nculled;
+
+	if (batch_renderer->nindices == 0) {
+		batch_renderer_begin_frame();
+		return;
+	}
+
+	renderer_gpu_zone_begin(batch_renderer->renderer, "batch_flush");
+
 	vertex_array_bind(batch_renderer->vao);
 
-	vertex_buffer_set_sub_data(batch_renderer->vbo, batch->vertices, batch->nverts * sizeof(BatchVertex), 0);
-	vertex_buffer_set_sub_data(batch_renderer->texid_vbo, batch->tex_ids, batch->nverts * sizeof(float32), 0);
-	index_buffer_set_sub_data(batch_renderer->ibo, batch->indices, batch->nindices * sizeof(uint32), 0);
+	// One upload per buffer for the whole frame, every batch draws a range of it.
+	vertex_buffer_stream_data(batch_renderer->vbo, batch_renderer->vertices, batch_renderer->nverts * sizeof(BatchVertex));
+	vertex_buffer_stream_data(batch_renderer->texid_vbo, batch_renderer->tex_ids, batch_renderer->nverts * sizeof(float32));
+	index_buffer_stream_data(batch_renderer->ibo, batch_renderer->indices, batch_renderer->nindices * sizeof(uint32));
 
 	const VertexBuffer *buffers[2] = { batch_renderer->vbo, batch_renderer->texid_vbo };
 	vertex_array_set_vertex_buffers(batch_renderer->vao, buffers, 2);
 	vertex_array_set_index_buffer(batch_renderer->vao, batch_renderer->ibo);
 
-	for (uint8 i = 0; i < batch->ntextures; i++) {
-		texture_bind(batch->textures[i], i);
-	}
-
 	shader_bind(batch_renderer->shader);
-	shader_set_uniform_intv(batch_renderer->shader, "u_textures", BATCH_TEXT_IDS, batch->ntextures);
+	if (batch_renderer->texture_mode == BATCH_TEXTURE_MODE_ARRAY) {
+		shader_set_uniform_int_location(batch_renderer->shader, batch_renderer->u_texture_array, 0);
+		shader_set_uniform_int_location(batch_renderer->shader, batch_renderer->u_texture, BATCH_ARRAY_TEXTURE_SLOT);
+	} else {
+		shader_set_uniform_intv_location(batch_renderer->shader, batch_renderer->u_textures, BATCH_TEXT_IDS, 16);
+	}
 
 	Vector2u viewport_size = renderer_get_viewport_size(batch_renderer->renderer);
-	shader_set_uniform_vec3(batch_renderer->shader, "u_resolution", vec3(viewport_size.x, viewport_size.y, 0.0));
+	shader_set_uniform_vec2_location(batch_renderer->shader, batch_renderer->u_resolution, vec2(viewport_size.x, viewport_size.y));
 
-	vertex_array_draw_elements(batch_renderer->vao);
+	bool is_array_mode = batch_renderer->texture_mode == BATCH_TEXTURE_MODE_ARRAY;
+	int32 use_texture = -1;
+	uint32 bound_view = (uint32)-1;
+	for (uint32 i = 0; i < batch_renderer->nbatches; i++) {
+		const Batch *batch = &batch_renderer->batches[i];
+		if (batch->nindices == 0) {
+			continue;
+		}
+
+		if (batch->view != bound_view) {
+			shader_set_uniform_mat4_location(batch_renderer->shader, batch_renderer->u_view_projection, batch_renderer->views[batch->view]);
+			bound_view = batch->view;
+		}
+
+		if (batch->array) {
+			texture_array_bind(batch->array, 0);
+		}
+
+		if (is_array_mode) {
+			// Untextured batches mask the sample out, the sampler they read does not matter
+			int32 batch_use_texture = batch->ntextures > 0;
+			if (batch_use_texture != use_texture) {
+				shader_set_uniform_int_location(batch_renderer->shader, batch_renderer->u_use_texture, batch_use_texture);
+				use_texture = batch_use_texture;
+			}
+
+			if (batch->ntextures > 0) {
+				texture_bind(batch->textures[0], BATCH_ARRAY_TEXTURE_SLOT);
+			}
+		} else {
+			for (uint8 j = 0; j < batch->ntextures; j++) {
+				texture_bind(batch->textures[j], j);
+			}
+		}
+
+		vertex_array_draw_elements_range(batch_renderer->vao, batch->first_index, batch->nindices);
+	}
 
 	shader_unbind(batch_renderer->shader);
+
+	renderer_gpu_zone_end(batch_renderer->renderer);
+
+	batch_renderer_begin_frame();
 }
 
-void batch_renderer_draw_rect(const Texture *texture, Color color, uint32 radius, Vector2 position, Vector2u size) {
+static void draw_rect_uv(const Texture *texture, Color color, uint32 radius, Vector2 position, Vector2u size, Vector2 uv_min, Vector2 uv_max) {
 	BatchVertex vertices[4];
 	static const uint32 indices[6] = {
 		0, 1, 2,
@@ -214,13 +608,13 @@ void batch_renderer_draw_rect(const Texture *texture, Color color, uint32 radius
 	float32 h = (float32)size.y / (float32)viewport_size.y * 2.0f;
 
 	vertices[0].pos = vec3(x, y, 0.0f);
-	vertices[0].tex_coords = vec2(0.0f, 0.0f);
+	vertices[0].tex_coords = vec2(uv_min.x, uv_min.y);
 	vertices[1].pos = vec3(x + w, y, 0.0f);
-	vertices[1].tex_coords = vec2(1.0f, 0.0f);
+	vertices[1].tex_coords = vec2(uv_max.x, uv_min.y);
 	vertices[2].pos = vec3(x + w, y - h, 0.0f);
-	vertices[2].tex_coords = vec2(1.0f, 1.0f);
+	vertices[2].tex_coords = vec2(uv_max.x, uv_max.y);
 	vertices[3].pos = vec3(x, y - h, 0.0f);
-	vertices[3].tex_coords = vec2(0.0f, 1.0f);
+	vertices[3].tex_coords = vec2(uv_min.x, uv_max.y);
 
 	for (size_t i = 0; i < 4; i++) {
 		vertices[i].color = color;
@@ -231,6 +625,14 @@ void batch_renderer_draw_rect(const Texture *texture, Color color, uint32 radius
 	batch_renderer_draw(texture, vertices, indices, 4, 6);
 }
 
+void batch_renderer_draw_rect(const Texture *texture, Color color, uint32 radius, Vector2 position, Vector2u size) {
+	draw_rect_uv(texture, color, radius, position, size, vec2(0.0f, 0.0f), vec2(1.0f, 1.0f));
+}
+
+void batch_renderer_draw_region(const TextureRegion *region, Color color, Vector2 position, Vector2u size) {
+	draw_rect_uv(region->texture, color, 0, position, size, region->uv_min, region->uv_max);
+}
+
 void batch_renderer_draw_rect_outline(const Texture *texture, Color color, Color outline_color, uint32 radius, Vector2 position, Vector2u size, uint32 thickness) {
 	batch_renderer_draw_rect(texture, outline_color, radius, position, size);
 	Vector2 inner_position = vec2(position.x + thickness, position.y + thickness);
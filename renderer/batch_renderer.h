@@ -6,6 +6,7 @@
 #include "renderer.h"
 #include "shader.h"
 #include "texture.h"
+#include "texture_atlas.h"
 
 typedef struct {
 	Vector3 pos;
@@ -16,18 +17,81 @@ typedef struct {
 	float32 radius;
 } BatchVertex;
 
+typedef enum {
+	// Up to 16 textures per batch bound to separate units, selected in the shader by tex_id
+	BATCH_TEXTURE_MODE_SLOTS,
+	// Textures are copied into texture arrays grouped by size, tex_id is the array layer
+	BATCH_TEXTURE_MODE_ARRAY,
+} BatchTextureMode;
+
+typedef struct {
+	// Number of times the frame arena had to grow its storage
+	uint32 vertex_grows;
+	uint32 index_grows;
+	uint32 batch_grows;
+
+	// Current frame arena capacities
+	uint32 vertex_capacity;
+	uint32 index_capacity;
+	uint32 batch_capacity;
+
+	// Geometry submitted in the last flushed frame
+	uint32 nverts;
+	uint32 nindices;
+	uint32 nbatches;
+
+	// Texture array pages allocated in BATCH_TEXTURE_MODE_ARRAY
+	uint32 texture_arrays;
+
+	// World space draws rejected by batch_renderer_is_visible in the last frame
+	uint32 nculled;
+} BatchRendererStats;
+
+typedef enum {
+	// Positions are normalized device coordinates
+	BATCH_SPACE_SCREEN,
+	// Positions are world coordinates, transformed on the GPU by the active camera's view projection
+	BATCH_SPACE_WORLD,
+} BatchSpace;
+
+// Registers the batch renderer capacity flags. Must be called before flags are parsed.
+void batch_renderer_register_flags(FlagManager *flag_manager);
+
 void batch_renderer_init(const Renderer *renderer);
 void batch_renderer_deinit();
 
-// Ends the current frame
+// Discards anything queued and starts a new frame, back in screen space
+void batch_renderer_begin_frame();
+// Ends the current frame, uploading every queued batch at once and drawing them in order
 void batch_renderer_end_frame();
 
+// Sets the space following draws are in. Entering BATCH_SPACE_WORLD captures the active camera,
+// set it again after changing the camera. Without an active camera world space is the same as screen space.
+LS_EXPORT void batch_renderer_set_space(BatchSpace space);
+LS_EXPORT BatchSpace batch_renderer_get_space();
+// Returns false if the world space rect lies outside the active camera's view and should not be drawn.
+// Always true in screen space.
+LS_EXPORT bool batch_renderer_is_visible(Vector2 min, Vector2 max);
+// Gets the world rect seen by the active camera, to query a SpatialIndex for what to draw instead of testing everything.
+// Returns false when nothing is culled, in screen space or without an active camera.
+LS_EXPORT bool batch_renderer_get_visible_rect(Vector2 *min, Vector2 *max);
+
 // Queues a draw call to the batch renderer.
-// Draw order is always maintained. Draw calls are batched by groups of 16 textures and 1024 vertices and or indices.
-// There is a limit of 64 batch groups, if this limit is reached, the renderer will flush all batches early.
+// Draw order is always maintained. Draw calls are batched by groups of 16 textures.
+// Frame storage grows on demand, the initial capacities are set with the batch-*-capacity flags.
 LS_EXPORT void batch_renderer_draw(const Texture *texture, const BatchVertex *vertices, const uint32 *indices, size_t nverts, size_t nindices);
 
+// Queues nquads quads drawn with one texture and returns the frame storage their 4 * nquads vertices go in.
+// Each quad is two triangles, (0, 1, 2) and (2, 3, 0). Indices and texture ids are filled in here.
+// The returned pointer is only valid until the next batch renderer call.
+LS_EXPORT BatchVertex *batch_renderer_draw_quads(const Texture *texture, uint32 nquads);
+
+// Returns arena growth counters and the geometry submitted in the last frame.
+LS_EXPORT BatchRendererStats batch_renderer_get_stats();
+
 LS_EXPORT void batch_renderer_draw_rect(const Texture *texture, Color color, uint32 radius, Vector2 position, Vector2u size);
+// Draws a texture atlas region as a rect, position and size are in pixels.
+LS_EXPORT void batch_renderer_draw_region(const TextureRegion *region, Color color, Vector2 position, Vector2u size);
 LS_EXPORT void batch_renderer_draw_rect_outline(const Texture *texture, Color color, Color outline_color, uint32 radius, Vector2 position, Vector2u size, uint32 thickness);
 
 #endif // BETCH_RENDERER_H
\ No newline at end of file
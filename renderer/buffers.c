@@ -201,6 +201,11 @@ void vertex_buffer_set_sub_data(VertexBuffer *vertex_buffer, const void *data, u
 	VERTEX_BUFFER_CALL(vertex_buffer, set_sub_data, data, size, offset);
 }
 
+uint32 vertex_buffer_stream_data(VertexBuffer *vertex_buffer, const void *data, uint32 size) {
+	VERTEX_BUFFER_CALL_R(vertex_buffer, stream_data, data, size);
+	return 0;
+}
+
 void vertex_buffer_set_layout(VertexBuffer *vertex_buffer, const BufferLayout *buffer_layout) {
 	VERTEX_BUFFER_CALL(vertex_buffer, set_layout, buffer_layout);
 }
@@ -215,6 +220,11 @@ uint32 vertex_buffer_get_count(const VertexBuffer *vertex_buffer) {
 	return 0;
 }
 
+uint32 vertex_buffer_get_offset(const VertexBuffer *vertex_buffer) {
+	VERTEX_BUFFER_CALL_R(vertex_buffer, get_offset);
+	return 0;
+}
+
 struct IndexBuffer {
 	RendererBackend backend;
 
@@ -296,7 +306,17 @@ void index_buffer_set_sub_data(IndexBuffer *index_buffer, const void *data, uint
 	INDEX_BUFFER_CALL(index_buffer, set_sub_data, data, size, offset);
 }
 
+uint32 index_buffer_stream_data(IndexBuffer *index_buffer, const void *data, uint32 size) {
+	INDEX_BUFFER_CALL_R(index_buffer, stream_data, data, size);
+	return 0;
+}
+
 uint32 index_buffer_get_count(const IndexBuffer *index_buffer) {
 	INDEX_BUFFER_CALL_R(index_buffer, get_count);
 	return 0;
+}
+
+uint32 index_buffer_get_offset(const IndexBuffer *index_buffer) {
+	INDEX_BUFFER_CALL_R(index_buffer, get_offset);
+	return 0;
 }
\ No newline at end of file
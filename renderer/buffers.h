@@ -115,9 +115,15 @@ LS_EXPORT void vertex_buffer_bind(const VertexBuffer *vertex_buffer);
 LS_EXPORT void vertex_buffer_unbind(const VertexBuffer *vertex_buffer);
 LS_EXPORT void vertex_buffer_set_data(VertexBuffer *vertex_buffer, const void *data, uint32 size);
 LS_EXPORT void vertex_buffer_set_sub_data(VertexBuffer *vertex_buffer, const void *data, uint32 size, uint32 offset);
+// Appends data to the buffer treated as a ring, the size the buffer was created with is the ring capacity.
+// When the ring wraps the old storage is orphaned, so data the GPU is still reading is never overwritten.
+// Returns the byte offset the data was written at, vertex arrays pick it up as the attribute base offset.
+LS_EXPORT uint32 vertex_buffer_stream_data(VertexBuffer *vertex_buffer, const void *data, uint32 size);
 LS_EXPORT void vertex_buffer_set_layout(VertexBuffer *vertex_buffer, const BufferLayout *buffer_layout);
 LS_EXPORT const BufferLayout *vertex_buffer_get_layout(const VertexBuffer *vertex_buffer);
 LS_EXPORT uint32 vertex_buffer_get_count(const VertexBuffer *vertex_buffer);
+// Returns the byte offset of the last streamed range, 0 for buffers filled with set_data or set_sub_data.
+LS_EXPORT uint32 vertex_buffer_get_offset(const VertexBuffer *vertex_buffer);
 
 typedef struct IndexBuffer IndexBuffer;
 
@@ -129,5 +135,9 @@ LS_EXPORT void index_buffer_bind(const IndexBuffer *index_buffer);
 LS_EXPORT void index_buffer_unbind(const IndexBuffer *index_buffer);
 LS_EXPORT void index_buffer_set_data(IndexBuffer *index_buffer, const void *data, uint32 size);
 LS_EXPORT void index_buffer_set_sub_data(IndexBuffer *index_buffer, const void *data, uint32 size, uint32 offset);
+// Same as vertex_buffer_stream_data. The vertex array the index buffer is attached to must be bound.
+LS_EXPORT uint32 index_buffer_stream_data(IndexBuffer *index_buffer, const void *data, uint32 size);
 LS_EXPORT uint32 index_buffer_get_count(const IndexBuffer *index_buffer);
+// Returns the byte offset of the last streamed range, 0 for buffers filled with set_data or set_sub_data.
+LS_EXPORT uint32 index_buffer_get_offset(const IndexBuffer *index_buffer);
 #endif // BUFFERS_H
\ No newline at end of file
@@ -5,8 +5,33 @@ struct Camera {
 	Vector3 rotation;
 
 	Matrix4 projection;
+
+	bool orthographic;
+	// Perspective parameters, fov is in radians
+	float32 fov;
+	float32 aspect;
+	// Orthographic view size in world units
+	Vector2 size;
+	float32 near;
+	float32 far;
+
+	// Derived state, rebuilt on the next query after any change
+	bool dirty;
+	uint32 version;
+	Matrix4 view_projection;
+	bool has_bounds;
+	Vector2 bounds_min;
+	Vector2 bounds_max;
 };
 
+// Versions are unique across cameras so a new camera never matches a destroyed one
+static uint32 next_camera_version = 0;
+
+static void camera_mark_dirty(Camera *camera) {
+	camera->dirty = true;
+	camera->version = ++next_camera_version;
+}
+
 static const Camera *current_camera = NULL;
 
 const Camera *get_current_camera() {
@@ -14,11 +39,21 @@ const Camera *get_current_camera() {
 }
 
 Camera *camera_create(float32 fov, float32 aspect, float32 near, float32 far) {
-	Camera *camera = ls_malloc(sizeof(Camera));
+	Camera *camera = ls_calloc(1, sizeof(Camera));
 	camera->position = vec3(0.0, 0.0, 0.0);
 	camera->rotation = vec3(0.0, 0.0, 0.0);
 
-	camera->projection = mat4_perspective(fov, aspect, near, far);
+	camera_set_projection(camera, fov, aspect, near, far);
+
+	return camera;
+}
+
+Camera *camera_create_orthographic(float32 width, float32 height, float32 near, float32 far) {
+	Camera *camera = ls_calloc(1, sizeof(Camera));
+	camera->position = vec3(0.0, 0.0, 0.0);
+	camera->rotation = vec3(0.0, 0.0, 0.0);
+
+	camera_set_orthographic(camera, width, height, near, far);
 
 	return camera;
 }
@@ -29,6 +64,7 @@ void camera_destroy(Camera *camera) {
 
 void camera_set_position(Camera *camera, Vector3 position) {
 	camera->position = position;
+	camera_mark_dirty(camera);
 }
 
 Vector3 camera_get_position(const Camera *camera) {
@@ -37,6 +73,7 @@ Vector3 camera_get_position(const Camera *camera) {
 
 void camera_set_rotation(Camera *camera, Vector3 rotation) {
 	camera->rotation = rotation;
+	camera_mark_dirty(camera);
 }
 
 Vector3 camera_get_rotation(const Camera *camera) {
@@ -45,14 +82,35 @@ Vector3 camera_get_rotation(const Camera *camera) {
 
 void camera_set_projection(Camera *camera, float32 fov, float32 aspect, float32 near, float32 far) {
 	camera->projection = mat4_perspective(fov, aspect, near, far);
+	camera->orthographic = false;
+	camera->fov = fov;
+	camera->aspect = aspect;
+	camera->near = near;
+	camera->far = far;
+	camera_mark_dirty(camera);
+}
+
+void camera_set_orthographic(Camera *camera, float32 width, float32 height, float32 near, float32 far) {
+	camera->projection = mat4_ortho(-width / 2.0f, width / 2.0f, -height / 2.0f, height / 2.0f, near, far);
+	camera->orthographic = true;
+	camera->size = vec2(width, height);
+	camera->near = near;
+	camera->far = far;
+	camera_mark_dirty(camera);
+}
+
+bool camera_is_orthographic(const Camera *camera) {
+	return camera->orthographic;
 }
 
 void camera_move(Camera *camera, Vector3 delta) {
 	camera->position = vec3_add(camera->position, delta);
+	camera_mark_dirty(camera);
 }
 
 void camera_rotate(Camera *camera, Vector3 delta) {
 	camera->rotation = vec3_add(camera->rotation, delta);
+	camera_mark_dirty(camera);
 }
 
 void camera_set_active(const Camera *camera) {
@@ -70,4 +128,72 @@ Matrix4 camera_get_view_matrix(const Camera *camera) {
 
 Matrix4 camera_get_projection_matrix(const Camera *camera) {
 	return camera->projection;
+}
+
+static bool compute_world_bounds(const Camera *camera, Vector2 *min, Vector2 *max) {
+	// Only cameras looking straight down -z see an axis aligned slice of the z = 0 plane
+	if (camera->rotation.x != 0.0f || camera->rotation.y != 0.0f) {
+		return false;
+	}
+
+	Vector2 half;
+	if (camera->orthographic) {
+		half = vec2(camera->size.x / 2.0f, camera->size.y / 2.0f);
+	} else {
+		// Distance from the camera to the plane, the camera has to be in front of it
+		float32 distance = camera->position.z;
+		if (distance <= 0.0f) {
+			return false;
+		}
+
+		float32 half_height = distance * math_tanf(camera->fov / 2.0f);
+		half = vec2(half_height * camera->aspect, half_height);
+	}
+
+	// Bounding box of the view rectangle rotated around z
+	float32 r = camera->rotation.z * (PI / 180.0f);
+	float32 c = math_absf(math_cosf(r));
+	float32 s = math_absf(math_sinf(r));
+	Vector2 extent = vec2(half.x * c + half.y * s, half.x * s + half.y * c);
+
+	*min = vec2(camera->position.x - extent.x, camera->position.y - extent.y);
+	*max = vec2(camera->position.x + extent.x, camera->position.y + extent.y);
+
+	return true;
+}
+
+static void camera_update(const Camera *camera) {
+	if (!camera->dirty) {
+		return;
+	}
+
+	// Cameras are always allocated mutable, the cache is not part of their observable state.
+	Camera *cache = (Camera *)camera;
+
+	// The projection helpers store translation in the last column while the GL upload and mat4_translate
+	// use the last row, so the projection is transposed into the view's layout first.
+	// In that layout mat4_multiply(a, b) applies a first, then b.
+	cache->view_projection = mat4_multiply(camera_get_view_matrix(camera), mat4_transpose(camera->projection));
+	cache->has_bounds = compute_world_bounds(camera, &cache->bounds_min, &cache->bounds_max);
+	cache->dirty = false;
+}
+
+Matrix4 camera_get_view_projection(const Camera *camera) {
+	camera_update(camera);
+	return camera->view_projection;
+}
+
+bool camera_get_world_bounds(const Camera *camera, Vector2 *min, Vector2 *max) {
+	camera_update(camera);
+	if (!camera->has_bounds) {
+		return false;
+	}
+
+	*min = camera->bounds_min;
+	*max = camera->bounds_max;
+	return true;
+}
+
+uint32 camera_get_version(const Camera *camera) {
+	return camera->version;
 }
\ No newline at end of file
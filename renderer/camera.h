@@ -7,7 +7,10 @@ typedef struct Camera Camera;
 
 LS_EXPORT const Camera *get_current_camera();
 
+// Creates a perspective camera, fov is in radians.
 LS_EXPORT Camera *camera_create(float32 fov, float32 aspect, float32 near, float32 far);
+// Creates an orthographic camera showing width x height world units centered on its position.
+LS_EXPORT Camera *camera_create_orthographic(float32 width, float32 height, float32 near, float32 far);
 LS_EXPORT void camera_destroy(Camera *camera);
 
 LS_EXPORT void camera_set_position(Camera *camera, Vector3 position);
@@ -16,6 +19,8 @@ LS_EXPORT void camera_set_rotation(Camera *camera, Vector3 rotation);
 LS_EXPORT Vector3 camera_get_rotation(const Camera *camera);
 
 LS_EXPORT void camera_set_projection(Camera *camera, float32 fov, float32 aspect, float32 near, float32 far);
+LS_EXPORT void camera_set_orthographic(Camera *camera, float32 width, float32 height, float32 near, float32 far);
+LS_EXPORT bool camera_is_orthographic(const Camera *camera);
 
 LS_EXPORT void camera_move(Camera *camera, Vector3 delta);
 LS_EXPORT void camera_rotate(Camera *camera, Vector3 delta);
@@ -25,5 +30,12 @@ LS_EXPORT void camera_set_active(const Camera *camera);
 
 LS_EXPORT Matrix4 camera_get_view_matrix(const Camera *camera);
 LS_EXPORT Matrix4 camera_get_projection_matrix(const Camera *camera);
+// Returns projection * view in the layout shader_set_uniform_mat4 uploads, world positions go straight to clip space.
+LS_EXPORT Matrix4 camera_get_view_projection(const Camera *camera);
+// Writes the world space rectangle of the z = 0 plane the camera sees, used for culling.
+// Returns false when the camera is tilted around x or y and has no such rectangle.
+LS_EXPORT bool camera_get_world_bounds(const Camera *camera, Vector2 *min, Vector2 *max);
+// Changes whenever the camera is moved, rotated or reprojected.
+LS_EXPORT uint32 camera_get_version(const Camera *camera);
 
 #endif // CMARA_H
\ No newline at end of file
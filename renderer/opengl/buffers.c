@@ -1,14 +1,22 @@
 #include "renderer/opengl/buffers.h"
 #include "renderer/buffers.h"
 #include "renderer/opengl/debug.h"
+#include "renderer/opengl/state.h"
 
 #include <glad/gl.h>
 
+// Ring offsets are kept 4 byte aligned so every attribute and index pointer stays aligned.
+#define STREAM_ALIGNMENT 4
+
 struct OpenGLVertexBuffer {
 	uint32 id;
 	uint32 count;
 	const BufferLayout *buffer_layout;
 	BufferUsage usage;
+
+	uint32 capacity;
+	uint32 head;
+	uint32 offset;
 };
 
 static GLenum buffer_usage_to_gl(BufferUsage usage) {
@@ -25,45 +33,89 @@ static GLenum buffer_usage_to_gl(BufferUsage usage) {
 	}
 }
 
+// Writes data at the ring head of the buffer currently bound to target and returns the offset it was written at.
+// Once the ring is full the storage is orphaned, the driver hands us a fresh block while the GPU keeps reading the old one.
+static uint32 stream_buffer_data(GLenum target, uint32 *capacity, uint32 *head, BufferUsage usage, const void *data, uint32 size) {
+	if (size > *capacity) {
+		*capacity = size * 2;
+		*head = 0;
+		GL_CALL(glBufferData(target, *capacity, NULL, buffer_usage_to_gl(usage)));
+	} else if (*head + size > *capacity) {
+		*head = 0;
+		GL_CALL(glBufferData(target, *capacity, NULL, buffer_usage_to_gl(usage)));
+	}
+
+	uint32 offset = *head;
+	if (size > 0) {
+#if defined(WEB_ENABLED)
+		// WebGL2 has no buffer mapping, the written range never overlaps in flight data so this does not sync either.
+		GL_CALL(glBufferSubData(target, offset, size, data));
+#else
+		GL_CALL(void *dst = glMapBufferRange(target, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+		if (dst) {
+			ls_memcpy(dst, data, size);
+			GL_CALL(glUnmapBuffer(target));
+		} else {
+			GL_CALL(glBufferSubData(target, offset, size, data));
+		}
+#endif // WEB_ENABLED
+	}
+
+	*head = (offset + size + STREAM_ALIGNMENT - 1) & ~(STREAM_ALIGNMENT - 1);
+	return offset;
+}
+
 OpenGLVertexBuffer *opengl_create_vertex_buffer_empty(BufferUsage usage) {
-	OpenGLVertexBuffer *vertex_buffer = ls_malloc(sizeof(OpenGLVertexBuffer));
+	OpenGLVertexBuffer *vertex_buffer = ls_calloc(1, sizeof(OpenGLVertexBuffer));
 	vertex_buffer->usage = usage;
 	GL_CALL(glGenBuffers(1, &vertex_buffer->id));
 	return vertex_buffer;
 }
 
 OpenGLVertexBuffer *opengl_create_vertex_buffer(const void *data, uint32 size, BufferUsage usage) {
-	OpenGLVertexBuffer *vertex_buffer = ls_malloc(sizeof(OpenGLVertexBuffer));
+	OpenGLVertexBuffer *vertex_buffer = ls_calloc(1, sizeof(OpenGLVertexBuffer));
 	vertex_buffer->usage = usage;
+	vertex_buffer->capacity = size;
 	GL_CALL(glGenBuffers(1, &vertex_buffer->id));
-	GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer->id));
+	opengl_state_bind_buffer(GL_ARRAY_BUFFER, vertex_buffer->id);
 	GL_CALL(glBufferData(GL_ARRAY_BUFFER, size, data, buffer_usage_to_gl(usage)));
 	return vertex_buffer;
 }
 
 void opengl_vertex_buffer_destroy(OpenGLVertexBuffer *vertex_buffer) {
-	GL_CALL(glDeleteBuffers(1, &vertex_buffer->id));
+	opengl_state_delete_buffer(vertex_buffer->id);
 	ls_free(vertex_buffer);
 }
 
 void opengl_vertex_buffer_set_data(OpenGLVertexBuffer *vertex_buffer, const void *data, uint32 size) {
-	GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer->id));
+	opengl_state_bind_buffer(GL_ARRAY_BUFFER, vertex_buffer->id);
 	GL_CALL(glBufferData(GL_ARRAY_BUFFER, size, data, buffer_usage_to_gl(vertex_buffer->usage)));
 	vertex_buffer->count = size / buffer_layout_get_stride(vertex_buffer->buffer_layout);
+	vertex_buffer->capacity = size;
+	vertex_buffer->head = 0;
+	vertex_buffer->offset = 0;
 }
 
 void opengl_vertex_buffer_set_sub_data(OpenGLVertexBuffer *vertex_buffer, const void *data, uint32 size, uint32 offset) {
-	GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer->id));
+	opengl_state_bind_buffer(GL_ARRAY_BUFFER, vertex_buffer->id);
 	GL_CALL(glBufferSubData(GL_ARRAY_BUFFER, offset, size, data));
 	vertex_buffer->count = size / buffer_layout_get_stride(vertex_buffer->buffer_layout);
+	vertex_buffer->offset = 0;
+}
+
+uint32 opengl_vertex_buffer_stream_data(OpenGLVertexBuffer *vertex_buffer, const void *data, uint32 size) {
+	opengl_state_bind_buffer(GL_ARRAY_BUFFER, vertex_buffer->id);
+	vertex_buffer->offset = stream_buffer_data(GL_ARRAY_BUFFER, &vertex_buffer->capacity, &vertex_buffer->head, vertex_buffer->usage, data, size);
+	vertex_buffer->count = size / buffer_layout_get_stride(vertex_buffer->buffer_layout);
+	return vertex_buffer->offset;
 }
 
 void opengl_vertex_buffer_bind(const OpenGLVertexBuffer *vertex_buffer) {
-	GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer->id));
+	opengl_state_bind_buffer(GL_ARRAY_BUFFER, vertex_buffer->id);
 }
 
 void opengl_vertex_buffer_unbind(const OpenGLVertexBuffer *vertex_buffer) {
-	GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, 0));
+	opengl_state_bind_buffer(GL_ARRAY_BUFFER, 0);
 }
 
 void opengl_vertex_buffer_set_layout(OpenGLVertexBuffer *vertex_buffer, const BufferLayout *buffer_layout) {
@@ -78,25 +130,34 @@ uint32 opengl_vertex_buffer_get_count(const OpenGLVertexBuffer *vertex_buffer) {
 	return vertex_buffer->count;
 }
 
+uint32 opengl_vertex_buffer_get_offset(const OpenGLVertexBuffer *vertex_buffer) {
+	return vertex_buffer->offset;
+}
+
 struct OpenGLIndexBuffer {
 	uint32 id;
 	uint32 count;
 
 	BufferUsage usage;
+
+	uint32 capacity;
+	uint32 head;
+	uint32 offset;
 };
 
 OpenGLIndexBuffer *opengl_index_buffer_create_empty(BufferUsage usage) {
-	OpenGLIndexBuffer *index_buffer = ls_malloc(sizeof(OpenGLIndexBuffer));
+	OpenGLIndexBuffer *index_buffer = ls_calloc(1, sizeof(OpenGLIndexBuffer));
 	index_buffer->usage = usage;
 	GL_CALL(glGenBuffers(1, &index_buffer->id));
 	return index_buffer;
 }
 
 OpenGLIndexBuffer *opengl_index_buffer_create(const void *data, uint32 size, BufferUsage usage) {
-	OpenGLIndexBuffer *index_buffer = ls_malloc(sizeof(OpenGLIndexBuffer));
+	OpenGLIndexBuffer *index_buffer = ls_calloc(1, sizeof(OpenGLIndexBuffer));
 	index_buffer->usage = usage;
+	index_buffer->capacity = size;
 	GL_CALL(glGenBuffers(1, &index_buffer->id));
-	GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer->id));
+	opengl_state_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer->id);
 	GL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, buffer_usage_to_gl(usage)));
 
 	index_buffer->count = size / sizeof(uint32);
@@ -104,36 +165,52 @@ OpenGLIndexBuffer *opengl_index_buffer_create(const void *data, uint32 size, Buf
 }
 
 void opengl_index_buffer_destroy(OpenGLIndexBuffer *index_buffer) {
-	GL_CALL(glDeleteBuffers(1, &index_buffer->id));
+	opengl_state_delete_buffer(index_buffer->id);
 	ls_free(index_buffer);
 }
 
 void opengl_index_buffer_bind(const OpenGLIndexBuffer *index_buffer) {
 	if (index_buffer == NULL) {
-		GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+		opengl_state_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 		return;
 	}
-	GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer->id));
+	opengl_state_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer->id);
 }
 
 void opengl_index_buffer_unbind(const OpenGLIndexBuffer *index_buffer) {
-	GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+	opengl_state_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
 void opengl_index_buffer_set_data(OpenGLIndexBuffer *index_buffer, const void *data, uint32 size) {
-	GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer->id));
+	opengl_state_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer->id);
 	GL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, buffer_usage_to_gl(index_buffer->usage)));
 
 	index_buffer->count = size / sizeof(uint32);
+	index_buffer->capacity = size;
+	index_buffer->head = 0;
+	index_buffer->offset = 0;
 }
 
 void opengl_index_buffer_set_sub_data(OpenGLIndexBuffer *index_buffer, const void *data, uint32 size, uint32 offset) {
-	GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer->id));
+	opengl_state_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer->id);
 	GL_CALL(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, size, data));
 
 	index_buffer->count = size / sizeof(uint32);
+	index_buffer->offset = 0;
+}
+
+uint32 opengl_index_buffer_stream_data(OpenGLIndexBuffer *index_buffer, const void *data, uint32 size) {
+	// The element buffer binding is VAO state, callers must have the target vertex array bound.
+	opengl_state_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer->id);
+	index_buffer->offset = stream_buffer_data(GL_ELEMENT_ARRAY_BUFFER, &index_buffer->capacity, &index_buffer->head, index_buffer->usage, data, size);
+	index_buffer->count = size / sizeof(uint32);
+	return index_buffer->offset;
 }
 
 uint32 opengl_index_buffer_get_count(const OpenGLIndexBuffer *index_buffer) {
 	return index_buffer->count;
+}
+
+uint32 opengl_index_buffer_get_offset(const OpenGLIndexBuffer *index_buffer) {
+	return index_buffer->offset;
 }
\ No newline at end of file
@@ -16,11 +16,13 @@ void opengl_vertex_buffer_unbind(const OpenGLVertexBuffer *vertex_buffer);
 
 void opengl_vertex_buffer_set_data(OpenGLVertexBuffer *vertex_buffer, const void *data, uint32 size);
 void opengl_vertex_buffer_set_sub_data(OpenGLVertexBuffer *vertex_buffer, const void *data, uint32 size, uint32 offset);
+uint32 opengl_vertex_buffer_stream_data(OpenGLVertexBuffer *vertex_buffer, const void *data, uint32 size);
 
 void opengl_vertex_buffer_set_layout(OpenGLVertexBuffer *vertex_buffer, const BufferLayout *buffer_layout);
 const BufferLayout *opengl_vertex_buffer_get_layout(const OpenGLVertexBuffer *vertex_buffer);
 
 uint32 opengl_vertex_buffer_get_count(const OpenGLVertexBuffer *vertex_buffer);
+uint32 opengl_vertex_buffer_get_offset(const OpenGLVertexBuffer *vertex_buffer);
 
 typedef struct OpenGLIndexBuffer OpenGLIndexBuffer;
 
@@ -30,10 +32,12 @@ void opengl_index_buffer_destroy(OpenGLIndexBuffer *index_buffer);
 
 void opengl_index_buffer_set_data(OpenGLIndexBuffer *index_buffer, const void *data, uint32 size);
 void opengl_index_buffer_set_sub_data(OpenGLIndexBuffer *index_buffer, const void *data, uint32 size, uint32 offset);
+uint32 opengl_index_buffer_stream_data(OpenGLIndexBuffer *index_buffer, const void *data, uint32 size);
 
 void opengl_index_buffer_bind(const OpenGLIndexBuffer *index_buffer);
 void opengl_index_buffer_unbind(const OpenGLIndexBuffer *index_buffer);
 
 uint32 opengl_index_buffer_get_count(const OpenGLIndexBuffer *index_buffer);
+uint32 opengl_index_buffer_get_offset(const OpenGLIndexBuffer *index_buffer);
 
 #endif // OPENGL_BUFFERS_H
\ No newline at end of file
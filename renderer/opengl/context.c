@@ -3,6 +3,7 @@
 #include "core/core.h"
 
 #include "renderer/opengl/debug.h"
+#include "renderer/opengl/state.h"
 #include <GL/gl.h>
 
 #if defined(EGL_ENABLED)
@@ -41,6 +42,9 @@ struct OpenGLContext {
 	};
 };
 
+// The context last made current on this process, used to tell when tracked GL state goes stale.
+static const OpenGLContext *current_context = NULL;
+
 static void opengl_init(OpenGLContext *context, const LSWindow *window) {
 	GL_CALL(glEnable(GL_BLEND));
 	GL_CALL(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
@@ -103,6 +107,10 @@ void opengl_context_destroy(OpenGLContext *context) {
 			ls_log_fatal("Unknown OpenGL context type: %d\n", context->type);
 	};
 
+	if (current_context == context) {
+		current_context = NULL;
+	}
+
 	ls_free(context);
 }
 
@@ -125,6 +133,12 @@ void opengl_context_make_current(const OpenGLContext *context) {
 		default:
 			ls_log_fatal("Unknown OpenGL context type: %d\n", context->type);
 	};
+
+	// Bindings belong to the context, whatever we tracked for the previous one is stale.
+	if (current_context != context) {
+		opengl_state_invalidate();
+		current_context = context;
+	}
 }
 
 void opengl_context_detach(const OpenGLContext *context) {
@@ -147,6 +161,8 @@ void opengl_context_detach(const OpenGLContext *context) {
 		default:
 			ls_log_fatal("Unknown OpenGL context type: %d\n", context->type);
 	};
+
+	current_context = NULL;
 }
 
 void opengl_context_swap_buffers(OpenGLContext *context) {
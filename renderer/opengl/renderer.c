@@ -1,5 +1,7 @@
 #include "renderer/opengl/renderer.h"
 #include "renderer/opengl/renderer_interface.h"
+#include "renderer/opengl/state.h"
+#include "renderer/opengl/timer.h"
 
 #include "core/core.h"
 
@@ -16,6 +18,8 @@
 struct OpenGLRenderer {
 	const LSCore *core;
 
+	OpenGLState state;
+
 #if defined(EGL_ENABLED)
 	bool egl_enabled;
 #endif // EGL_ENABLED
@@ -28,6 +32,7 @@ struct OpenGLRenderer {
 OpenGLRenderer *opengl_renderer_create(const LSCore *core) {
 	OpenGLRenderer *renderer = ls_malloc(sizeof(OpenGLRenderer));
 	renderer->core = core;
+	opengl_state_init(&renderer->state);
 
 #if defined(EGL_ENABLED)
 	renderer->egl_enabled = egl_init(core_get_os(core));
@@ -41,6 +46,8 @@ OpenGLRenderer *opengl_renderer_create(const LSCore *core) {
 }
 
 void opengl_renderer_destroy(OpenGLRenderer *renderer) {
+	opengl_timer_deinit();
+
 #if defined(EGL_ENABLED)
 	if (renderer->egl_enabled) {
 		egl_deinit();
@@ -59,6 +66,9 @@ void opengl_renderer_destroy(OpenGLRenderer *renderer) {
 void opengl_register_methods(RendererInterface *renderer_interface) {
 	renderer_interface->set_clear_color = opengl_set_clear_color;
 	renderer_interface->clear = opengl_clear;
+	renderer_interface->get_state_stats = opengl_state_get_stats;
+	renderer_interface->gpu_zone_begin = opengl_gpu_zone_begin;
+	renderer_interface->gpu_zone_end = opengl_gpu_zone_end;
 }
 
 const LSCore *opengl_renderer_get_core(const OpenGLRenderer *renderer) {
@@ -1,13 +1,32 @@
 #include "renderer/opengl/shader.h"
 #include "renderer/opengl/debug.h"
 #include "renderer/opengl/renderer_interface.h"
+#include "renderer/opengl/state.h"
 
 #include <glad/gl.h>
 
+typedef struct {
+	char *name;
+	GLint location;
+} OpenGLShaderVariable;
+
 struct OpenGLShader {
 	GLuint program;
+
+	// Active uniforms and attributes are resolved once at link time.
+	OpenGLShaderVariable *uniforms;
+	uint32 nuniforms;
+	Hashtable *uniform_locations;
+	// Names outside the active set, such as "u_textures[3]", resolved by the driver on first use.
+	Hashtable *uniform_fallbacks;
+
+	OpenGLShaderVariable *attributes;
+	uint32 nattributes;
+	Hashtable *attrib_locations;
 };
 
+static void cache_variables(OpenGLShader *shader, bool uniforms);
+
 OpenGLShader *opengl_create_shader(const char *vertex_source, const char *fragment_source) {
 	GL_CALL(GLuint vertex_shader = glCreateShader(GL_VERTEX_SHADER));
 	GL_CALL(glShaderSource(vertex_shader, 1, &vertex_source, NULL));
@@ -49,7 +68,7 @@ OpenGLShader *opengl_create_shader(const char *vertex_source, const char *fragme
 		return 0;
 	}
 
-	OpenGLShader *shader = ls_malloc(sizeof(OpenGLShader));
+	OpenGLShader *shader = ls_calloc(1, sizeof(OpenGLShader));
 
 	GL_CALL(shader->program = glCreateProgram());
 	GL_CALL(glAttachShader(shader->program, vertex_shader));
@@ -76,54 +95,179 @@ OpenGLShader *opengl_create_shader(const char *vertex_source, const char *fragme
 	GL_CALL(glDeleteShader(vertex_shader));
 	GL_CALL(glDeleteShader(fragment_shader));
 
+	cache_variables(shader, true);
+	cache_variables(shader, false);
+	shader->uniform_fallbacks = hashtable_create(HASHTABLE_KEY_STRING, 4, true);
+
 	return shader;
 }
 
 void opengl_shader_destroy(OpenGLShader *shader) {
-	GL_CALL(glDeleteProgram(shader->program));
+	opengl_state_delete_program(shader->program);
+
+	for (uint32 i = 0; i < shader->nuniforms; i++) {
+		ls_free(shader->uniforms[i].name);
+	}
+	for (uint32 i = 0; i < shader->nattributes; i++) {
+		ls_free(shader->attributes[i].name);
+	}
+
+	if (shader->uniform_locations) {
+		hashtable_destroy(shader->uniform_locations);
+	}
+	if (shader->attrib_locations) {
+		hashtable_destroy(shader->attrib_locations);
+	}
+	if (shader->uniform_fallbacks) {
+		hashtable_destroy(shader->uniform_fallbacks);
+	}
+
+	ls_free(shader->uniforms);
+	ls_free(shader->attributes);
 	ls_free(shader);
 }
 
 void opengl_shader_bind(const OpenGLShader *shader) {
-	GL_CALL(glUseProgram(shader->program));
+	opengl_state_use_program(shader->program);
 }
 
 void opengl_shader_unbind(const OpenGLShader *shader) {
-	GL_CALL(glUseProgram(0));
+	opengl_state_use_program(0);
+}
+
+static GLint lookup_location(const Hashtable *locations, String name) {
+	if (!hashtable_contains(locations, HASH_KEY(str, name))) {
+		return -1;
+	}
+
+	const OpenGLShaderVariable *variable = hashtable_get(locations, HASH_KEY(str, name)).ptr;
+	return variable->location;
 }
 
 void opengl_shader_set_uniform_int(const OpenGLShader *shader, String name, int32 value) {
-	GL_CALL(glUniform1i(glGetUniformLocation(shader->program, name), value));
+	opengl_shader_set_uniform_int_location(shader, opengl_shader_get_uniform_location(shader, name), value);
 }
 
 void opengl_shader_set_uniform_float(const OpenGLShader *shader, String name, float value) {
-	GL_CALL(glUniform1f(glGetUniformLocation(shader->program, name), value));
+	opengl_shader_set_uniform_float_location(shader, opengl_shader_get_uniform_location(shader, name), value);
 }
 
 void opengl_shader_set_uniform_vec2(const OpenGLShader *shader, String name, Vector2 value) {
-	GL_CALL(glUniform2f(glGetUniformLocation(shader->program, name), value.x, value.y));
+	opengl_shader_set_uniform_vec2_location(shader, opengl_shader_get_uniform_location(shader, name), value);
 }
 
 void opengl_shader_set_uniform_vec3(const OpenGLShader *shader, String name, Vector3 value) {
-	GL_CALL(glUniform3f(glGetUniformLocation(shader->program, name), value.x, value.y, value.z));
+	opengl_shader_set_uniform_vec3_location(shader, opengl_shader_get_uniform_location(shader, name), value);
 }
 
 void opengl_shader_set_uniform_mat4(const OpenGLShader *shader, String name, Matrix4 value) {
-	GL_CALL(glUniformMatrix4fv(glGetUniformLocation(shader->program, name), 1, GL_FALSE, &value.mat[0]));
+	opengl_shader_set_uniform_mat4_location(shader, opengl_shader_get_uniform_location(shader, name), value);
 }
 
 void opengl_shader_set_uniform_intv(const OpenGLShader *shader, String name, const int32 *value, size_t count) {
-	GL_CALL(glUniform1iv(glGetUniformLocation(shader->program, name), count, value));
+	opengl_shader_set_uniform_intv_location(shader, opengl_shader_get_uniform_location(shader, name), value, count);
 }
 
 void opengl_shader_set_uniform_floatv(const OpenGLShader *shader, String name, const float32 *value, size_t count) {
-	GL_CALL(glUniform1fv(glGetUniformLocation(shader->program, name), count, value));
+	opengl_shader_set_uniform_floatv_location(shader, opengl_shader_get_uniform_location(shader, name), value, count);
+}
+
+void opengl_shader_set_uniform_int_location(const OpenGLShader *shader, int32 location, int32 value) {
+	GL_CALL(glUniform1i(location, value));
+}
+
+void opengl_shader_set_uniform_float_location(const OpenGLShader *shader, int32 location, float32 value) {
+	GL_CALL(glUniform1f(location, value));
+}
+
+void opengl_shader_set_uniform_vec2_location(const OpenGLShader *shader, int32 location, Vector2 value) {
+	GL_CALL(glUniform2f(location, value.x, value.y));
+}
+
+void opengl_shader_set_uniform_vec3_location(const OpenGLShader *shader, int32 location, Vector3 value) {
+	GL_CALL(glUniform3f(location, value.x, value.y, value.z));
+}
+
+void opengl_shader_set_uniform_mat4_location(const OpenGLShader *shader, int32 location, Matrix4 value) {
+	GL_CALL(glUniformMatrix4fv(location, 1, GL_FALSE, &value.mat[0]));
+}
+
+void opengl_shader_set_uniform_intv_location(const OpenGLShader *shader, int32 location, const int32 *value, size_t count) {
+	GL_CALL(glUniform1iv(location, count, value));
+}
+
+void opengl_shader_set_uniform_floatv_location(const OpenGLShader *shader, int32 location, const float32 *value, size_t count) {
+	GL_CALL(glUniform1fv(location, count, value));
 }
 
 int32 opengl_shader_get_uniform_location(const OpenGLShader *shader, String name) {
-	return GL_CALL(glGetUniformLocation(shader->program, name));
+	if (hashtable_contains(shader->uniform_locations, HASH_KEY(str, name))) {
+		return lookup_location(shader->uniform_locations, name);
+	}
+	if (hashtable_contains(shader->uniform_fallbacks, HASH_KEY(str, name))) {
+		return lookup_location(shader->uniform_fallbacks, name);
+	}
+
+	// The name is stored in the same allocation so the table frees both, misses are cached as -1 too.
+	size_t length = ls_str_length(name);
+	OpenGLShaderVariable *variable = ls_malloc(sizeof(OpenGLShaderVariable) + length + 1);
+	variable->name = (char *)(variable + 1);
+	ls_memcpy(variable->name, name, length + 1);
+	GL_CALL(variable->location = glGetUniformLocation(shader->program, variable->name));
+
+	hashtable_set(shader->uniform_fallbacks, HASH_KEY(str, variable->name), HASH_VAL(ptr, variable));
+	return variable->location;
 }
 
 uint32 opengl_shader_get_attrib_location(const OpenGLShader *shader, String name) {
-	return GL_CALL(glGetAttribLocation(shader->program, name));
+	return lookup_location(shader->attrib_locations, name);
+}
+
+static void cache_variables(OpenGLShader *shader, bool uniforms) {
+	GLint count = 0;
+	GLint max_length = 0;
+	GL_CALL(glGetProgramiv(shader->program, uniforms ? GL_ACTIVE_UNIFORMS : GL_ACTIVE_ATTRIBUTES, &count));
+	GL_CALL(glGetProgramiv(shader->program, uniforms ? GL_ACTIVE_UNIFORM_MAX_LENGTH : GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &max_length));
+
+	OpenGLShaderVariable *variables = ls_calloc(count > 0 ? count : 1, sizeof(OpenGLShaderVariable));
+	Hashtable *locations = hashtable_create(HASHTABLE_KEY_STRING, count > 0 ? count * 2 : 1, false);
+
+	char *name = ls_malloc(max_length + 1);
+	for (GLint i = 0; i < count; i++) {
+		GLsizei length = 0;
+		GLint size = 0;
+		GLenum type = 0;
+		if (uniforms) {
+			GL_CALL(glGetActiveUniform(shader->program, i, max_length + 1, &length, &size, &type, name));
+		} else {
+			GL_CALL(glGetActiveAttrib(shader->program, i, max_length + 1, &length, &size, &type, name));
+		}
+		name[length] = '\0';
+
+		// Arrays are reported as name[0], they are looked up by their base name.
+		if (length > 3 && ls_str_equals(&name[length - 3], "[0]")) {
+			name[length - 3] = '\0';
+		}
+
+		OpenGLShaderVariable *variable = &variables[i];
+		variable->name = ls_str_copy(name);
+		if (uniforms) {
+			GL_CALL(variable->location = glGetUniformLocation(shader->program, variable->name));
+		} else {
+			GL_CALL(variable->location = glGetAttribLocation(shader->program, variable->name));
+		}
+
+		hashtable_set(locations, HASH_KEY(str, variable->name), HASH_VAL(ptr, variable));
+	}
+	ls_free(name);
+
+	if (uniforms) {
+		shader->uniforms = variables;
+		shader->nuniforms = count;
+		shader->uniform_locations = locations;
+	} else {
+		shader->attributes = variables;
+		shader->nattributes = count;
+		shader->attrib_locations = locations;
+	}
 }
\ No newline at end of file
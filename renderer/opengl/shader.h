@@ -19,6 +19,14 @@ void opengl_shader_set_uniform_mat4(const OpenGLShader *shader, String name, Mat
 void opengl_shader_set_uniform_intv(const OpenGLShader *shader, String name, const int32 *value, size_t count);
 void opengl_shader_set_uniform_floatv(const OpenGLShader *shader, String name, const float32 *value, size_t count);
 
+void opengl_shader_set_uniform_int_location(const OpenGLShader *shader, int32 location, int32 value);
+void opengl_shader_set_uniform_float_location(const OpenGLShader *shader, int32 location, float32 value);
+void opengl_shader_set_uniform_vec2_location(const OpenGLShader *shader, int32 location, Vector2 value);
+void opengl_shader_set_uniform_vec3_location(const OpenGLShader *shader, int32 location, Vector3 value);
+void opengl_shader_set_uniform_mat4_location(const OpenGLShader *shader, int32 location, Matrix4 value);
+void opengl_shader_set_uniform_intv_location(const OpenGLShader *shader, int32 location, const int32 *value, size_t count);
+void opengl_shader_set_uniform_floatv_location(const OpenGLShader *shader, int32 location, const float32 *value, size_t count);
+
 int32 opengl_shader_get_uniform_location(const OpenGLShader *shader, String name);
 uint32 opengl_shader_get_attrib_location(const OpenGLShader *shader, String name);
 
@@ -0,0 +1,165 @@
+#include "renderer/opengl/state.h"
+#include "renderer/opengl/debug.h"
+
+// Never a valid object name, used to force the next call after an invalidation.
+#define STATE_UNKNOWN ((GLuint) - 1)
+
+static OpenGLState *state = NULL;
+
+void opengl_state_init(OpenGLState *new_state) {
+	state = new_state;
+	state->issued = 0;
+	state->skipped = 0;
+	opengl_state_invalidate();
+}
+
+void opengl_state_invalidate() {
+	LS_ASSERT(state);
+
+	state->program = STATE_UNKNOWN;
+	state->vertex_array = STATE_UNKNOWN;
+	state->array_buffer = STATE_UNKNOWN;
+	state->element_buffer = STATE_UNKNOWN;
+	state->active_texture_unit = STATE_UNKNOWN;
+	for (uint32 i = 0; i < OPENGL_STATE_MAX_TEXTURE_UNITS; i++) {
+		state->textures[i] = STATE_UNKNOWN;
+		state->texture_arrays[i] = STATE_UNKNOWN;
+	}
+}
+
+void opengl_state_use_program(GLuint program) {
+	LS_ASSERT(state);
+
+	if (state->program == program) {
+		state->skipped++;
+		return;
+	}
+
+	GL_CALL(glUseProgram(program));
+	state->program = program;
+	state->issued++;
+}
+
+void opengl_state_bind_vertex_array(GLuint vertex_array) {
+	LS_ASSERT(state);
+
+	if (state->vertex_array == vertex_array) {
+		state->skipped++;
+		return;
+	}
+
+	GL_CALL(glBindVertexArray(vertex_array));
+	state->vertex_array = vertex_array;
+	// The element buffer binding belongs to the vertex array, we do not know what the new one has bound.
+	state->element_buffer = STATE_UNKNOWN;
+	state->issued++;
+}
+
+void opengl_state_bind_buffer(GLenum target, GLuint buffer) {
+	LS_ASSERT(state);
+
+	GLuint *bound = NULL;
+	switch (target) {
+		case GL_ARRAY_BUFFER:
+			bound = &state->array_buffer;
+			break;
+		case GL_ELEMENT_ARRAY_BUFFER:
+			bound = &state->element_buffer;
+			break;
+		default:
+			GL_CALL(glBindBuffer(target, buffer));
+			state->issued++;
+			return;
+	}
+
+	if (*bound == buffer) {
+		state->skipped++;
+		return;
+	}
+
+	GL_CALL(glBindBuffer(target, buffer));
+	*bound = buffer;
+	state->issued++;
+}
+
+static void bind_texture_target(GLenum target, GLuint *bound, GLuint unit, GLuint texture) {
+	LS_ASSERT_MSG(unit < OPENGL_STATE_MAX_TEXTURE_UNITS, "Texture unit %u is out of range", unit);
+
+	// Selected even when the binding is cached, callers upload to whatever the active unit has bound.
+	if (state->active_texture_unit != unit) {
+		GL_CALL(glActiveTexture(GL_TEXTURE0 + unit));
+		state->active_texture_unit = unit;
+		state->issued++;
+	}
+
+	if (bound[unit] == texture) {
+		state->skipped++;
+		return;
+	}
+
+	GL_CALL(glBindTexture(target, texture));
+	bound[unit] = texture;
+	state->issued++;
+}
+
+void opengl_state_bind_texture(GLuint unit, GLuint texture) {
+	LS_ASSERT(state);
+
+	bind_texture_target(GL_TEXTURE_2D, state->textures, unit, texture);
+}
+
+void opengl_state_bind_texture_array(GLuint unit, GLuint texture_array) {
+	LS_ASSERT(state);
+
+	bind_texture_target(GL_TEXTURE_2D_ARRAY, state->texture_arrays, unit, texture_array);
+}
+
+void opengl_state_delete_program(GLuint program) {
+	LS_ASSERT(state);
+
+	// A program that is in use is only flagged for deletion, the binding stays.
+	GL_CALL(glDeleteProgram(program));
+}
+
+void opengl_state_delete_vertex_array(GLuint vertex_array) {
+	LS_ASSERT(state);
+
+	GL_CALL(glDeleteVertexArrays(1, &vertex_array));
+	if (state->vertex_array == vertex_array) {
+		state->vertex_array = 0;
+		state->element_buffer = STATE_UNKNOWN;
+	}
+}
+
+void opengl_state_delete_buffer(GLuint buffer) {
+	LS_ASSERT(state);
+
+	GL_CALL(glDeleteBuffers(1, &buffer));
+	if (state->array_buffer == buffer) {
+		state->array_buffer = 0;
+	}
+	if (state->element_buffer == buffer) {
+		state->element_buffer = 0;
+	}
+}
+
+void opengl_state_delete_texture(GLuint texture) {
+	LS_ASSERT(state);
+
+	GL_CALL(glDeleteTextures(1, &texture));
+	for (uint32 i = 0; i < OPENGL_STATE_MAX_TEXTURE_UNITS; i++) {
+		if (state->textures[i] == texture) {
+			state->textures[i] = 0;
+		}
+		if (state->texture_arrays[i] == texture) {
+			state->texture_arrays[i] = 0;
+		}
+	}
+}
+
+void opengl_state_get_stats(uint64 *issued, uint64 *skipped) {
+	LS_ASSERT(state);
+
+	*issued = state->issued;
+	*skipped = state->skipped;
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#ifndef OPENGL_STATE_H
+#define OPENGL_STATE_H
+
+#include "core/core.h"
+
+#include <glad/gl.h>
+
+#define OPENGL_STATE_MAX_TEXTURE_UNITS 32
+
+// Mirrors the bindings of the current context so redundant glBind*/glUseProgram calls can be skipped.
+typedef struct {
+	GLuint program;
+	GLuint vertex_array;
+	GLuint array_buffer;
+	GLuint element_buffer;
+
+	GLuint active_texture_unit;
+	GLuint textures[OPENGL_STATE_MAX_TEXTURE_UNITS];
+	GLuint texture_arrays[OPENGL_STATE_MAX_TEXTURE_UNITS];
+
+	uint64 issued;
+	uint64 skipped;
+} OpenGLState;
+
+// Sets the state all tracked calls go through. Called by the OpenGL renderer on creation.
+void opengl_state_init(OpenGLState *state);
+// Forgets everything that is tracked, the next call of each kind always reaches the driver.
+// Must be called whenever a different context is made current.
+void opengl_state_invalidate();
+
+void opengl_state_use_program(GLuint program);
+void opengl_state_bind_vertex_array(GLuint vertex_array);
+void opengl_state_bind_buffer(GLenum target, GLuint buffer);
+void opengl_state_bind_texture(GLuint unit, GLuint texture);
+void opengl_state_bind_texture_array(GLuint unit, GLuint texture_array);
+
+// Deleting a bound object resets its binding to 0, these keep the cache in sync.
+void opengl_state_delete_program(GLuint program);
+void opengl_state_delete_vertex_array(GLuint vertex_array);
+void opengl_state_delete_buffer(GLuint buffer);
+void opengl_state_delete_texture(GLuint texture);
+
+void opengl_state_get_stats(uint64 *issued, uint64 *skipped);
+
+#endif // OPENGL_STATE_H
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "renderer/opengl/texture.h"
 #include "renderer/opengl/debug.h"
+#include "renderer/opengl/state.h"
 #include "renderer/opengl/utils.h"
 
 #include <glad/gl.h>
@@ -61,12 +62,11 @@ uint32 opengl_create_texture(uint32 width, uint32 height, TextureFormat format,
 }
 
 void opengl_destroy_texture(uint32 texture) {
-	GL_CALL(glDeleteTextures(1, &texture));
+	opengl_state_delete_texture(texture);
 }
 
 void opengl_bind_texture(uint32 texture, uint32 slot) {
-	GL_CALL(glActiveTexture(GL_TEXTURE0 + slot));
-	GL_CALL(glBindTexture(GL_TEXTURE_2D, texture));
+	opengl_state_bind_texture(slot, texture);
 }
 
 static inline void atlas_push_pixel_values(GLint alignment, GLint row_length, GLint skip_pixels, GLint skip_rows) {
@@ -87,4 +87,43 @@ void opengl_texture_add_sub_texture(uint32 texture, TextureFormat format, const
 	atlas_push_pixel_values(1, width, 0, 0);
 	GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, texture_format_to_gl(format), GL_UNSIGNED_BYTE, data));
 	atlas_push_pixel_values(alignment, row_length, skip_pixels, skip_rows);
+}
+
+uint32 opengl_create_texture_array(uint32 width, uint32 height, uint32 layers) {
+	uint32 texture_array;
+
+	GL_CALL(glGenTextures(1, &texture_array));
+	opengl_bind_texture_array(texture_array, 0);
+
+	// glTexStorage3D is GL 4.2, the desktop 3.3 loader leaves it NULL. Layers only have a base level.
+	GL_CALL(glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, width, height, layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL));
+	GL_CALL(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0));
+
+	GL_CALL(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+	GL_CALL(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+	GL_CALL(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+	GL_CALL(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+
+	return texture_array;
+}
+
+void opengl_bind_texture_array(uint32 texture_array, uint32 slot) {
+	opengl_state_bind_texture_array(slot, texture_array);
+}
+
+void opengl_texture_array_copy_layer(uint32 texture_array, uint32 layer, uint32 texture, uint32 x, uint32 y, uint32 width, uint32 height) {
+	// glCopyImageSubData is not in GLES 3.0, a framebuffer blit does the copy on the GPU instead.
+	GLuint framebuffers[2];
+	GL_CALL(glGenFramebuffers(2, framebuffers));
+
+	GL_CALL(glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffers[0]));
+	GL_CALL(glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0));
+
+	GL_CALL(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffers[1]));
+	GL_CALL(glFramebufferTextureLayer(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, texture_array, 0, layer));
+
+	GL_CALL(glBlitFramebuffer(x, y, x + width, y + height, x, y, x + width, y + height, GL_COLOR_BUFFER_BIT, GL_NEAREST));
+
+	GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+	GL_CALL(glDeleteFramebuffers(2, framebuffers));
 }
\ No newline at end of file
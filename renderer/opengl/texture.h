@@ -10,4 +10,9 @@ void opengl_destroy_texture(uint32 texture);
 void opengl_bind_texture(uint32 texture, uint32 slot);
 void opengl_texture_add_sub_texture(uint32 texture, TextureFormat format, const uint8 *data, float32 x, float32 y, float32 width, float32 height);
 
+uint32 opengl_create_texture_array(uint32 width, uint32 height, uint32 layers);
+void opengl_bind_texture_array(uint32 texture_array, uint32 slot);
+// Copies a region of a 2D texture into the same region of a texture array layer on the GPU. Both must be the same size.
+void opengl_texture_array_copy_layer(uint32 texture_array, uint32 layer, uint32 texture, uint32 x, uint32 y, uint32 width, uint32 height);
+
 #endif // OPENGL_TEXTURE_H
@@ -0,0 +1,111 @@
+#include "renderer/opengl/timer.h"
+#include "renderer/opengl/debug.h"
+
+#include <glad/gl.h>
+
+// Queries in flight, zones beyond this are dropped until older results come back.
+#define OPENGL_TIMER_MAX_PENDING 64
+#define OPENGL_TIMER_NO_ZONE 0xFFFFFFFFu
+
+static struct {
+	bool checked;
+	bool supported;
+
+	GLuint queries[OPENGL_TIMER_MAX_PENDING][2];
+	String names[OPENGL_TIMER_MAX_PENDING];
+	uint32 head;
+	uint32 count;
+	uint32 open;
+
+	// Converts GPU timestamps to the os_get_time clock, in microseconds
+	int64 offset;
+} opengl_timer = { .open = OPENGL_TIMER_NO_ZONE };
+
+static bool opengl_timer_check() {
+	if (opengl_timer.checked) {
+		return opengl_timer.supported;
+	}
+
+	opengl_timer.checked = true;
+#if !defined(WEB_ENABLED)
+	// Only loaded for desktop GL 3.3 or ARB_timer_query
+	opengl_timer.supported = glQueryCounter != NULL && glGetQueryObjectui64v != NULL;
+#endif // WEB_ENABLED
+
+	if (!opengl_timer.supported) {
+		ls_log(LOG_LEVEL_DEBUG, "GL_TIMESTAMP queries are not supported, GPU zones are disabled.\n");
+		return false;
+	}
+
+	GL_CALL(glGenQueries(OPENGL_TIMER_MAX_PENDING * 2, &opengl_timer.queries[0][0]));
+
+	GLint64 gpu_time = 0;
+	GL_CALL(glGetInteger64v(GL_TIMESTAMP, &gpu_time));
+	opengl_timer.offset = (int64)os_get_time() - gpu_time / 1000;
+
+	return true;
+}
+
+// Reports finished zones in submission order, stopping at the first result still in flight.
+static void opengl_timer_collect() {
+	while (opengl_timer.count > 0) {
+		uint32 index = opengl_timer.head;
+
+		GLuint available = 0;
+		GL_CALL(glGetQueryObjectuiv(opengl_timer.queries[index][1], GL_QUERY_RESULT_AVAILABLE, &available));
+		if (!available) {
+			break;
+		}
+
+		GLuint64 start = 0;
+		GLuint64 end = 0;
+		GL_CALL(glGetQueryObjectui64v(opengl_timer.queries[index][0], GL_QUERY_RESULT, &start));
+		GL_CALL(glGetQueryObjectui64v(opengl_timer.queries[index][1], GL_QUERY_RESULT, &end));
+
+		profiler_add_zone(opengl_timer.names[index], PROFILER_GPU_THREAD,
+				(uint64)((int64)(start / 1000) + opengl_timer.offset), (uint64)((int64)(end / 1000) + opengl_timer.offset));
+
+		opengl_timer.head = (opengl_timer.head + 1) % OPENGL_TIMER_MAX_PENDING;
+		opengl_timer.count--;
+	}
+}
+
+void opengl_gpu_zone_begin(String name) {
+	if (!profiler_is_enabled() || !opengl_timer_check()) {
+		return;
+	}
+
+	LS_ASSERT_MSG(opengl_timer.open == OPENGL_TIMER_NO_ZONE, "%s", "GPU zones do not nest.");
+
+	opengl_timer_collect();
+	if (opengl_timer.count == OPENGL_TIMER_MAX_PENDING) {
+		return;
+	}
+
+	uint32 index = (opengl_timer.head + opengl_timer.count) % OPENGL_TIMER_MAX_PENDING;
+	GL_CALL(glQueryCounter(opengl_timer.queries[index][0], GL_TIMESTAMP));
+	opengl_timer.names[index] = name;
+	opengl_timer.open = index;
+}
+
+void opengl_gpu_zone_end() {
+	if (opengl_timer.open == OPENGL_TIMER_NO_ZONE) {
+		return;
+	}
+
+	GL_CALL(glQueryCounter(opengl_timer.queries[opengl_timer.open][1], GL_TIMESTAMP));
+	opengl_timer.open = OPENGL_TIMER_NO_ZONE;
+	opengl_timer.count++;
+}
+
+void opengl_timer_deinit() {
+	if (opengl_timer.supported) {
+		GL_CALL(glDeleteQueries(OPENGL_TIMER_MAX_PENDING * 2, &opengl_timer.queries[0][0]));
+	}
+
+	opengl_timer.checked = false;
+	opengl_timer.supported = false;
+	opengl_timer.head = 0;
+	opengl_timer.count = 0;
+	opengl_timer.open = OPENGL_TIMER_NO_ZONE;
+}
\ No newline at end of file
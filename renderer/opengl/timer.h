@@ -0,0 +1,14 @@
+#ifndef OPENGL_TIMER_H
+#define OPENGL_TIMER_H
+
+#include "core/core.h"
+
+// GPU zones timed with GL_TIMESTAMP queries and reported to the profiler a few frames later, once the
+// results are available. Timestamp queries only exist in desktop GL, on GLES and WebGL zones are skipped.
+void opengl_gpu_zone_begin(String name);
+void opengl_gpu_zone_end();
+
+// Deletes the queries, the context that created them must be current.
+void opengl_timer_deinit();
+
+#endif // OPENGL_TIMER_H
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "renderer/buffers.h"
 #include "renderer/opengl/buffers.h"
 #include "renderer/opengl/debug.h"
+#include "renderer/opengl/state.h"
 
 #include <glad/gl.h>
 
@@ -46,22 +47,22 @@ OpenGLVertexArray *opengl_vertex_array_create(const OpenGLRenderer *opengl) {
 	vertex_array->index_buffer = NULL;
 
 	GL_CALL(glGenVertexArrays(1, &vertex_array->id));
-	GL_CALL(glBindVertexArray(vertex_array->id));
+	opengl_state_bind_vertex_array(vertex_array->id);
 
 	return vertex_array;
 }
 
 void opengl_vertex_array_destroy(OpenGLVertexArray *vertex_array) {
-	GL_CALL(glDeleteVertexArrays(1, &vertex_array->id));
+	opengl_state_delete_vertex_array(vertex_array->id);
 	ls_free(vertex_array);
 }
 
 void opengl_vertex_array_bind(const OpenGLVertexArray *vertex_array) {
-	GL_CALL(glBindVertexArray(vertex_array->id));
+	opengl_state_bind_vertex_array(vertex_array->id);
 }
 
 void opengl_vertex_array_unbind(const OpenGLVertexArray *vertex_array) {
-	GL_CALL(glBindVertexArray(0));
+	opengl_state_bind_vertex_array(0);
 }
 
 void opengl_vertex_array_set_vertex_buffers(OpenGLVertexArray *vertex_array, const VertexBuffer **vertex_buffers, size_t count) {
@@ -75,6 +76,8 @@ void opengl_vertex_array_set_vertex_buffers(OpenGLVertexArray *vertex_array, con
 		LS_ASSERT(vertex_buffer);
 
 		const BufferLayout *buffer_layout = vertex_buffer_get_layout(vertex_buffer);
+		// Streamed buffers hold their data at the last ring offset, static ones at 0
+		uint32 base_offset = vertex_buffer_get_offset(vertex_buffer);
 		uint32 element_count = 0;
 		const BufferElement *elements = buffer_layout_get_elements(buffer_layout, &element_count);
 
@@ -91,7 +94,7 @@ void opengl_vertex_array_set_vertex_buffers(OpenGLVertexArray *vertex_array, con
 							shader_data_type_to_opengl(element->type),
 							element->normalized ? GL_TRUE : GL_FALSE,
 							buffer_layout_get_stride(buffer_layout),
-							(const void *)(uintptr_t)element->offset));
+							(const void *)(uintptr_t)(base_offset + element->offset)));
 			index++;
 		}
 	}
@@ -102,7 +105,7 @@ void opengl_vertex_array_set_index_buffer(OpenGLVertexArray *vertex_array, const
 	if (index_buffer) {
 		index_buffer_bind(index_buffer);
 	} else {
-		GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+		opengl_state_bind_buffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	}
 
 	vertex_array->index_buffer = index_buffer;
@@ -116,7 +119,15 @@ void opengl_vertex_array_draw(const OpenGLVertexArray *vertex_array) {
 void opengl_vertex_array_draw_elements(const OpenGLVertexArray *vertex_array) {
 	opengl_vertex_array_bind(vertex_array);
 	LS_ASSERT_MSG(vertex_array->index_buffer, "%s", "No index buffer set for vertex array");
-	GL_CALL(glDrawElements(GL_TRIANGLES, index_buffer_get_count(vertex_array->index_buffer), GL_UNSIGNED_INT, NULL));
+	GL_CALL(glDrawElements(GL_TRIANGLES, index_buffer_get_count(vertex_array->index_buffer), GL_UNSIGNED_INT,
+			(const void *)(uintptr_t)index_buffer_get_offset(vertex_array->index_buffer)));
+}
+
+void opengl_vertex_array_draw_elements_range(const OpenGLVertexArray *vertex_array, uint32 first_index, uint32 count) {
+	opengl_vertex_array_bind(vertex_array);
+	LS_ASSERT_MSG(vertex_array->index_buffer, "%s", "No index buffer set for vertex array");
+	uintptr_t offset = index_buffer_get_offset(vertex_array->index_buffer) + first_index * sizeof(uint32);
+	GL_CALL(glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, (const void *)offset));
 }
 
 const IndexBuffer *opengl_vertex_array_get_index_buffer(const OpenGLVertexArray *vertex_array) {
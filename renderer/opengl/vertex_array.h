@@ -17,6 +17,7 @@ void opengl_vertex_array_set_index_buffer(OpenGLVertexArray *vertex_array, const
 
 void opengl_vertex_array_draw(const OpenGLVertexArray *vertex_array);
 void opengl_vertex_array_draw_elements(const OpenGLVertexArray *vertex_array);
+void opengl_vertex_array_draw_elements_range(const OpenGLVertexArray *vertex_array, uint32 first_index, uint32 count);
 
 const IndexBuffer *opengl_vertex_array_get_index_buffer(const OpenGLVertexArray *vertex_array);
 
@@ -1,6 +1,7 @@
 #include "renderer/renderer.h"
 
 #include "renderer.h"
+#include "renderer/batch_renderer.h"
 #include "renderer/context.h"
 #include "renderer/renderer_interface.h"
 #include "renderer/texture.h"
@@ -42,14 +43,16 @@ Renderer *renderer_create(LSCore *core) {
 	renderer->backend_flag = flag_manager_register(core_get_flag_manager(core),
 			"renderer-backend", FLAG_TYPE_STRING, FLAG_VAL(str, "OPENGL"),
 			"The renderer backend to use. Valid values are NONE and OPENGL.");
+	batch_renderer_register_flags(core_get_flag_manager(core));
 
-	texture_manager_init();
+	texture_manager_init(core_get_flag_manager(core));
 
 	return renderer;
 }
 
 void renderer_start(Renderer *renderer) {
 	check_flags(renderer);
+	texture_manager_set_backend(renderer->backend);
 	switch (renderer->backend) {
 		case RENDERER_BACKEND_NONE: {
 		} break;
@@ -125,6 +128,33 @@ Vector2u renderer_get_viewport_size(const Renderer *renderer) {
 	return renderer_context_get_size(renderer->active_context);
 }
 
+void renderer_get_state_stats(const Renderer *renderer, uint64 *issued, uint64 *skipped) {
+	*issued = 0;
+	*skipped = 0;
+
+	if (renderer->backend == RENDERER_BACKEND_NONE) {
+		return;
+	}
+
+	renderer->interface.get_state_stats(issued, skipped);
+}
+
+void renderer_gpu_zone_begin(const Renderer *renderer, String name) {
+	if (renderer->backend == RENDERER_BACKEND_NONE) {
+		return;
+	}
+
+	renderer->interface.gpu_zone_begin(name);
+}
+
+void renderer_gpu_zone_end(const Renderer *renderer) {
+	if (renderer->backend == RENDERER_BACKEND_NONE) {
+		return;
+	}
+
+	renderer->interface.gpu_zone_end();
+}
+
 static void check_flags(Renderer *renderer) {
 	ls_str_to_upper(renderer->backend_flag->str);
 
@@ -135,4 +165,10 @@ static void check_flags(Renderer *renderer) {
 	} else {
 		ls_log_fatal("Invalid renderer backend: %s\n", renderer->backend_flag->str);
 	}
+
+	// There is nothing to create a context on without a display server
+	if (renderer->backend != RENDERER_BACKEND_NONE && !core_get_os(renderer->core)) {
+		ls_log(LOG_LEVEL_INFO, "Headless core, using renderer backend NONE\n");
+		renderer->backend = RENDERER_BACKEND_NONE;
+	}
 }
\ No newline at end of file
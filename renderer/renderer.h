@@ -37,6 +37,14 @@ LS_EXPORT RendererBackend renderer_get_backend(const Renderer *renderer);
 
 LS_EXPORT Vector2u renderer_get_viewport_size(const Renderer *renderer);
 
+// Returns the number of bind/use calls issued to the backend and the number skipped because the state was already set.
+LS_EXPORT void renderer_get_state_stats(const Renderer *renderer, uint64 *issued, uint64 *skipped);
+
+// Brackets GPU work that should show up as a zone in the profiler. Zones do not nest and are
+// skipped when the profiler is disabled or the backend has no timer queries.
+LS_EXPORT void renderer_gpu_zone_begin(const Renderer *renderer, String name);
+LS_EXPORT void renderer_gpu_zone_end(const Renderer *renderer);
+
 _FORCE_INLINE_ String renderer_backend_to_string(RendererBackend backend) {
 	switch (backend) {
 		case RENDERER_BACKEND_NONE:
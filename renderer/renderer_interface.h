@@ -6,6 +6,11 @@
 typedef struct {
 	void (*set_clear_color)(float32 r, float32 g, float32 b, float32 a);
 	void (*clear)();
+	// Reports how many state changing calls reached the driver and how many were skipped as redundant.
+	void (*get_state_stats)(uint64 *issued, uint64 *skipped);
+	// Times the GPU work submitted between begin and end, reported to the profiler as a GPU zone.
+	void (*gpu_zone_begin)(String name);
+	void (*gpu_zone_end)();
 } RendererInterface;
 
 #endif // RENDERER_INTERFACE_H
\ No newline at end of file
@@ -78,9 +78,12 @@ static bool is_preprocessor_command(String cur_char) {
 }
 
 Shader *renderer_create_shader(const Renderer *renderer, String source, size_t source_size) {
-	Slice8 *opengl_vertex_source = slice8_create(source_size / 2);
-	Slice8 *opengl_fragment_source = slice8_create(source_size / 2);
-	Slice8 *preprocessor_command = slice8_create(32);
+	CharArray opengl_vertex_source;
+	CharArray opengl_fragment_source;
+	CharArray preprocessor_command;
+	char_array_init(&opengl_vertex_source, source_size / 2);
+	char_array_init(&opengl_fragment_source, source_size / 2);
+	char_array_init(&preprocessor_command, 32);
 	Shader *shader = NULL;
 
 	enum ShaderParserState state = STATE_NONE;
@@ -101,52 +104,48 @@ Shader *renderer_create_shader(const Renderer *renderer, String source, size_t s
 						cur_char++;
 					}
 
-					slice8_append(preprocessor_command, SLICE_VAL8(chr, '\0'));
-					if (!handle_preprocessor_command(slice8_get_data(preprocessor_command), &state)) {
+					char_array_append(&preprocessor_command, '\0');
+					if (!handle_preprocessor_command(preprocessor_command.data, &state)) {
 						goto error;
 					}
-					slice8_clear(preprocessor_command);
+					char_array_clear(&preprocessor_command);
 				} else {
-					slice8_append(preprocessor_command, SLICE_VAL8(chr, *cur_char));
+					char_array_append(&preprocessor_command, *cur_char);
 				}
 			} break;
 
-			case STATE_OPNGL_VERTEX: {
+			case STATE_OPNGL_VERTEX:
+			case STATE_OPNGL_FRAGMENT: {
 				if (is_preprocessor_command(cur_char)) {
 					cur_char += 3;
 					state = STATE_PREPROCESSOR;
 					break;
 				}
 
-				slice8_append(opengl_vertex_source, SLICE_VAL8(chr, *cur_char));
-			} break;
-
-			case STATE_OPNGL_FRAGMENT: {
-				if (is_preprocessor_command(cur_char)) {
-					cur_char += 3;
-					state = STATE_PREPROCESSOR;
-					break;
+				// Copy everything up to the next command in one go
+				String run_end = cur_char + 1;
+				while (*run_end != '\0' && !is_preprocessor_command(run_end)) {
+					run_end++;
 				}
 
-				slice8_append(opengl_fragment_source, SLICE_VAL8(chr, *cur_char));
+				CharArray *target = state == STATE_OPNGL_VERTEX ? &opengl_vertex_source : &opengl_fragment_source;
+				char_array_append_array(target, cur_char, run_end - cur_char);
+				cur_char = run_end - 1;
 			} break;
 		}
 		cur_char++;
 	}
 
-	RendererBackend backend = renderer_get_backend(renderer);
-
-	if (backend == RENDERER_BACKEND_OPENGL) {
-		slice8_append(opengl_vertex_source, SLICE_VAL8(chr, '\0'));
-		slice8_append(opengl_fragment_source, SLICE_VAL8(chr, '\0'));
+	char_array_append(&opengl_vertex_source, '\0');
+	char_array_append(&opengl_fragment_source, '\0');
 
-		shader = renderer_create_shader_raw(renderer, slice8_get_data(opengl_vertex_source), slice8_get_data(opengl_fragment_source));
-	}
+	// The NONE backend still gets a shader object, it just never reaches a driver
+	shader = renderer_create_shader_raw(renderer, opengl_vertex_source.data, opengl_fragment_source.data);
 
 error:
-	slice8_destroy(opengl_vertex_source);
-	slice8_destroy(opengl_fragment_source);
-	slice8_destroy(preprocessor_command);
+	char_array_destroy(&opengl_vertex_source);
+	char_array_destroy(&opengl_fragment_source);
+	char_array_destroy(&preprocessor_command);
 
 	return shader;
 }
@@ -228,6 +227,34 @@ void shader_set_uniform_floatv(const Shader *shader, String name, const float32
 	SHADER_CALL(shader, set_uniform_floatv, name, value, count);
 }
 
+void shader_set_uniform_int_location(const Shader *shader, int32 location, int32 value) {
+	SHADER_CALL(shader, set_uniform_int_location, location, value);
+}
+
+void shader_set_uniform_float_location(const Shader *shader, int32 location, float32 value) {
+	SHADER_CALL(shader, set_uniform_float_location, location, value);
+}
+
+void shader_set_uniform_vec2_location(const Shader *shader, int32 location, Vector2 value) {
+	SHADER_CALL(shader, set_uniform_vec2_location, location, value);
+}
+
+void shader_set_uniform_vec3_location(const Shader *shader, int32 location, Vector3 value) {
+	SHADER_CALL(shader, set_uniform_vec3_location, location, value);
+}
+
+void shader_set_uniform_mat4_location(const Shader *shader, int32 location, Matrix4 value) {
+	SHADER_CALL(shader, set_uniform_mat4_location, location, value);
+}
+
+void shader_set_uniform_intv_location(const Shader *shader, int32 location, const int32 *value, size_t count) {
+	SHADER_CALL(shader, set_uniform_intv_location, location, value, count);
+}
+
+void shader_set_uniform_floatv_location(const Shader *shader, int32 location, const float32 *value, size_t count) {
+	SHADER_CALL(shader, set_uniform_floatv_location, location, value, count);
+}
+
 int32 shader_get_uniform_location(const Shader *shader, String name) {
 	SHADER_CALL_R(shader, get_uniform_location, name);
 	return -1;
@@ -35,9 +35,20 @@ LS_EXPORT void shader_set_uniform_intv(const Shader *shader, String name, const
 // Sets a uniform in the shader. The shader must be bound before calling this function.
 LS_EXPORT void shader_set_uniform_floatv(const Shader *shader, String name, const float32 *value, size_t count);
 
-// Returns the location of a uniform in the shader. The shader must be bound before calling this function.
+// Set a uniform by a location from shader_get_uniform_location, skipping the name lookup.
+// Resolve locations once and use these in hot paths. The shader must be bound before calling these functions.
+LS_EXPORT void shader_set_uniform_int_location(const Shader *shader, int32 location, int32 value);
+LS_EXPORT void shader_set_uniform_float_location(const Shader *shader, int32 location, float32 value);
+LS_EXPORT void shader_set_uniform_vec2_location(const Shader *shader, int32 location, Vector2 value);
+LS_EXPORT void shader_set_uniform_vec3_location(const Shader *shader, int32 location, Vector3 value);
+LS_EXPORT void shader_set_uniform_mat4_location(const Shader *shader, int32 location, Matrix4 value);
+LS_EXPORT void shader_set_uniform_intv_location(const Shader *shader, int32 location, const int32 *value, size_t count);
+LS_EXPORT void shader_set_uniform_floatv_location(const Shader *shader, int32 location, const float32 *value, size_t count);
+
+// Returns the location of a uniform in the shader, -1 if it does not exist.
+// Active uniforms are cached when the shader is linked, other names such as array elements are queried once and cached.
 LS_EXPORT int32 shader_get_uniform_location(const Shader *shader, String name);
-// Returns the location of an attribute in the shader. The shader must be bound before calling this function.
+// Returns the location of an attribute in the shader. Locations are cached when the shader is linked.
 LS_EXPORT uint32 shader_get_attrib_location(const Shader *shader, String name);
 
 #endif // SHADER_H
\ No newline at end of file
@@ -14,6 +14,8 @@ out vec2 frag_element_size;
 out float frag_radius;
 out float frag_tex_id;
 
+uniform mat4 u_view_projection;
+
 void main() {
     frag_color = in_color;
     frag_tex_coord = tex_coord;
@@ -21,7 +23,7 @@ void main() {
     frag_radius = radius;
     frag_tex_id = tex_id;
 
-    gl_Position = vec4(position, 1.0);
+    gl_Position = u_view_projection * vec4(position, 1.0);
 }
 
 #LS opengl_fragment
@@ -0,0 +1,74 @@
+#LS opengl_vertex
+#version 300 es
+
+layout (location = 0) in vec3 position;
+layout (location = 1) in vec2 tex_coord;
+layout (location = 2) in vec4 in_color;
+layout (location = 3) in vec2 element_size;
+layout (location = 4) in float radius;
+layout (location = 5) in float tex_id;
+
+out vec2 frag_tex_coord;
+out vec4 frag_color;
+out vec2 frag_element_size;
+out float frag_radius;
+out float frag_tex_id;
+
+uniform mat4 u_view_projection;
+
+void main() {
+    frag_color = in_color;
+    frag_tex_coord = tex_coord;
+    frag_element_size = element_size;
+    frag_radius = radius;
+    frag_tex_id = tex_id;
+
+    gl_Position = u_view_projection * vec4(position, 1.0);
+}
+
+#LS opengl_fragment
+#version 300 es
+
+precision mediump float;
+precision mediump sampler2DArray;
+
+out vec4 frag_color_out;
+in vec4 frag_color;
+in vec2 frag_tex_coord;
+in vec2 frag_element_size;
+in float frag_radius;
+in float frag_tex_id;
+
+uniform sampler2DArray u_texture_array;
+// Textures too big for an array page are drawn one batch at a time from u_texture.
+uniform sampler2D u_texture;
+uniform int u_use_texture;
+uniform vec2 u_resolution;
+
+float round_box_sdf(vec2 p, vec2 b, float r) {
+    vec2 q = abs(p) - (b - vec2(r));
+    return length(max(q, 0.0)) - r;
+}
+
+void main() {
+    vec4 bg_color = frag_color;
+    vec2 pixel_pos = frag_tex_coord * frag_element_size - frag_element_size / 2.0;
+
+    // Pass the full element size to the SDF, but adjust internally for rounding
+    float dist = round_box_sdf(pixel_pos, frag_element_size / 2.0, frag_radius);
+
+    // Discard fragments outside the rounded box
+    if (dist > 0.0) {
+        bg_color = vec4(0.0);
+    }
+
+    // tex_id is the layer of the bound texture array, -1 for untextured vertices.
+    // Blend instead of branching, a negative layer just clamps to layer 0 and gets masked out.
+    vec4 tex_color;
+    if (u_use_texture != 0) {
+        tex_color = texture(u_texture, frag_tex_coord);
+    } else {
+        tex_color = texture(u_texture_array, vec3(frag_tex_coord, max(frag_tex_id, 0.0)));
+    }
+    frag_color_out = mix(bg_color, tex_color * bg_color, step(0.0, frag_tex_id));
+}
\ No newline at end of file
@@ -4,12 +4,12 @@
 #include "renderer/texture.h"
 
 #define SPRITE_VERTICIES_COUNT 4
-static const float32 SPRITE_VERTICIES[] = {
-	// positions          // texture coords
-	1.0f, 1.0f, 0.0f,
-	1.0f, -1.0f, 0.0f,
-	-1.0f, -1.0f, 0.0f,
-	-1.0f, 1.0f, 0.0f
+static const Vector3 SPRITE_VERTICIES[] = {
+	// positions
+	{ { 1.0f, 1.0f, 0.0f } },
+	{ { 1.0f, -1.0f, 0.0f } },
+	{ { -1.0f, -1.0f, 0.0f } },
+	{ { -1.0f, 1.0f, 0.0f } }
 };
 
 static const float32 SPRITE_TEX_COORDS[] = {
@@ -26,88 +26,238 @@ static const uint32 SPRITE_INDECIES[] = {
 };
 
 struct Sprite {
+	// Source size in pixels, scaled for the SDF element size
 	Vector2 size;
+	Vector2 position;
+	Vector2 scale;
+	// Degrees
+	float32 rotation;
 	Matrix4 transform;
 
-	Texture *texture;
+	const Texture *texture;
+	// Reference released with the sprite, atlas pages are not referenced
+	Texture *owned_texture;
+	Vector2 uv_min;
+	Vector2 uv_max;
+
+	// Pending image load, the sprite is not drawn until it is ready
+	TextureLoad *load;
+
 	BatchVertex vertices[SPRITE_VERTICIES_COUNT];
+	// Vertices are only recomputed after the transform changed
+	bool dirty;
+
+	// Drawn through the active camera and culled against its view
+	bool world_space;
+	Vector2 bounds_min;
+	Vector2 bounds_max;
 
 	const Renderer *renderer;
 
 	Vector2i viewport_size;
 };
 
+// Translate * rotate * scale laid out for mat4_multiply_vec3, translation in the last column
+static void sprite_update_transform(Sprite *sprite) {
+	float32 r = sprite->rotation * (PI / 180.0f);
+	float32 c = math_cosf(r);
+	float32 s = math_sinf(r);
+
+	// Same rotation direction as mat4_rotate around +z
+	Matrix4 transform = MAT4_IDENTITY;
+	transform.x0 = c * sprite->scale.x;
+	transform.y0 = s * sprite->scale.y;
+	transform.w0 = sprite->position.x;
+	transform.x1 = -s * sprite->scale.x;
+	transform.y1 = c * sprite->scale.y;
+	transform.w1 = sprite->position.y;
+
+	sprite->transform = transform;
+}
+
 static void spriate_transform_vertices(Sprite *sprite) {
+	sprite_update_transform(sprite);
+
+	Vector3 positions[SPRITE_VERTICIES_COUNT];
+	mat4_transform_vec3_array(&sprite->transform, SPRITE_VERTICIES, positions, SPRITE_VERTICIES_COUNT);
+
+	sprite->bounds_min = vec2(positions[0].x, positions[0].y);
+	sprite->bounds_max = sprite->bounds_min;
+
 	for (size_t i = 0; i < SPRITE_VERTICIES_COUNT; i++) {
-		sprite->vertices[i].pos = mat4_multiply_vec3(sprite->transform, vec3(SPRITE_VERTICIES[i * 3], SPRITE_VERTICIES[i * 3 + 1], SPRITE_VERTICIES[i * 3 + 2]));
-		sprite->vertices[i].tex_coords = vec2(SPRITE_TEX_COORDS[i * 2], SPRITE_TEX_COORDS[i * 2 + 1]);
+		sprite->bounds_min = vec2(positions[i].x < sprite->bounds_min.x ? positions[i].x : sprite->bounds_min.x,
+				positions[i].y < sprite->bounds_min.y ? positions[i].y : sprite->bounds_min.y);
+		sprite->bounds_max = vec2(positions[i].x > sprite->bounds_max.x ? positions[i].x : sprite->bounds_max.x,
+				positions[i].y > sprite->bounds_max.y ? positions[i].y : sprite->bounds_max.y);
+
+		sprite->vertices[i].pos = positions[i];
+		sprite->vertices[i].tex_coords = vec2(sprite->uv_min.x + (sprite->uv_max.x - sprite->uv_min.x) * SPRITE_TEX_COORDS[i * 2],
+				sprite->uv_min.y + (sprite->uv_max.y - sprite->uv_min.y) * SPRITE_TEX_COORDS[i * 2 + 1]);
 		sprite->vertices[i].color = COLOR_WHITE;
-		sprite->vertices[i].element_size = vec2(sprite->size.x, sprite->size.y);
+		sprite->vertices[i].element_size = vec2(sprite->size.x * sprite->scale.x, sprite->size.y * sprite->scale.y);
 		sprite->vertices[i].radius = 0.0f;
 	}
+
+	sprite->dirty = false;
 }
 
-Sprite *renderer_create_sprite(const Renderer *renderer, String image_path, Vector2 position, Vector2 scale, float32 rotation) {
+static Sprite *sprite_create(const Renderer *renderer, const Texture *texture, Vector2u size, Vector2 uv_min, Vector2 uv_max, Vector2 position, Vector2 scale, float32 rotation) {
 	Sprite *sprite = ls_malloc(sizeof(Sprite));
 	sprite->renderer = renderer;
-	sprite->texture = texture_create_from_image(image_path);
+	sprite->texture = texture;
+	sprite->owned_texture = NULL;
+	sprite->load = NULL;
+	sprite->dirty = true;
+	sprite->world_space = false;
+	sprite->uv_min = uv_min;
+	sprite->uv_max = uv_max;
+
+	sprite->size = vec2(size.x, size.y);
+	sprite->position = position;
+	sprite->scale = scale;
+	sprite->rotation = rotation;
 
-	sprite->size = vec2(texture_get_width(sprite->texture), texture_get_height(sprite->texture));
-	sprite->size = vec2(sprite->size.x * scale.x, sprite->size.y * scale.y);
+	return sprite;
+}
+
+Sprite *renderer_create_sprite(const Renderer *renderer, String image_path, Vector2 position, Vector2 scale, float32 rotation) {
+	Texture *texture = texture_create_from_image(image_path);
+	if (!texture) {
+		return NULL;
+	}
+
+	return renderer_create_sprite_texture(renderer, texture, position, scale, rotation);
+}
 
-	sprite->transform = mat4_translate(vec3(position.x, position.y, 0.0));
-	sprite->transform = mat4_multiply(sprite->transform, mat4_rotate(rotation, vec3(0.0, 0.0, 1.0)));
-	sprite->transform = mat4_multiply(sprite->transform, mat4_scale(vec3(scale.x, scale.y, 1.0)));
+Sprite *renderer_create_sprite_async(const Renderer *renderer, String image_path, Vector2 position, Vector2 scale, float32 rotation) {
+	Sprite *sprite = sprite_create(renderer, NULL, vec2u(0, 0), vec2(0.0f, 0.0f), vec2(1.0f, 1.0f), position, scale, rotation);
+	sprite->load = texture_load_async(image_path);
 
 	return sprite;
 }
 
 Sprite *renderer_create_sprite_texture(const Renderer *renderer, Texture *texture, Vector2 position, Vector2 scale, float32 rotation) {
-	Sprite *sprite = ls_malloc(sizeof(Sprite));
-	sprite->renderer = renderer;
-	sprite->texture = texture;
+	Vector2u size = vec2u(texture_get_width(texture), texture_get_height(texture));
+	Sprite *sprite = sprite_create(renderer, texture, size, vec2(0.0f, 0.0f), vec2(1.0f, 1.0f), position, scale, rotation);
+	sprite->owned_texture = texture;
 
-	sprite->size = vec2(texture_get_width(sprite->texture), texture_get_height(sprite->texture));
-	sprite->size = vec2(sprite->size.x * scale.x, sprite->size.y * scale.y);
+	return sprite;
+}
 
-	sprite->transform = mat4_translate(vec3(position.x, position.y, 0.0));
-	sprite->transform = mat4_multiply(sprite->transform, mat4_rotate(rotation, vec3(0.0, 0.0, 1.0)));
-	sprite->transform = mat4_multiply(sprite->transform, mat4_scale(vec3(scale.x, scale.y, 1.0)));
+Sprite *renderer_create_sprite_region(const Renderer *renderer, const TextureRegion *region, Vector2 position, Vector2 scale, float32 rotation) {
+	return sprite_create(renderer, region->texture, region->size, region->uv_min, region->uv_max, position, scale, rotation);
+}
 
-	return sprite;
+// Picks up the texture of a finished async load. Returns false while there is nothing to draw.
+static bool sprite_resolve_load(Sprite *sprite) {
+	if (!sprite->load) {
+		return sprite->texture != NULL;
+	}
+
+	switch (texture_load_get_status(sprite->load)) {
+		case TEXTURE_LOAD_PENDING:
+			return false;
+
+		case TEXTURE_LOAD_READY: {
+			Texture *texture = texture_ref(texture_load_get_texture(sprite->load));
+			sprite->texture = texture;
+			sprite->owned_texture = texture;
+			sprite->size = vec2(texture_get_width(texture), texture_get_height(texture));
+			sprite->dirty = true;
+		} break;
+
+		case TEXTURE_LOAD_FAILED:
+			break;
+	}
+
+	texture_load_release(sprite->load);
+	sprite->load = NULL;
+
+	return sprite->texture != NULL;
+}
+
+bool sprite_is_loaded(Sprite *sprite) {
+	return sprite_resolve_load(sprite);
 }
 
 void sprite_destroy(Sprite *sprite) {
-	texture_destroy(sprite->texture);
+	if (sprite->load) {
+		texture_load_release(sprite->load);
+	}
+
+	if (sprite->owned_texture) {
+		texture_destroy(sprite->owned_texture);
+	}
 
 	ls_free(sprite);
 }
 
 void sprite_draw(Sprite *sprite) {
-	spriate_transform_vertices(sprite);
-	batch_renderer_draw(sprite->texture, sprite->vertices, SPRITE_INDECIES, SPRITE_VERTICIES_COUNT, SPRITE_INDECIES_COUNT);
+	if (!sprite_resolve_load(sprite)) {
+		return;
+	}
+
+	if (sprite->dirty) {
+		spriate_transform_vertices(sprite);
+	}
+
+	if (!sprite->world_space) {
+		batch_renderer_draw(sprite->texture, sprite->vertices, SPRITE_INDECIES, SPRITE_VERTICIES_COUNT, SPRITE_INDECIES_COUNT);
+		return;
+	}
+
+	BatchSpace space = batch_renderer_get_space();
+	batch_renderer_set_space(BATCH_SPACE_WORLD);
+
+	if (batch_renderer_is_visible(sprite->bounds_min, sprite->bounds_max)) {
+		batch_renderer_draw(sprite->texture, sprite->vertices, SPRITE_INDECIES, SPRITE_VERTICIES_COUNT, SPRITE_INDECIES_COUNT);
+	}
+
+	if (space != BATCH_SPACE_WORLD) {
+		batch_renderer_set_space(space);
+	}
+}
+
+void sprite_get_bounds(Sprite *sprite, Vector2 *min, Vector2 *max) {
+	if (sprite->dirty) {
+		spriate_transform_vertices(sprite);
+	}
+
+	*min = sprite->bounds_min;
+	*max = sprite->bounds_max;
+}
+
+void sprite_set_world_space(Sprite *sprite, bool world_space) {
+	sprite->world_space = world_space;
+}
+
+bool sprite_is_world_space(const Sprite *sprite) {
+	return sprite->world_space;
 }
 
 void sprite_set_position(Sprite *sprite, Vector2 position) {
-	sprite->transform = mat4_translate(vec3(position.x, position.y, 0.0));
+	sprite->position = position;
+	sprite->dirty = true;
 }
 
 Vector2 sprite_get_position(const Sprite *sprite) {
-	return vec2(sprite->transform.w0, sprite->transform.w1);
+	return sprite->position;
 }
 
 void sprite_set_scale(Sprite *sprite, Vector2 scale) {
-	sprite->transform = mat4_scale(vec3(sprite->size.x * scale.x, sprite->size.y * scale.y, 1.0));
+	sprite->scale = scale;
+	sprite->dirty = true;
 }
 
 Vector2 sprite_get_scale(const Sprite *sprite) {
-	return vec2(sprite->transform.x0, sprite->transform.y1);
+	return sprite->scale;
 }
 
 void sprite_set_rotation(Sprite *sprite, float32 rotation) {
-	sprite->transform = mat4_multiply(sprite->transform, mat4_rotate(rotation, vec3(0.0, 0.0, 1.0)));
+	sprite->rotation = rotation;
+	sprite->dirty = true;
 }
 
 float32 sprite_get_rotation(const Sprite *sprite) {
-	return sprite->transform.z2;
+	return sprite->rotation;
 }
\ No newline at end of file
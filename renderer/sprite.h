@@ -3,19 +3,35 @@
 
 #include "renderer/renderer.h"
 #include "renderer/texture.h"
+#include "renderer/texture_atlas.h"
 
 typedef struct Sprite Sprite;
 
-// Creates a sprite from an image file.
+// Creates a sprite from an image file. Sprites of the same file share one cached texture.
 LS_EXPORT Sprite *renderer_create_sprite(const Renderer *renderer, String image_path, Vector2 position, Vector2 scale, float32 rotation);
-// Creates a sprite from a Texture. The sprite will take ownership of the texture.
+// Creates a sprite whose image is decoded in the background. It is not drawn until the image is loaded.
+LS_EXPORT Sprite *renderer_create_sprite_async(const Renderer *renderer, String image_path, Vector2 position, Vector2 scale, float32 rotation);
+// Creates a sprite from a Texture. The sprite takes over the caller's reference and releases it when destroyed.
 LS_EXPORT Sprite *renderer_create_sprite_texture(const Renderer *renderer, Texture *texture, Vector2 position, Vector2 scale, float32 rotation);
+// Creates a sprite from a texture atlas region. The sprite does not own the atlas page.
+LS_EXPORT Sprite *renderer_create_sprite_region(const Renderer *renderer, const TextureRegion *region, Vector2 position, Vector2 scale, float32 rotation);
 // Destroys a sprite.
 LS_EXPORT void sprite_destroy(Sprite *sprite);
 
+// Returns true once the sprite has a texture to draw.
+LS_EXPORT bool sprite_is_loaded(Sprite *sprite);
+
 // Draws a sprite to the screen.
 LS_EXPORT void sprite_draw(Sprite *sprite);
 
+// Gets the axis aligned bounds of the sprite after rotation and scale, for inserting it into a SpatialIndex.
+LS_EXPORT void sprite_get_bounds(Sprite *sprite, Vector2 *min, Vector2 *max);
+
+// World space sprites are positioned in world units through the active camera and skipped when offscreen.
+// Other sprites are in normalized device coordinates.
+LS_EXPORT void sprite_set_world_space(Sprite *sprite, bool world_space);
+LS_EXPORT bool sprite_is_world_space(const Sprite *sprite);
+
 // Sets the position of the sprite.
 LS_EXPORT void sprite_set_position(Sprite *sprite, Vector2 position);
 // Gets the position of the sprite.
@@ -26,7 +42,7 @@ LS_EXPORT void sprite_set_scale(Sprite *sprite, Vector2 scale);
 // Gets the scale of the sprite.
 LS_EXPORT Vector2 sprite_get_scale(const Sprite *sprite);
 
-// Sets the rotation of the sprite.
+// Sets the rotation of the sprite in degrees.
 LS_EXPORT void sprite_set_rotation(Sprite *sprite, float32 rotation);
 // Gets the rotation of the sprite.
 LS_EXPORT float32 sprite_get_rotation(const Sprite *sprite);
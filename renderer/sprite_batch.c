@@ -0,0 +1,368 @@
+#include "renderer/sprite_batch.h"
+
+#include "renderer/batch_renderer.h"
+
+#define SPRITE_FLAG_DIRTY (1 << 0)
+#define SPRITE_FLAG_HIDDEN (1 << 1)
+
+// Corner order and texture coordinates match Sprite
+static const float32 SPRITE_BATCH_CORNERS[] = {
+	1.0f, 1.0f,
+	1.0f, -1.0f,
+	-1.0f, -1.0f,
+	-1.0f, 1.0f
+};
+
+struct SpriteBatch {
+	uint32 count;
+	uint32 capacity;
+
+	// Dense per sprite arrays, all indexed the same way
+	Vector2 *positions;
+	Vector2 *scales;
+	float32 *rotations;
+	Color *colors;
+	Vector2 *uv_mins;
+	Vector2 *uv_maxs;
+	// Source size in pixels, used for the SDF element size
+	Vector2 *sizes;
+	const Texture **textures;
+	uint8 *flags;
+	SpriteId *ids;
+
+	// Four vertices per sprite and their bounds, rebuilt only for dirty sprites
+	BatchVertex *quads;
+	Vector2 *bounds_mins;
+	Vector2 *bounds_maxs;
+
+	bool world_space;
+
+	// SpriteId -> dense index
+	uint32 *id_indices;
+	uint32 id_capacity;
+	uint32 next_id;
+
+	SpriteId *free_ids;
+	uint32 nfree_ids;
+};
+
+static void sprite_batch_grow(SpriteBatch *batch, uint32 capacity) {
+	batch->capacity = capacity;
+	batch->positions = ls_realloc(batch->positions, capacity * sizeof(Vector2));
+	batch->scales = ls_realloc(batch->scales, capacity * sizeof(Vector2));
+	batch->rotations = ls_realloc(batch->rotations, capacity * sizeof(float32));
+	batch->colors = ls_realloc(batch->colors, capacity * sizeof(Color));
+	batch->uv_mins = ls_realloc(batch->uv_mins, capacity * sizeof(Vector2));
+	batch->uv_maxs = ls_realloc(batch->uv_maxs, capacity * sizeof(Vector2));
+	batch->sizes = ls_realloc(batch->sizes, capacity * sizeof(Vector2));
+	batch->textures = ls_realloc(batch->textures, capacity * sizeof(Texture *));
+	batch->flags = ls_realloc(batch->flags, capacity * sizeof(uint8));
+	batch->ids = ls_realloc(batch->ids, capacity * sizeof(SpriteId));
+	batch->quads = ls_realloc(batch->quads, capacity * 4 * sizeof(BatchVertex));
+	batch->bounds_mins = ls_realloc(batch->bounds_mins, capacity * sizeof(Vector2));
+	batch->bounds_maxs = ls_realloc(batch->bounds_maxs, capacity * sizeof(Vector2));
+}
+
+static SpriteId sprite_batch_new_id(SpriteBatch *batch) {
+	if (batch->nfree_ids > 0) {
+		return batch->free_ids[--batch->nfree_ids];
+	}
+
+	if (batch->next_id == batch->id_capacity) {
+		batch->id_capacity *= 2;
+		batch->id_indices = ls_realloc(batch->id_indices, batch->id_capacity * sizeof(uint32));
+		batch->free_ids = ls_realloc(batch->free_ids, batch->id_capacity * sizeof(SpriteId));
+	}
+
+	return batch->next_id++;
+}
+
+_FORCE_INLINE_ uint32 sprite_batch_index(const SpriteBatch *batch, SpriteId id) {
+	LS_ASSERT(id < batch->next_id);
+
+	uint32 index = batch->id_indices[id];
+	LS_ASSERT(index < batch->count && batch->ids[index] == id);
+
+	return index;
+}
+
+static void sprite_batch_build_quad(SpriteBatch *batch, uint32 index) {
+	Vector2 position = batch->positions[index];
+	Vector2 scale = batch->scales[index];
+	Vector2 uv_min = batch->uv_mins[index];
+	Vector2 uv_max = batch->uv_maxs[index];
+	Vector2 element_size = vec2(batch->sizes[index].x * scale.x, batch->sizes[index].y * scale.y);
+	Color color = batch->colors[index];
+
+	// Same rotation as mat4_rotate around +z
+	float32 r = batch->rotations[index] * (PI / 180.0f);
+	float32 c = math_cosf(r);
+	float32 s = math_sinf(r);
+
+	BatchVertex *quad = &batch->quads[index * 4];
+	Vector2 bounds_min = vec2(FLOAT32_MAX, FLOAT32_MAX);
+	Vector2 bounds_max = vec2(FLOAT32_MIN, FLOAT32_MIN);
+	for (uint32 i = 0; i < 4; i++) {
+		float32 cx = SPRITE_BATCH_CORNERS[i * 2];
+		float32 cy = SPRITE_BATCH_CORNERS[i * 2 + 1];
+		float32 x = cx * scale.x;
+		float32 y = cy * scale.y;
+
+		quad[i].pos = vec3(position.x + c * x + s * y, position.y - s * x + c * y, 0.0f);
+		quad[i].tex_coords = vec2(cx > 0.0f ? uv_max.x : uv_min.x, cy > 0.0f ? uv_max.y : uv_min.y);
+		quad[i].color = color;
+		quad[i].element_size = element_size;
+		quad[i].radius = 0.0f;
+
+		bounds_min = vec2(quad[i].pos.x < bounds_min.x ? quad[i].pos.x : bounds_min.x, quad[i].pos.y < bounds_min.y ? quad[i].pos.y : bounds_min.y);
+		bounds_max = vec2(quad[i].pos.x > bounds_max.x ? quad[i].pos.x : bounds_max.x, quad[i].pos.y > bounds_max.y ? quad[i].pos.y : bounds_max.y);
+	}
+
+	batch->bounds_mins[index] = bounds_min;
+	batch->bounds_maxs[index] = bounds_max;
+	batch->flags[index] &= ~SPRITE_FLAG_DIRTY;
+}
+
+SpriteBatch *sprite_batch_create(uint32 capacity) {
+	SpriteBatch *batch = ls_calloc(1, sizeof(SpriteBatch));
+
+	sprite_batch_grow(batch, capacity > 0 ? capacity : 1);
+
+	batch->id_capacity = batch->capacity;
+	batch->id_indices = ls_malloc(batch->id_capacity * sizeof(uint32));
+	batch->free_ids = ls_malloc(batch->id_capacity * sizeof(SpriteId));
+
+	return batch;
+}
+
+void sprite_batch_destroy(SpriteBatch *batch) {
+	ls_free(batch->positions);
+	ls_free(batch->scales);
+	ls_free(batch->rotations);
+	ls_free(batch->colors);
+	ls_free(batch->uv_mins);
+	ls_free(batch->uv_maxs);
+	ls_free(batch->sizes);
+	ls_free(batch->textures);
+	ls_free(batch->flags);
+	ls_free(batch->ids);
+	ls_free(batch->quads);
+	ls_free(batch->bounds_mins);
+	ls_free(batch->bounds_maxs);
+	ls_free(batch->id_indices);
+	ls_free(batch->free_ids);
+	ls_free(batch);
+}
+
+static SpriteId sprite_batch_add_uv(SpriteBatch *batch, const Texture *texture, Vector2 size, Vector2 uv_min, Vector2 uv_max, Vector2 position, Vector2 scale, float32 rotation) {
+	if (batch->count == batch->capacity) {
+		sprite_batch_grow(batch, batch->capacity * 2);
+	}
+
+	uint32 index = batch->count++;
+	SpriteId id = sprite_batch_new_id(batch);
+
+	batch->positions[index] = position;
+	batch->scales[index] = scale;
+	batch->rotations[index] = rotation;
+	batch->colors[index] = COLOR_WHITE;
+	batch->uv_mins[index] = uv_min;
+	batch->uv_maxs[index] = uv_max;
+	batch->sizes[index] = size;
+	batch->textures[index] = texture;
+	batch->flags[index] = SPRITE_FLAG_DIRTY;
+	batch->ids[index] = id;
+	batch->id_indices[id] = index;
+
+	return id;
+}
+
+SpriteId sprite_batch_add(SpriteBatch *batch, const Texture *texture, Vector2 position, Vector2 scale, float32 rotation) {
+	Vector2 size = vec2(0.0f, 0.0f);
+	if (texture) {
+		size = vec2(texture_get_width(texture), texture_get_height(texture));
+	}
+
+	return sprite_batch_add_uv(batch, texture, size, vec2(0.0f, 0.0f), vec2(1.0f, 1.0f), position, scale, rotation);
+}
+
+SpriteId sprite_batch_add_region(SpriteBatch *batch, const TextureRegion *region, Vector2 position, Vector2 scale, float32 rotation) {
+	return sprite_batch_add_uv(batch, region->texture, vec2(region->size.x, region->size.y), region->uv_min, region->uv_max, position, scale, rotation);
+}
+
+void sprite_batch_remove(SpriteBatch *batch, SpriteId id) {
+	uint32 index = sprite_batch_index(batch, id);
+	uint32 last = --batch->count;
+
+	if (index != last) {
+		batch->positions[index] = batch->positions[last];
+		batch->scales[index] = batch->scales[last];
+		batch->rotations[index] = batch->rotations[last];
+		batch->colors[index] = batch->colors[last];
+		batch->uv_mins[index] = batch->uv_mins[last];
+		batch->uv_maxs[index] = batch->uv_maxs[last];
+		batch->sizes[index] = batch->sizes[last];
+		batch->textures[index] = batch->textures[last];
+		batch->flags[index] = batch->flags[last];
+		batch->ids[index] = batch->ids[last];
+		ls_memcpy(&batch->quads[index * 4], &batch->quads[last * 4], 4 * sizeof(BatchVertex));
+		batch->bounds_mins[index] = batch->bounds_mins[last];
+		batch->bounds_maxs[index] = batch->bounds_maxs[last];
+
+		batch->id_indices[batch->ids[index]] = index;
+	}
+
+	batch->free_ids[batch->nfree_ids++] = id;
+}
+
+void sprite_batch_clear(SpriteBatch *batch) {
+	batch->count = 0;
+	batch->next_id = 0;
+	batch->nfree_ids = 0;
+}
+
+uint32 sprite_batch_get_count(const SpriteBatch *batch) {
+	return batch->count;
+}
+
+// Rebuilds the sprite if needed and returns false if it is hidden or culled
+_FORCE_INLINE_ bool sprite_batch_prepare(SpriteBatch *batch, uint32 index) {
+	if (batch->flags[index] & SPRITE_FLAG_HIDDEN) {
+		return false;
+	}
+
+	if (batch->flags[index] & SPRITE_FLAG_DIRTY) {
+		sprite_batch_build_quad(batch, index);
+	}
+
+	return !batch->world_space || batch_renderer_is_visible(batch->bounds_mins[index], batch->bounds_maxs[index]);
+}
+
+void sprite_batch_emit(SpriteBatch *batch) {
+	BatchSpace space = batch_renderer_get_space();
+	if (batch->world_space) {
+		batch_renderer_set_space(BATCH_SPACE_WORLD);
+	}
+
+	uint32 i = 0;
+	while (i < batch->count) {
+		uint32 start = i;
+		const Texture *texture = batch->textures[i];
+		bool skip = false;
+		while (i < batch->count && batch->textures[i] == texture) {
+			if (!sprite_batch_prepare(batch, i)) {
+				skip = true;
+				break;
+			}
+			i++;
+		}
+
+		if (i > start) {
+			BatchVertex *vertices = batch_renderer_draw_quads(texture, i - start);
+			ls_memcpy(vertices, &batch->quads[start * 4], (i - start) * 4 * sizeof(BatchVertex));
+		}
+
+		// Hidden or culled sprite ending the run
+		if (skip) {
+			i++;
+		}
+	}
+
+	if (batch->world_space && space != BATCH_SPACE_WORLD) {
+		batch_renderer_set_space(space);
+	}
+}
+
+void sprite_batch_set_world_space(SpriteBatch *batch, bool world_space) {
+	batch->world_space = world_space;
+}
+
+void sprite_batch_set_position(SpriteBatch *batch, SpriteId id, Vector2 position) {
+	uint32 index = sprite_batch_index(batch, id);
+	batch->positions[index] = position;
+	batch->flags[index] |= SPRITE_FLAG_DIRTY;
+}
+
+Vector2 sprite_batch_get_position(const SpriteBatch *batch, SpriteId id) {
+	return batch->positions[sprite_batch_index(batch, id)];
+}
+
+void sprite_batch_set_scale(SpriteBatch *batch, SpriteId id, Vector2 scale) {
+	uint32 index = sprite_batch_index(batch, id);
+	batch->scales[index] = scale;
+	batch->flags[index] |= SPRITE_FLAG_DIRTY;
+}
+
+Vector2 sprite_batch_get_scale(const SpriteBatch *batch, SpriteId id) {
+	return batch->scales[sprite_batch_index(batch, id)];
+}
+
+void sprite_batch_set_rotation(SpriteBatch *batch, SpriteId id, float32 rotation) {
+	uint32 index = sprite_batch_index(batch, id);
+	batch->rotations[index] = rotation;
+	batch->flags[index] |= SPRITE_FLAG_DIRTY;
+}
+
+float32 sprite_batch_get_rotation(const SpriteBatch *batch, SpriteId id) {
+	return batch->rotations[sprite_batch_index(batch, id)];
+}
+
+void sprite_batch_set_color(SpriteBatch *batch, SpriteId id, Color color) {
+	uint32 index = sprite_batch_index(batch, id);
+	batch->colors[index] = color;
+	batch->flags[index] |= SPRITE_FLAG_DIRTY;
+}
+
+Color sprite_batch_get_color(const SpriteBatch *batch, SpriteId id) {
+	return batch->colors[sprite_batch_index(batch, id)];
+}
+
+void sprite_batch_set_uv(SpriteBatch *batch, SpriteId id, Vector2 uv_min, Vector2 uv_max) {
+	uint32 index = sprite_batch_index(batch, id);
+	batch->uv_mins[index] = uv_min;
+	batch->uv_maxs[index] = uv_max;
+	batch->flags[index] |= SPRITE_FLAG_DIRTY;
+}
+
+void sprite_batch_set_visible(SpriteBatch *batch, SpriteId id, bool visible) {
+	uint32 index = sprite_batch_index(batch, id);
+	if (visible) {
+		batch->flags[index] &= ~SPRITE_FLAG_HIDDEN;
+	} else {
+		batch->flags[index] |= SPRITE_FLAG_HIDDEN;
+	}
+}
+
+bool sprite_batch_is_visible(const SpriteBatch *batch, SpriteId id) {
+	return !(batch->flags[sprite_batch_index(batch, id)] & SPRITE_FLAG_HIDDEN);
+}
+
+static void sprite_batch_mark_all_dirty(SpriteBatch *batch) {
+	for (uint32 i = 0; i < batch->count; i++) {
+		batch->flags[i] |= SPRITE_FLAG_DIRTY;
+	}
+}
+
+Vector2 *sprite_batch_edit_positions(SpriteBatch *batch) {
+	sprite_batch_mark_all_dirty(batch);
+	return batch->positions;
+}
+
+Vector2 *sprite_batch_edit_scales(SpriteBatch *batch) {
+	sprite_batch_mark_all_dirty(batch);
+	return batch->scales;
+}
+
+float32 *sprite_batch_edit_rotations(SpriteBatch *batch) {
+	sprite_batch_mark_all_dirty(batch);
+	return batch->rotations;
+}
+
+Color *sprite_batch_edit_colors(SpriteBatch *batch) {
+	sprite_batch_mark_all_dirty(batch);
+	return batch->colors;
+}
+
+uint32 sprite_batch_get_index(const SpriteBatch *batch, SpriteId id) {
+	return sprite_batch_index(batch, id);
+}
\ No newline at end of file
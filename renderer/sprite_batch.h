@@ -0,0 +1,58 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include "core/core.h"
+
+#include "renderer/texture.h"
+#include "renderer/texture_atlas.h"
+
+// A pool of sprites stored as parallel arrays and emitted straight into the batch renderer.
+// Sprites use the same space as Sprite: the quad spans position +- scale, rotated by rotation degrees.
+// Each sprite's quad is only rebuilt when one of its properties changed, clean sprites are copied as is.
+typedef struct SpriteBatch SpriteBatch;
+
+// Stable handle to a sprite in a SpriteBatch, stays valid until the sprite is removed.
+typedef uint32 SpriteId;
+
+#define SPRITE_ID_INVALID ((SpriteId)-1)
+
+// capacity is the number of sprites reserved up front, the batch grows on demand.
+LS_EXPORT SpriteBatch *sprite_batch_create(uint32 capacity);
+// Does not release the sprites' textures, the batch never references them.
+LS_EXPORT void sprite_batch_destroy(SpriteBatch *batch);
+
+LS_EXPORT SpriteId sprite_batch_add(SpriteBatch *batch, const Texture *texture, Vector2 position, Vector2 scale, float32 rotation);
+LS_EXPORT SpriteId sprite_batch_add_region(SpriteBatch *batch, const TextureRegion *region, Vector2 position, Vector2 scale, float32 rotation);
+// The last sprite takes the removed sprite's place, so draw order changes after a removal.
+LS_EXPORT void sprite_batch_remove(SpriteBatch *batch, SpriteId id);
+LS_EXPORT void sprite_batch_clear(SpriteBatch *batch);
+LS_EXPORT uint32 sprite_batch_get_count(const SpriteBatch *batch);
+
+// Queues every visible sprite with the batch renderer. Consecutive sprites sharing a texture are written in one go.
+LS_EXPORT void sprite_batch_emit(SpriteBatch *batch);
+// World space batches draw through the active camera and skip sprites outside its view.
+LS_EXPORT void sprite_batch_set_world_space(SpriteBatch *batch, bool world_space);
+
+LS_EXPORT void sprite_batch_set_position(SpriteBatch *batch, SpriteId id, Vector2 position);
+LS_EXPORT Vector2 sprite_batch_get_position(const SpriteBatch *batch, SpriteId id);
+LS_EXPORT void sprite_batch_set_scale(SpriteBatch *batch, SpriteId id, Vector2 scale);
+LS_EXPORT Vector2 sprite_batch_get_scale(const SpriteBatch *batch, SpriteId id);
+// Rotation is in degrees.
+LS_EXPORT void sprite_batch_set_rotation(SpriteBatch *batch, SpriteId id, float32 rotation);
+LS_EXPORT float32 sprite_batch_get_rotation(const SpriteBatch *batch, SpriteId id);
+LS_EXPORT void sprite_batch_set_color(SpriteBatch *batch, SpriteId id, Color color);
+LS_EXPORT Color sprite_batch_get_color(const SpriteBatch *batch, SpriteId id);
+LS_EXPORT void sprite_batch_set_uv(SpriteBatch *batch, SpriteId id, Vector2 uv_min, Vector2 uv_max);
+LS_EXPORT void sprite_batch_set_visible(SpriteBatch *batch, SpriteId id, bool visible);
+LS_EXPORT bool sprite_batch_is_visible(const SpriteBatch *batch, SpriteId id);
+
+// Direct access to the dense arrays for bulk updates, indexed by sprite_batch_get_index.
+// Every sprite is marked dirty, the arrays are valid until sprites are added or removed.
+LS_EXPORT Vector2 *sprite_batch_edit_positions(SpriteBatch *batch);
+LS_EXPORT Vector2 *sprite_batch_edit_scales(SpriteBatch *batch);
+LS_EXPORT float32 *sprite_batch_edit_rotations(SpriteBatch *batch);
+LS_EXPORT Color *sprite_batch_edit_colors(SpriteBatch *batch);
+// Returns the sprite's index in the dense arrays.
+LS_EXPORT uint32 sprite_batch_get_index(const SpriteBatch *batch, SpriteId id);
+
+#endif // SPRITE_BATCH_H
\ No newline at end of file
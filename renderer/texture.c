@@ -4,20 +4,113 @@
 #include "renderer/opengl/texture.h"
 #endif
 
+struct TextureLoad {
+	// Normalized path, handed to the texture's cache entry on upload
+	char *path;
+
+	TextureLoadStatus status;
+	Texture *texture;
+	// Held by callers and by the in flight decode job
+	uint32 refcount;
+
+	// Written by the decode job
+	uint8 *data;
+	uint32 width;
+	uint32 height;
+
+	// Next finished load waiting for upload
+	struct TextureLoad *next;
+};
+
 struct TextureManager {
 	Hashtable *parsers;
+
+	// Normalized path -> Texture, keys are owned by the textures
+	Hashtable *cache;
+	TextureCacheStats stats;
+
+	// Normalized path -> TextureLoad still decoding or waiting for upload
+	Hashtable *loads;
+	// Created on the first async load, after the flags have been parsed
+	WorkerPool *decoders;
+
+	LSMutex *finished_mutex;
+	TextureLoad *finished_head;
+	TextureLoad *finished_tail;
+
+	RendererBackend backend;
 };
 
 static struct TextureManager texture_manager;
 
-void texture_manager_init() {
+static FlagValue *decoder_threads_flag = NULL;
+static FlagValue *upload_budget_flag = NULL;
+
+void texture_manager_init(FlagManager *flag_manager) {
 	texture_manager.parsers = hashtable_create(HASHTABLE_KEY_STRING, 16, false);
+	texture_manager.cache = hashtable_create(HASHTABLE_KEY_STRING, 64, false);
+	texture_manager.stats = (TextureCacheStats){ 0 };
+
+	texture_manager.loads = hashtable_create(HASHTABLE_KEY_STRING, 16, false);
+	texture_manager.decoders = NULL;
+	texture_manager.finished_mutex = os_mutex_create();
+	texture_manager.finished_head = NULL;
+	texture_manager.finished_tail = NULL;
+	texture_manager.backend = RENDERER_BACKEND_NONE;
+
+	decoder_threads_flag = flag_manager_register(flag_manager, "texture-decoder-threads", FLAG_TYPE_INT, FLAG_VAL(i32, 2),
+			"Number of threads decoding images loaded with texture_load_async.");
+	upload_budget_flag = flag_manager_register(flag_manager, "texture-upload-budget", FLAG_TYPE_INT, FLAG_VAL(i32, 16 * 1024),
+			"Kilobytes of decoded images uploaded to the GPU per frame. At least one image is uploaded every frame.");
+}
+
+static TextureLoad *texture_manager_pop_finished() {
+	os_mutex_lock(texture_manager.finished_mutex);
+
+	TextureLoad *load = texture_manager.finished_head;
+	if (load) {
+		texture_manager.finished_head = load->next;
+		if (!texture_manager.finished_head) {
+			texture_manager.finished_tail = NULL;
+		}
+		load->next = NULL;
+	}
+
+	os_mutex_unlock(texture_manager.finished_mutex);
+
+	return load;
 }
 
 void texture_manager_deinit() {
+	if (texture_manager.decoders) {
+		// Waits for the decodes still queued
+		worker_pool_destroy(texture_manager.decoders);
+	}
+
+	// Nothing is uploaded anymore, just drop the decode job references
+	TextureLoad *load = NULL;
+	while ((load = texture_manager_pop_finished())) {
+		hashtable_remove(texture_manager.loads, HASH_KEY(str, load->path));
+		ls_free(load->data);
+		load->data = NULL;
+		load->status = TEXTURE_LOAD_FAILED;
+		texture_load_release(load);
+	}
+
+	if (hashtable_get_size(texture_manager.cache) > 0) {
+		ls_log(LOG_LEVEL_WARNING, "%zu cached textures were never released\n", hashtable_get_size(texture_manager.cache));
+	}
+
+	os_mutex_destroy(texture_manager.finished_mutex);
+	hashtable_destroy(texture_manager.loads);
+	hashtable_destroy(texture_manager.cache);
 	hashtable_destroy(texture_manager.parsers);
 }
 
+void texture_manager_set_backend(RendererBackend backend) {
+	texture_manager.backend = backend;
+}
+
 void texture_manager_register_parser(String extension, TextureParseFunc parse_func) {
 	hashtable_set(texture_manager.parsers, HASH_KEY(str, extension), HASH_VAL(ptr, parse_func));
 }
@@ -27,71 +120,341 @@ struct Texture {
 	uint32 width;
 	uint32 height;
 	bool is_atlas;
+
+	uint32 refcount;
+	uint64 size_bytes;
+	// Cache key, NULL for textures not loaded from a file
+	char *path;
+
+	TextureArray *array;
+	uint32 array_layer;
 };
 
-Texture *texture_create_from_image(String path) {
-	String extension = os_path_get_extension(path);
+struct TextureArray {
+	uint32 id;
+	uint32 width;
+	uint32 height;
+	uint32 layers;
+	uint32 used_layers;
 
-	TextureParseFunc parse_func = hashtable_get(texture_manager.parsers, HASH_KEY(str, extension)).ptr;
+	// Texture stored in each layer, NULL for free layers
+	Texture **textures;
+};
+
+static void texture_array_copy_layer(TextureArray *texture_array, uint32 layer, const Texture *texture, uint32 x, uint32 y, uint32 width, uint32 height) {
+#if defined(OPENGL_ENABLED)
+	if (texture_manager.backend == RENDERER_BACKEND_OPENGL) {
+		opengl_texture_array_copy_layer(texture_array->id, layer, texture->id, x, y, width, height);
+	}
+#endif
+}
+
+uint8 *texture_load_image_data(String path, uint32 *width, uint32 *height) {
+	char *extension = os_path_get_extension(path);
+
+	TextureParseFunc parse_func = NULL;
+	if (hashtable_contains(texture_manager.parsers, HASH_KEY(str, extension))) {
+		parse_func = hashtable_get(texture_manager.parsers, HASH_KEY(str, extension)).ptr;
+	}
 
 	if (parse_func == NULL) {
 		ls_log(LOG_LEVEL_ERROR, "No texture parser found for extension %s\n", extension);
+		ls_free(extension);
 		return NULL;
 	}
+	ls_free(extension);
 
 	uint8 *data = NULL;
-	uint32 width = 0;
-	uint32 height = 0;
+	*width = 0;
+	*height = 0;
 
-	parse_func(path, &width, &height, &data);
+	parse_func(path, width, height, &data);
 	if (data == NULL) {
 		ls_log(LOG_LEVEL_ERROR, "Failed to load texture %s\n", path);
 		return NULL;
 	}
-	Texture *texture = texture_create(width, height, TEXTURE_FORMAT_RGBA, data);
+
+	return data;
+}
+
+static uint32 texture_format_channels(TextureFormat format) {
+	switch (format) {
+		case TEXTURE_FORMAT_R:
+		case TEXTURE_FORMAT_A:
+			return 1;
+		case TEXTURE_FORMAT_RG:
+			return 2;
+		case TEXTURE_FORMAT_RGB:
+			return 3;
+		case TEXTURE_FORMAT_RGBA:
+			return 4;
+		default:
+			return 0;
+	}
+}
+
+// Returns a path that is the same for every spelling of the same file. Needs to be freed.
+static char *texture_normalize_path(String path) {
+	char *normalized = os_path_to_absolute(path);
+	if (!normalized) {
+		// File does not exist, the parser will report it. Still hand back a usable key.
+		normalized = ls_str_copy(path);
+	}
+
+	for (char *c = normalized; *c; c++) {
+		if (*c == '\\') {
+			*c = '/';
+		}
+	}
+
+	return normalized;
+}
+
+Texture *texture_create_from_image(String path) {
+	char *key = texture_normalize_path(path);
+
+	Texture *texture = hashtable_get(texture_manager.cache, HASH_KEY(str, key)).ptr;
+	if (texture) {
+		ls_free(key);
+		texture_manager.stats.hits++;
+		return texture_ref(texture);
+	}
+	texture_manager.stats.misses++;
+
+	uint32 width = 0;
+	uint32 height = 0;
+	uint8 *data = texture_load_image_data(path, &width, &height);
+	if (data == NULL) {
+		ls_free(key);
+		return NULL;
+	}
+
+	texture = texture_create(width, height, TEXTURE_FORMAT_RGBA, data);
 	ls_free(data);
 
+	texture->path = key;
+	hashtable_set(texture_manager.cache, HASH_KEY(str, texture->path), HASH_VAL(ptr, texture));
+	texture_manager.stats.cached_textures++;
+
 	return texture;
 }
 
+static void texture_decode_job(void *data) {
+	TextureLoad *load = data;
+
+	// Parsers only read their input, the parser table is not modified after startup
+	load->data = texture_load_image_data(load->path, &load->width, &load->height);
+
+	os_mutex_lock(texture_manager.finished_mutex);
+	if (texture_manager.finished_tail) {
+		texture_manager.finished_tail->next = load;
+	} else {
+		texture_manager.finished_head = load;
+	}
+	texture_manager.finished_tail = load;
+	os_mutex_unlock(texture_manager.finished_mutex);
+}
+
+TextureLoad *texture_load_async(String path) {
+	char *key = texture_normalize_path(path);
+
+	TextureLoad *load = hashtable_get(texture_manager.loads, HASH_KEY(str, key)).ptr;
+	if (load) {
+		// Already decoding, share it
+		ls_free(key);
+		texture_manager.stats.hits++;
+		load->refcount++;
+		return load;
+	}
+
+	load = ls_calloc(1, sizeof(TextureLoad));
+	load->refcount = 1;
+
+	Texture *texture = hashtable_get(texture_manager.cache, HASH_KEY(str, key)).ptr;
+	if (texture) {
+		ls_free(key);
+		texture_manager.stats.hits++;
+		load->status = TEXTURE_LOAD_READY;
+		load->texture = texture_ref(texture);
+		return load;
+	}
+	texture_manager.stats.misses++;
+
+	if (!texture_manager.decoders) {
+		int32 threads = decoder_threads_flag ? decoder_threads_flag->i32 : 1;
+		texture_manager.decoders = worker_pool_create(threads > 0 ? threads : 1);
+	}
+
+	load->path = key;
+	load->status = TEXTURE_LOAD_PENDING;
+	// Reference held by the decode job until the upload
+	load->refcount++;
+	hashtable_set(texture_manager.loads, HASH_KEY(str, load->path), HASH_VAL(ptr, load));
+
+	worker_pool_submit(texture_manager.decoders, texture_decode_job, load);
+
+	return load;
+}
+
+TextureLoadStatus texture_load_get_status(const TextureLoad *load) {
+	return load->status;
+}
+
+Texture *texture_load_get_texture(const TextureLoad *load) {
+	return load->texture;
+}
+
+void texture_load_release(TextureLoad *load) {
+	LS_ASSERT(load->refcount > 0);
+
+	if (--load->refcount > 0) {
+		return;
+	}
+
+	if (load->texture) {
+		texture_destroy(load->texture);
+	}
+
+	ls_free(load->path);
+	ls_free(load);
+}
+
+static void texture_load_finish(TextureLoad *load) {
+	hashtable_remove(texture_manager.loads, HASH_KEY(str, load->path));
+
+	if (!load->data) {
+		load->status = TEXTURE_LOAD_FAILED;
+		texture_load_release(load);
+		return;
+	}
+
+	// A synchronous load of the same file may have beaten the decoder
+	Texture *texture = hashtable_get(texture_manager.cache, HASH_KEY(str, load->path)).ptr;
+	if (texture) {
+		load->texture = texture_ref(texture);
+	} else {
+		load->texture = texture_create(load->width, load->height, TEXTURE_FORMAT_RGBA, load->data);
+		load->texture->path = load->path;
+		load->path = NULL;
+
+		hashtable_set(texture_manager.cache, HASH_KEY(str, load->texture->path), HASH_VAL(ptr, load->texture));
+		texture_manager.stats.cached_textures++;
+	}
+
+	ls_free(load->data);
+	load->data = NULL;
+	load->status = TEXTURE_LOAD_READY;
+
+	texture_load_release(load);
+}
+
+void texture_manager_process_uploads() {
+	uint64 budget = upload_budget_flag ? (uint64)upload_budget_flag->i32 * 1024 : 0;
+	uint64 uploaded = 0;
+
+	TextureLoad *load = NULL;
+	while ((uploaded == 0 || uploaded < budget) && (load = texture_manager_pop_finished())) {
+		uploaded += (uint64)load->width * load->height * 4;
+		texture_load_finish(load);
+	}
+}
+
 Texture *texture_create(uint32 width, uint32 height, TextureFormat format, const uint8 *data) {
-#if defined(OPENGL_ENABLED)
-	uint32 id = opengl_create_texture(width, height, format, data);
-#else
 	uint32 id = 0;
+#if defined(OPENGL_ENABLED)
+	if (texture_manager.backend == RENDERER_BACKEND_OPENGL) {
+		id = opengl_create_texture(width, height, format, data);
+	}
 #endif
 
 	Texture *texture = ls_malloc(sizeof(Texture));
 	texture->id = id;
 	texture->width = width;
 	texture->height = height;
+	texture->is_atlas = false;
+	texture->refcount = 1;
+	texture->size_bytes = (uint64)width * height * texture_format_channels(format);
+	texture->path = NULL;
+	texture->array = NULL;
+	texture->array_layer = 0;
 
+	texture_manager.stats.textures++;
+	texture_manager.stats.bytes_resident += texture->size_bytes;
+
+	return texture;
+}
+
+Texture *texture_ref(Texture *texture) {
+	LS_ASSERT(texture->refcount > 0);
+
+	texture->refcount++;
 	return texture;
 }
 
 void texture_destroy(Texture *texture) {
+	LS_ASSERT(texture->refcount > 0);
+
+	if (--texture->refcount > 0) {
+		return;
+	}
+
+	if (texture->path) {
+		hashtable_remove(texture_manager.cache, HASH_KEY(str, texture->path));
+		ls_free(texture->path);
+		texture_manager.stats.cached_textures--;
+	}
+
+	texture_manager.stats.textures--;
+	texture_manager.stats.bytes_resident -= texture->size_bytes;
+
+	if (texture->array) {
+		texture->array->textures[texture->array_layer] = NULL;
+		texture->array->used_layers--;
+	}
+
 #if defined(OPENGL_ENABLED)
-	opengl_destroy_texture(texture->id);
+	if (texture_manager.backend == RENDERER_BACKEND_OPENGL) {
+		opengl_destroy_texture(texture->id);
+	}
 #endif
 	ls_free(texture);
 }
 
 void texture_bind(const Texture *texture, uint32 slot) {
 #if defined(OPENGL_ENABLED)
-	opengl_bind_texture(texture->id, slot);
+	if (texture_manager.backend == RENDERER_BACKEND_OPENGL) {
+		opengl_bind_texture(texture->id, slot);
+	}
 #endif
 }
 
 void texture_unbind(const Texture *texture) {
 #if defined(OPENGL_ENABLED)
-	opengl_bind_texture(texture->id, 0);
+	if (texture_manager.backend == RENDERER_BACKEND_OPENGL) {
+		opengl_bind_texture(texture->id, 0);
+	}
 #endif
 }
 
 void texture_add_sub_texture(Texture *texture, TextureFormat format, const uint8 *data, float32 x, float32 y, float32 width, float32 height) {
 #if defined(OPENGL_ENABLED)
-	opengl_texture_add_sub_texture(texture->id, format, data, x, y, width, height);
+	if (texture_manager.backend == RENDERER_BACKEND_OPENGL) {
+		opengl_texture_add_sub_texture(texture->id, format, data, x, y, width, height);
+	}
 #endif
+
+	// Only the updated region is copied, atlases add one glyph or image at a time.
+	if (texture->array) {
+		texture_array_copy_layer(texture->array, texture->array_layer, texture, x, y, width, height);
+	}
+}
+
+uint32 texture_get_refcount(const Texture *texture) {
+	return texture->refcount;
+}
+
+TextureCacheStats texture_cache_get_stats() {
+	return texture_manager.stats;
 }
 
 uint32 texture_get_width(const Texture *texture) {
@@ -100,4 +463,102 @@ uint32 texture_get_width(const Texture *texture) {
 
 uint32 texture_get_height(const Texture *texture) {
 	return texture->height;
+}
+
+TextureArray *texture_get_array(const Texture *texture, uint32 *layer) {
+	if (texture->array && layer) {
+		*layer = texture->array_layer;
+	}
+
+	return texture->array;
+}
+
+TextureArray *texture_array_create(uint32 width, uint32 height, uint32 layers) {
+	LS_ASSERT(layers > 0);
+
+	TextureArray *texture_array = ls_malloc(sizeof(TextureArray));
+	texture_array->id = 0;
+#if defined(OPENGL_ENABLED)
+	if (texture_manager.backend == RENDERER_BACKEND_OPENGL) {
+		texture_array->id = opengl_create_texture_array(width, height, layers);
+	}
+#endif
+	texture_array->width = width;
+	texture_array->height = height;
+	texture_array->layers = layers;
+	texture_array->used_layers = 0;
+	texture_array->textures = ls_calloc(layers, sizeof(Texture *));
+
+	return texture_array;
+}
+
+void texture_array_destroy(TextureArray *texture_array) {
+	for (uint32 i = 0; i < texture_array->layers; i++) {
+		if (texture_array->textures[i]) {
+			texture_array->textures[i]->array = NULL;
+		}
+	}
+
+#if defined(OPENGL_ENABLED)
+	if (texture_manager.backend == RENDERER_BACKEND_OPENGL) {
+		opengl_destroy_texture(texture_array->id);
+	}
+#endif
+	ls_free(texture_array->textures);
+	ls_free(texture_array);
+}
+
+int32 texture_array_add_texture(TextureArray *texture_array, Texture *texture) {
+	if (texture->array == texture_array) {
+		return texture->array_layer;
+	}
+
+	if (texture->width != texture_array->width || texture->height != texture_array->height ||
+			texture_array->used_layers == texture_array->layers) {
+		return -1;
+	}
+
+	uint32 layer = 0;
+	while (texture_array->textures[layer]) {
+		layer++;
+	}
+
+	// A texture lives in at most one array
+	if (texture->array) {
+		texture->array->textures[texture->array_layer] = NULL;
+		texture->array->used_layers--;
+	}
+
+	texture_array_copy_layer(texture_array, layer, texture, 0, 0, texture->width, texture->height);
+	texture_array->textures[layer] = texture;
+	texture_array->used_layers++;
+
+	texture->array = texture_array;
+	texture->array_layer = layer;
+
+	return layer;
+}
+
+void texture_array_bind(const TextureArray *texture_array, uint32 slot) {
+#if defined(OPENGL_ENABLED)
+	if (texture_manager.backend == RENDERER_BACKEND_OPENGL) {
+		opengl_bind_texture_array(texture_array->id, slot);
+	}
+#endif
+}
+
+uint32 texture_array_get_width(const TextureArray *texture_array) {
+	return texture_array->width;
+}
+
+uint32 texture_array_get_height(const TextureArray *texture_array) {
+	return texture_array->height;
+}
+
+uint32 texture_array_get_layer_count(const TextureArray *texture_array) {
+	return texture_array->layers;
+}
+
+uint32 texture_array_get_used_layer_count(const TextureArray *texture_array) {
+	return texture_array->used_layers;
 }
\ No newline at end of file
@@ -5,8 +5,12 @@
 
 #include "renderer/renderer.h"
 
-void texture_manager_init();
+void texture_manager_init(FlagManager *flag_manager);
 void texture_manager_deinit();
+// Textures only reach the GPU on the OPENGL backend, with NONE they keep their size and layout bookkeeping.
+void texture_manager_set_backend(RendererBackend backend);
+// Uploads images the decoder threads have finished, within the per frame budget. Called on the render thread.
+void texture_manager_process_uploads();
 
 typedef void (*TextureParseFunc)(String path, uint32 *width, uint32 *height, uint8 **data);
 
@@ -23,9 +27,49 @@ typedef enum {
 
 typedef struct Texture Texture;
 
+// Textures are reference counted, every create, ref and cache hit must be paired with a texture_destroy.
 LS_EXPORT Texture *texture_create(uint32 width, uint32 height, TextureFormat format, const uint8 *data);
+// Loads an image through the texture cache. Loading the same file again returns the same texture with a new reference.
+// Cached textures are shared, so updating one with texture_add_sub_texture is seen by every user.
 LS_EXPORT Texture *texture_create_from_image(String path);
+// Decodes an image file with the parser registered for its extension. Returns RGBA pixels the caller must free, or NULL.
+LS_EXPORT uint8 *texture_load_image_data(String path, uint32 *width, uint32 *height);
+// Adds a reference to the texture and returns it.
+LS_EXPORT Texture *texture_ref(Texture *texture);
+// Drops a reference. The texture is freed, and removed from the cache, once the last one is gone.
 LS_EXPORT void texture_destroy(Texture *texture);
+LS_EXPORT uint32 texture_get_refcount(const Texture *texture);
+
+// Handle to an image being decoded on a worker thread. The GL texture is created on the render thread
+// the frame after decoding finishes. Loads of the same file share a handle and the cache of texture_create_from_image.
+typedef struct TextureLoad TextureLoad;
+
+typedef enum {
+	TEXTURE_LOAD_PENDING,
+	TEXTURE_LOAD_READY,
+	TEXTURE_LOAD_FAILED,
+} TextureLoadStatus;
+
+// Never blocks. The handle must be released with texture_load_release.
+LS_EXPORT TextureLoad *texture_load_async(String path);
+LS_EXPORT TextureLoadStatus texture_load_get_status(const TextureLoad *load);
+// Returns the texture once the load is ready, NULL before. The handle keeps its reference,
+// use texture_ref to keep the texture after releasing the handle.
+LS_EXPORT Texture *texture_load_get_texture(const TextureLoad *load);
+LS_EXPORT void texture_load_release(TextureLoad *load);
+
+typedef struct {
+	// Loads served from the cache and loads that had to decode the file
+	uint64 hits;
+	uint64 misses;
+
+	uint32 cached_textures;
+	// All live textures, cached or not
+	uint32 textures;
+	uint64 bytes_resident;
+} TextureCacheStats;
+
+LS_EXPORT TextureCacheStats texture_cache_get_stats();
 
 LS_EXPORT void texture_bind(const Texture *texture, uint32 slot);
 LS_EXPORT void texture_unbind(const Texture *texture);
@@ -35,4 +79,26 @@ LS_EXPORT uint32 texture_get_height(const Texture *texture);
 
 LS_EXPORT void texture_add_sub_texture(Texture *texture, TextureFormat format, const uint8 *data, float32 x, float32 y, float32 width, float32 height);
 
+// A stack of same sized RGBA layers sampled as one texture, used to batch many textures without switching bindings.
+typedef struct TextureArray TextureArray;
+
+LS_EXPORT TextureArray *texture_array_create(uint32 width, uint32 height, uint32 layers);
+// Textures stored in the array stay valid, they are just removed from it.
+LS_EXPORT void texture_array_destroy(TextureArray *texture_array);
+
+// Copies the texture into a free layer and returns it, or -1 if the array is full or the size does not match.
+// If the texture is already stored in this array its current layer is returned.
+// The layer is released when the texture is destroyed and refreshed when the texture is updated.
+LS_EXPORT int32 texture_array_add_texture(TextureArray *texture_array, Texture *texture);
+
+LS_EXPORT void texture_array_bind(const TextureArray *texture_array, uint32 slot);
+
+LS_EXPORT uint32 texture_array_get_width(const TextureArray *texture_array);
+LS_EXPORT uint32 texture_array_get_height(const TextureArray *texture_array);
+LS_EXPORT uint32 texture_array_get_layer_count(const TextureArray *texture_array);
+LS_EXPORT uint32 texture_array_get_used_layer_count(const TextureArray *texture_array);
+
+// Returns the array the texture is stored in and writes its layer, or NULL if it is not in any array.
+LS_EXPORT TextureArray *texture_get_array(const Texture *texture, uint32 *layer);
+
 #endif // TEXTURE_H
\ No newline at end of file
@@ -0,0 +1,250 @@
+#include "renderer/texture_atlas.h"
+
+// Empty pixels kept around every image so linear filtering never samples a neighbour.
+#define ATLAS_PADDING 1
+
+typedef struct {
+	uint32 x;
+	uint32 y;
+	uint32 width;
+} SkylineNode;
+
+typedef struct {
+	Texture *texture;
+	uint32 width;
+	uint32 height;
+
+	// Top edge of the packed area, ordered by x and covering the full page width
+	SkylineNode *nodes;
+	uint32 nnodes;
+	uint32 node_capacity;
+} AtlasPage;
+
+struct TextureAtlas {
+	uint32 page_width;
+	uint32 page_height;
+
+	AtlasPage *pages;
+	uint32 npages;
+
+	TextureRegion **regions;
+	uint32 nregions;
+	uint32 region_capacity;
+};
+
+static AtlasPage *atlas_add_page(TextureAtlas *atlas, uint32 width, uint32 height) {
+	atlas->pages = ls_realloc(atlas->pages, (atlas->npages + 1) * sizeof(AtlasPage));
+	AtlasPage *page = &atlas->pages[atlas->npages++];
+
+	// Start from transparent pixels so padding never shows garbage
+	uint8 *clear = ls_calloc(width * height, 4);
+	page->texture = texture_create(width, height, TEXTURE_FORMAT_RGBA, clear);
+	ls_free(clear);
+
+	page->width = width;
+	page->height = height;
+
+	page->node_capacity = 16;
+	page->nodes = ls_malloc(page->node_capacity * sizeof(SkylineNode));
+	page->nodes[0] = (SkylineNode){ 0, 0, width };
+	page->nnodes = 1;
+
+	return page;
+}
+
+// Returns the y an image would sit at if its left edge was placed on node index, or -1 if it does not fit.
+static int64 skyline_fit(const AtlasPage *page, uint32 index, uint32 width, uint32 height) {
+	uint32 x = page->nodes[index].x;
+	if (x + width > page->width) {
+		return -1;
+	}
+
+	uint32 y = 0;
+	int64 width_left = width;
+	for (uint32 i = index; width_left > 0; i++) {
+		LS_ASSERT(i < page->nnodes);
+		if (page->nodes[i].y > y) {
+			y = page->nodes[i].y;
+		}
+
+		if (y + height > page->height) {
+			return -1;
+		}
+
+		width_left -= page->nodes[i].width;
+	}
+
+	return y;
+}
+
+static void skyline_insert_node(AtlasPage *page, uint32 index, SkylineNode node) {
+	if (page->nnodes == page->node_capacity) {
+		page->node_capacity *= 2;
+		page->nodes = ls_realloc(page->nodes, page->node_capacity * sizeof(SkylineNode));
+	}
+
+	ls_memmove(&page->nodes[index + 1], &page->nodes[index], (page->nnodes - index) * sizeof(SkylineNode));
+	page->nodes[index] = node;
+	page->nnodes++;
+}
+
+static void skyline_remove_node(AtlasPage *page, uint32 index) {
+	ls_memmove(&page->nodes[index], &page->nodes[index + 1], (page->nnodes - index - 1) * sizeof(SkylineNode));
+	page->nnodes--;
+}
+
+// Bottom left skyline packing. Places the image as low as possible, preferring the narrowest spot on ties.
+static bool skyline_pack(AtlasPage *page, uint32 width, uint32 height, uint32 *out_x, uint32 *out_y) {
+	int64 best_index = -1;
+	uint32 best_y = 0;
+	uint32 best_width = 0;
+
+	for (uint32 i = 0; i < page->nnodes; i++) {
+		int64 y = skyline_fit(page, i, width, height);
+		if (y < 0) {
+			continue;
+		}
+
+		if (best_index < 0 || y < best_y || (y == best_y && page->nodes[i].width < best_width)) {
+			best_index = i;
+			best_y = (uint32)y;
+			best_width = page->nodes[i].width;
+		}
+	}
+
+	if (best_index < 0) {
+		return false;
+	}
+
+	SkylineNode node = { page->nodes[best_index].x, best_y + height, width };
+	skyline_insert_node(page, best_index, node);
+
+	// Shrink or remove the nodes the new one now covers
+	for (uint32 i = best_index + 1; i < page->nnodes; i++) {
+		SkylineNode *prev = &page->nodes[i - 1];
+		SkylineNode *current = &page->nodes[i];
+		if (current->x >= prev->x + prev->width) {
+			break;
+		}
+
+		uint32 shrink = prev->x + prev->width - current->x;
+		if (current->width <= shrink) {
+			skyline_remove_node(page, i);
+			i--;
+			continue;
+		}
+
+		current->x += shrink;
+		current->width -= shrink;
+		break;
+	}
+
+	// Merge neighbours at the same height
+	for (uint32 i = 0; i + 1 < page->nnodes; i++) {
+		if (page->nodes[i].y == page->nodes[i + 1].y) {
+			page->nodes[i].width += page->nodes[i + 1].width;
+			skyline_remove_node(page, i + 1);
+			i--;
+		}
+	}
+
+	*out_x = node.x;
+	*out_y = best_y;
+	return true;
+}
+
+TextureAtlas *texture_atlas_create(uint32 page_width, uint32 page_height) {
+	LS_ASSERT(page_width > 0 && page_height > 0);
+
+	TextureAtlas *atlas = ls_calloc(1, sizeof(TextureAtlas));
+	atlas->page_width = page_width;
+	atlas->page_height = page_height;
+
+	return atlas;
+}
+
+void texture_atlas_destroy(TextureAtlas *atlas) {
+	for (uint32 i = 0; i < atlas->npages; i++) {
+		texture_destroy(atlas->pages[i].texture);
+		ls_free(atlas->pages[i].nodes);
+	}
+
+	for (uint32 i = 0; i < atlas->nregions; i++) {
+		ls_free(atlas->regions[i]);
+	}
+
+	ls_free(atlas->pages);
+	ls_free(atlas->regions);
+	ls_free(atlas);
+}
+
+const TextureRegion *texture_atlas_add(TextureAtlas *atlas, uint32 width, uint32 height, const uint8 *data) {
+	if (width == 0 || height == 0) {
+		return NULL;
+	}
+
+	uint32 padded_width = width + ATLAS_PADDING * 2;
+	uint32 padded_height = height + ATLAS_PADDING * 2;
+
+	AtlasPage *page = NULL;
+	uint32 x = 0;
+	uint32 y = 0;
+
+	for (uint32 i = 0; i < atlas->npages; i++) {
+		if (skyline_pack(&atlas->pages[i], padded_width, padded_height, &x, &y)) {
+			page = &atlas->pages[i];
+			break;
+		}
+	}
+
+	if (!page) {
+		uint32 page_width = padded_width > atlas->page_width ? padded_width : atlas->page_width;
+		uint32 page_height = padded_height > atlas->page_height ? padded_height : atlas->page_height;
+		page = atlas_add_page(atlas, page_width, page_height);
+
+		bool packed = skyline_pack(page, padded_width, padded_height, &x, &y);
+		LS_ASSERT(packed);
+	}
+
+	x += ATLAS_PADDING;
+	y += ATLAS_PADDING;
+	texture_add_sub_texture(page->texture, TEXTURE_FORMAT_RGBA, data, x, y, width, height);
+
+	TextureRegion *region = ls_malloc(sizeof(TextureRegion));
+	region->texture = page->texture;
+	region->size = vec2u(width, height);
+	region->uv_min = vec2((float32)x / page->width, (float32)y / page->height);
+	region->uv_max = vec2((float32)(x + width) / page->width, (float32)(y + height) / page->height);
+
+	if (atlas->nregions == atlas->region_capacity) {
+		atlas->region_capacity = atlas->region_capacity ? atlas->region_capacity * 2 : 16;
+		atlas->regions = ls_realloc(atlas->regions, atlas->region_capacity * sizeof(TextureRegion *));
+	}
+	atlas->regions[atlas->nregions++] = region;
+
+	return region;
+}
+
+const TextureRegion *texture_atlas_add_image(TextureAtlas *atlas, String path) {
+	uint32 width = 0;
+	uint32 height = 0;
+	uint8 *data = texture_load_image_data(path, &width, &height);
+	if (data == NULL) {
+		return NULL;
+	}
+
+	const TextureRegion *region = texture_atlas_add(atlas, width, height, data);
+	ls_free(data);
+
+	return region;
+}
+
+uint32 texture_atlas_get_page_count(const TextureAtlas *atlas) {
+	return atlas->npages;
+}
+
+const Texture *texture_atlas_get_page(const TextureAtlas *atlas, uint32 index) {
+	LS_ASSERT(index < atlas->npages);
+
+	return atlas->pages[index].texture;
+}
\ No newline at end of file
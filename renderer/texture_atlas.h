@@ -0,0 +1,42 @@
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+
+#include "core/core.h"
+
+#include "renderer/texture.h"
+
+// A packed image inside one of the atlas pages. Handles stay valid until the atlas is destroyed.
+typedef struct {
+	const Texture *texture;
+
+	Vector2 uv_min;
+	Vector2 uv_max;
+
+	// Size of the image in pixels
+	Vector2u size;
+} TextureRegion;
+
+// Packs images into a few large RGBA pages using a skyline packer.
+// Images can be added at any time, a new page is created when no existing page has room.
+typedef struct TextureAtlas TextureAtlas;
+
+// page_width and page_height are the size of every page, images larger than a page get a page of their own.
+LS_EXPORT TextureAtlas *texture_atlas_create(uint32 page_width, uint32 page_height);
+// Destroys the atlas, its pages and every region handed out.
+LS_EXPORT void texture_atlas_destroy(TextureAtlas *atlas);
+
+// Packs RGBA pixel data into the atlas. Returns NULL if width or height is 0.
+LS_EXPORT const TextureRegion *texture_atlas_add(TextureAtlas *atlas, uint32 width, uint32 height, const uint8 *data);
+// Decodes an image file and packs it into the atlas. Returns NULL if the image failed to load.
+LS_EXPORT const TextureRegion *texture_atlas_add_image(TextureAtlas *atlas, String path);
+
+LS_EXPORT uint32 texture_atlas_get_page_count(const TextureAtlas *atlas);
+LS_EXPORT const Texture *texture_atlas_get_page(const TextureAtlas *atlas, uint32 index);
+
+// Maps a 0-1 coordinate inside the region to a coordinate in its page texture.
+_FORCE_INLINE_ Vector2 texture_region_map_uv(const TextureRegion *region, Vector2 uv) {
+	return vec2(region->uv_min.x + (region->uv_max.x - region->uv_min.x) * uv.x,
+			region->uv_min.y + (region->uv_max.y - region->uv_min.y) * uv.y);
+}
+
+#endif // TEXTURE_ATLAS_H
\ No newline at end of file
@@ -55,6 +55,9 @@ VertexArray *renderer_create_vertex_array(const Renderer *renderer) {
 	vertex_array->backend = renderer_get_backend(renderer);
 
 	switch (vertex_array->backend) {
+		case RENDERER_BACKEND_NONE: {
+		} break;
+
 #if defined(OPENGL_ENABLED)
 		case RENDERER_BACKEND_OPENGL: {
 			vertex_array->opengl = opengl_vertex_array_create(renderer_get_opengl(renderer));
@@ -98,6 +101,10 @@ void vertex_array_draw_elements(const VertexArray *vertex_array) {
 	VERTEX_ARRAY_CALL(vertex_array, draw_elements);
 }
 
+void vertex_array_draw_elements_range(const VertexArray *vertex_array, uint32 first_index, uint32 count) {
+	VERTEX_ARRAY_CALL(vertex_array, draw_elements_range, first_index, count);
+}
+
 const IndexBuffer *vertex_array_get_index_buffer(const VertexArray *vertex_array) {
 	VERTEX_ARRAY_CALL_R(vertex_array, get_index_buffer);
 	return NULL;
@@ -17,6 +17,8 @@ LS_EXPORT void vertex_array_set_vertex_buffers(VertexArray *vertex_array, const
 LS_EXPORT void vertex_array_set_index_buffer(VertexArray *vertex_array, const IndexBuffer *index_buffer);
 
 LS_EXPORT void vertex_array_draw_elements(const VertexArray *vertex_array);
+// Draws count indices starting at first_index of the index buffer's current range.
+LS_EXPORT void vertex_array_draw_elements_range(const VertexArray *vertex_array, uint32 first_index, uint32 count);
 LS_EXPORT void vertex_array_draw(const VertexArray *vertex_array);
 
 LS_EXPORT const IndexBuffer *vertex_array_get_index_buffer(const VertexArray *vertex_array);